@@ -55,14 +55,24 @@ BitBuffer::BitBuffer ()
     m_Mode (e_MODE_UNSET),
     m_Flushed (false),
     m_Closed (false),
-    m_Mini_Buffer (0),
-    m_Mini_Buffer_Used (0),
+    m_Read_Buffer (0),
+    m_Read_Buffer_Used (0),
+    m_Write_Buffer (0),
+    m_Write_Buffer_Used (0),
     m_Main_Buffer (),
+    m_Main_Buffer_Size (g_BITBUFFER_SIZE),
     m_Main_Buffer_Ptr (0),
-    m_Main_Buffer_End (0)
+    m_Main_Buffer_End (0),
+    m_Memory_Limit (0),
+    m_File_Bytes (0),
+    m_In_Buffer (),
+    m_In_Data (),
+    m_In_Size (0),
+    m_Mapping ()
 {
   //  Allocate space for the buffer
   m_Main_Buffer = new char[g_BITBUFFER_SIZE];
+  m_In_Buffer = m_Main_Buffer;
 
   int i = 0;
   for (i = 0; i < g_BITBUFFER_SIZE; i++) {
@@ -86,7 +96,7 @@ BitBuffer::~BitBuffer () {
      Initialization function
 
      \param[in] fn Filename to read from/write to
-     \param[in] mode Indicate whether the object is in read, write, or append mode
+     \param[in] mode Indicate whether the object is in read, mapped read, write, or append mode
      \param[in] debug Whether or not debugging is turned on
 */
 void BitBuffer::Initialize (string fn, e_READWRITE_MODE mode, bool debug) {
@@ -100,8 +110,16 @@ void BitBuffer::Initialize (string fn, e_READWRITE_MODE mode, bool debug) {
     exit (EXIT_FAILURE);
   }
   
+  //  Map the file if possible; otherwise, read it like any other file
+  if ((GetMode () == e_MODE_MAPPED_READ) && (!MapFile ())) {
+    m_Mode = e_MODE_READ;
+  }
+
   //  Open the file for reading or writing
-  if (GetMode () == e_MODE_READ) {
+  if (GetMode () == e_MODE_MAPPED_READ) {
+    //  Already open
+  }
+  else if (GetMode () == e_MODE_READ) {
     m_In_Fp.open (GetFilename ().c_str (), ios::in|ios::binary);
     if (!m_In_Fp) {
       cerr << "EE\tCannot open " << GetFilename () << " for reading." << endl;
@@ -131,6 +149,68 @@ void BitBuffer::Initialize (string fn, e_READWRITE_MODE mode, bool debug) {
 }
 
 
+/*!
+     Initialization function for BitBuffers that are not backed by a file.  Any
+     bits previously written are discarded, but the memory allocated is kept so
+     that the object can be re-used as a staging area.
+
+     \param[in] mode Indicate the memory mode of the object
+     \param[in] debug Whether or not debugging is turned on
+*/
+void BitBuffer::Initialize (e_READWRITE_MODE mode, bool debug) {
+  m_Debug = debug;
+  m_Filename = "";
+  m_Mode = mode;
+
+  if (GetMode () != e_MODE_MEMORY_WRITE) {
+    cerr << "==\tError:  Invalid memory mode for BitBuffer class initializer." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  m_Flushed = false;
+  m_Closed = false;
+  m_Read_Buffer = 0;
+  m_Read_Buffer_Used = 0;
+  m_Write_Buffer = 0;
+  m_Write_Buffer_Used = 0;
+  m_Main_Buffer_Ptr = 0;
+  m_Main_Buffer_End = 0;
+  m_Memory_Limit = 0;
+  m_File_Bytes = 0;
+
+  return;
+}
+
+
+/*!
+     Initialization function for reading from bytes in memory (e_MODE_MEMORY_READ).  The
+     bytes are not copied, so they must not be changed or freed while this object reads them.
+
+     \param[in] data The bytes to read, as written by GetBytes () or to a file
+     \param[in] size Number of bytes
+     \param[in] debug Whether or not debugging is turned on
+*/
+void BitBuffer::Initialize (const char *data, unsigned long long size, bool debug) {
+  m_Debug = debug;
+  m_Filename = "";
+  m_Mode = e_MODE_MEMORY_READ;
+  m_Mapping.reset ();
+  m_In_Data = data;
+  m_In_Size = size;
+  m_In_Buffer = m_In_Data;
+
+  m_Flushed = false;
+  m_Closed = false;
+  m_Read_Buffer = 0;
+  m_Read_Buffer_Used = 0;
+  m_Main_Buffer_Ptr = 0;
+  m_Main_Buffer_End = 0;
+  m_File_Bytes = 0;
+
+  return;
+}
+
+
 //  -----------------------------------------------------------------
 //  Accessors and mutators
 //  -----------------------------------------------------------------
@@ -145,6 +225,16 @@ string BitBuffer::GetFilename () const {
 }
 
 
+/*!
+     Return whether bits are being read, whether from a file or from memory
+
+     \return true if reading; false otherwise
+*/
+bool BitBuffer::IsReadMode () const {
+  return ((m_Mode == e_MODE_READ) || (m_Mode == e_MODE_MAPPED_READ) || (m_Mode == e_MODE_MEMORY_READ));
+}
+
+
 /*!
      Return m_Mode
 
@@ -196,3 +286,16 @@ void BitBuffer::SetClosed (bool value) {
 }
 
 
+/*!
+     Limit the number of bytes written in e_MODE_MEMORY_WRITE, counting the bits still in
+     the accumulator as the whole unsigned ints they are padded to.  Writing past the limit
+     exits with an error, by the time the main buffer next grows or GetBytes () is called.
+     Initialize () removes the limit.
+
+     \param[in] limit The most bytes that may be written; 0 for no limit
+*/
+void BitBuffer::SetMemoryLimit (size_t limit) {
+  m_Memory_Limit = limit;
+}
+
+
@@ -30,11 +30,30 @@
 #ifndef BITBUFFER_HPP
 #define BITBUFFER_HPP
 
+#include <memory>  //  shared_ptr
+#include <vector>
+#include <cstring>  //  memcpy
+#include <bit>  //  endian
+
+#include "common.hpp"
+
 /*!
      Size of the main buffer in bytes
 */
 const int g_BITBUFFER_SIZE = 131072;
 
+/*!
+     Largest number of bits that can be looked at with Peek () at once.  After a refill,
+     the lookahead window holds at least this many bits (unless the file has ended).
+*/
+const unsigned int g_BITBUFFER_PEEK_MAX = 57;
+
+/*!
+     Largest part of a memory-mapped file or caller's buffer that is handed to the main
+     buffer at once, in bytes
+*/
+const unsigned long long g_BITBUFFER_MEMORY_PART = (1ULL << 30);
+
 /*!
      \enum e_READWRITE_MODE
      Mode of the BitBuffer (reading or writing).
@@ -44,6 +63,9 @@ enum e_READWRITE_MODE {
   e_MODE_READ, /*!< Read from file mode  */
   e_MODE_WRITE, /*!< Write to file mode  */ 
   e_MODE_APPEND, /*!< Append to file mode  */
+  e_MODE_MEMORY_WRITE, /*!< Write to a growable buffer in memory  */
+  e_MODE_MAPPED_READ, /*!< Read from a memory-mapped file  */
+  e_MODE_MEMORY_READ, /*!< Read from a caller's buffer in memory  */
   e_MODE_LAST /*!< Last read/write mode  */
 };
 
@@ -57,12 +79,24 @@ enum e_READWRITE_MODE {
 const unsigned int g_MASK_LOWER_BYTE = 0xff;
 
 
+//  Memory-mapped file shared between BitBuffers  [mapped.cpp]
+struct BitBufferMapping;
+
+
 /*! 
     \class BitBuffer
 
     \details Class used to buffer bits when reading from or writing to disk.
     A two-level buffer is employed -- a smaller one of size unsigned int and
-    a larger one which is used to access the disk directly.
+    a larger one which is used to access the disk directly.  When writing, the
+    smaller buffer is a 64-bit accumulator, so that any write of up to 32 bits
+    fits without splitting and whole unsigned int's are stored in the larger
+    buffer with a single copy.  When reading, it is a 64-bit lookahead window
+    which is topped up 8 bytes at a time.  Codecs can look at up to
+    g_BITBUFFER_PEEK_MAX bits of it with Peek () and then Consume () the bits
+    that they used; for example, a run of 1 bits can be counted with a single
+    std::countl_one ().  Peek () and Consume () are defined in this header so
+    that they can be inlined into the codecs.
 
     Functions are available which read and write char's and unsigned int's.
     Unfortunately, they are not very efficient since they also access the bit
@@ -71,6 +105,20 @@ const unsigned int g_MASK_LOWER_BYTE = 0xff;
     consistent state.
 
     Perhaps this will be for "future work".
+
+    In e_MODE_MEMORY_WRITE, the main buffer is never written to disk and is
+    enlarged instead.  Such a BitBuffer can be used as a staging area and its
+    bits appended to another BitBuffer with WriteBitBuffer ().
+
+    In e_MODE_MAPPED_READ, the file is mapped into memory and the main buffer
+    points into the mapping, so nothing is copied.  The mapping can be shared
+    by several BitBuffers (one per thread) through Initialize (const BitBuffer&).
+    If the file cannot be mapped, e_MODE_READ is used instead.
+
+    In e_MODE_MEMORY_READ, the bits are read from bytes owned by the caller in
+    the same way, which must outlive the BitBuffer.  Together with
+    e_MODE_MEMORY_WRITE and GetBytes (), this lets the codecs run without any
+    files.
 */
 class BitBuffer {
   public:
@@ -78,6 +126,9 @@ class BitBuffer {
     BitBuffer ();
     ~BitBuffer ();
     void Initialize (std::string fn, e_READWRITE_MODE mode, bool debug=false);
+    void Initialize (e_READWRITE_MODE mode, bool debug=false);
+    void Initialize (const char *data, unsigned long long size, bool debug=false);
+    void Initialize (const BitBuffer &src, bool debug=false);
 
     //  Accessors/mutators  [bitbuffer.cpp]
     std::string GetFilename () const;
@@ -86,22 +137,42 @@ class BitBuffer {
     void SetDebug (bool value);
     void SetFlushed (bool value);
     void SetClosed (bool value);
+    void SetMemoryLimit (size_t limit);
 
     //  Main functions  [io.cpp]
     unsigned int ReadBits (unsigned int num_bits);
+    unsigned long long Peek (unsigned int num_bits);
+    void Consume (unsigned int num_bits);
     void WriteBits (unsigned int x, unsigned int bits);
     bool ReadUInts (unsigned int *buffer, int num_values);
     bool WriteUInts (unsigned int *buffer, int num_values);
     bool ReadChars (char *buffer, int num_values);
-    bool WriteChars (char *buffer, int num_values);
+    bool WriteChars (const char *buffer, int num_values);
+    void WriteBitBuffer (const BitBuffer &src);
+    void GetBytes (std::vector<char> &bytes) const;
+    unsigned long long GetPosition () const;
+    void AlignRead (unsigned int num_bits);
+    void SeekRead (unsigned long long byte_offset);
+    void AlignWrite (unsigned int num_bits);
 
     //  Finalizing functions  [finish.cpp]
     void Flush ();
     void Close ();
     void Finish ();
   private:
+    //  Accessors  [bitbuffer.cpp]
+    bool IsReadMode () const;
+
     //  Main functions  [io.cpp]
-    bool ReadBitsLowLevel (unsigned int min_bits);
+    bool ReadMainBuffer ();
+    bool ReadMemoryBuffer ();
+    void Refill (unsigned int min_bits);
+    void RefillBytes (unsigned int min_bits);
+    void WriteMainBuffer ();
+    void WriteLongWord (unsigned long long x);
+
+    //  Memory-mapped input  [mapped.cpp]
+    bool MapFile ();
 
     //  Finalizing functions  [finish.cpp]
     bool IsFlushed ();
@@ -126,18 +197,103 @@ class BitBuffer {
     //!  Indicate whether the file pointer has been closed
     bool m_Closed;
     
-    //!  Mini buffer of 4 bytes long
-    unsigned int m_Mini_Buffer;
-    //!  Number of useful bits in the mini-buffer
-    unsigned int m_Mini_Buffer_Used;
+    //!  Lookahead window of 8 bytes long used for reading; the next bit is the highest one
+    unsigned long long m_Read_Buffer;
+    //!  Number of valid bits in the lookahead window, counted from the highest bit; the bits below
+    //!  them are not meaningful, though Refill () may leave the next bits of the input there
+    unsigned int m_Read_Buffer_Used;
+
+    //!  Accumulator of 8 bytes long used for writing; the valid bits are the lowest ones
+    unsigned long long m_Write_Buffer;
+    //!  Number of valid bits in the accumulator; always less than 64 between writes
+    unsigned int m_Write_Buffer_Used;
 
     //!  Main buffer
     char *m_Main_Buffer;
-    //!  Pointer to next available position in the buffer
-    int m_Main_Buffer_Ptr;
+    //!  Size of the main buffer; only grows beyond g_BITBUFFER_SIZE in e_MODE_MEMORY_WRITE
+    size_t m_Main_Buffer_Size;
+    //!  Pointer to next available position in the buffer; when writing, there is always room for the accumulator after it
+    size_t m_Main_Buffer_Ptr;
     //!  Pointer to the end of the buffer; in the end, it should be less than BITBUFFER_SIZE because it will not be full
-    int m_Main_Buffer_End;
+    size_t m_Main_Buffer_End;
+    //!  Most bytes that may be written in e_MODE_MEMORY_WRITE, including the accumulator; 0 for no limit
+    size_t m_Memory_Limit;
+    //!  Number of bytes moved between the main buffer and the file so far
+    unsigned long long m_File_Bytes;
+    //!  Where bits are read from; either the main buffer or part of m_In_Data
+    const char *m_In_Buffer;
+    //!  Bytes read in e_MODE_MAPPED_READ or e_MODE_MEMORY_READ
+    const char *m_In_Data;
+    //!  Number of bytes in m_In_Data
+    unsigned long long m_In_Size;
+    //!  Memory-mapped file in e_MODE_MAPPED_READ, shared with other BitBuffers reading it
+    std::shared_ptr<const BitBufferMapping> m_Mapping;
 };
 
+
+/*!
+     Top up the lookahead window from the main-buffer so that it holds at least
+     g_BITBUFFER_PEEK_MAX bits, or whatever is left of the file if that is fewer.  Away
+     from the end of the main-buffer, 8 bytes are loaded at once and the whole bytes that
+     fit below the bits already in the window are kept; the bits of a partial byte are
+     loaded again, unchanged, next time.  This case is defined here so that it can be
+     inlined into Peek () and Consume (); the rest is left to RefillBytes ().
+
+     \param[in] min_bits The number of bits that must be available afterwards
+     \throw BitBuffer_Input_Exception
+*/
+inline void BitBuffer::Refill (unsigned int min_bits) {
+  if (m_Main_Buffer_End - m_Main_Buffer_Ptr < g_ULL_SIZE_BYTES) {
+    RefillBytes (min_bits);
+    return;
+  }
+
+  unsigned long long x = 0;
+  unsigned int num_bytes = (g_ULL_SIZE_BITS - m_Read_Buffer_Used) / g_CHAR_SIZE_BITS;
+  std::memcpy (&x, &m_In_Buffer[m_Main_Buffer_Ptr], g_ULL_SIZE_BYTES);
+  if constexpr (std::endian::native == std::endian::little) {
+    x = __builtin_bswap64 (x);
+  }
+  m_Read_Buffer |= x >> m_Read_Buffer_Used;
+  m_Main_Buffer_Ptr += num_bytes;
+  m_Read_Buffer_Used += num_bytes * g_CHAR_SIZE_BITS;
+
+  return;
+}
+
+
+/*!
+     Return the next bits without removing them.  If the file ends first, the missing
+     bits are 0's.
+
+     \param[in] num_bits The number of bits requested, from 1 to g_BITBUFFER_PEEK_MAX
+     \return The bits, with the last one requested as the least significant bit
+*/
+inline unsigned long long BitBuffer::Peek (unsigned int num_bits) {
+  if (m_Read_Buffer_Used < num_bits) {
+    Refill (0);
+  }
+
+  return (m_Read_Buffer >> (g_ULL_SIZE_BITS - num_bits));
+}
+
+
+/*!
+     Remove bits which have been looked at with Peek ().
+
+     \param[in] num_bits The number of bits to remove, up to g_BITBUFFER_PEEK_MAX
+     \throw BitBuffer_Input_Exception
+*/
+inline void BitBuffer::Consume (unsigned int num_bits) {
+  if (m_Read_Buffer_Used < num_bits) {
+    Refill (num_bits);
+  }
+
+  m_Read_Buffer <<= num_bits;
+  m_Read_Buffer_Used -= num_bits;
+
+  return;
+}
+
 #endif
 
@@ -30,6 +30,8 @@
 #include <fstream>
 #include <cstdlib>  //  exit
 #include <iostream>
+#include <cstring>  //  memcpy
+#include <bit>  //  endian
 
 using namespace std;
 
@@ -73,21 +75,19 @@ bool BitBuffer::FlushRead () {
      \return Always returns true
 */
 bool BitBuffer::FlushWrite () {
-  unsigned int unused_bits = g_UINT_SIZE_BITS - m_Mini_Buffer_Used;
-
   if (IsFlushed ()) {
     return true;
   }
-  
-  m_Mini_Buffer <<= unused_bits;      //  Pad remaining space with 0's
-  unused_bits = 0;
-
-  //  Copy the mini-buffer to the main-buffer
-  while (unused_bits < g_UINT_SIZE_BITS) {
-    m_Main_Buffer[m_Main_Buffer_Ptr] = static_cast<char>((m_Mini_Buffer >> (g_UINT_SIZE_BITS - g_CHAR_SIZE_BITS)) & g_MASK_LOWER_BYTE);
-    m_Main_Buffer_Ptr++;
-    m_Mini_Buffer = m_Mini_Buffer << g_CHAR_SIZE_BITS;
-    unused_bits += g_CHAR_SIZE_BITS;
+
+  //  Pad the bits left in the accumulator with 0's to whole unsigned ints; the main-buffer
+  //  always has room for all 8 bytes of it
+  if (m_Write_Buffer_Used != 0) {
+    unsigned long long x = m_Write_Buffer << (g_ULL_SIZE_BITS - m_Write_Buffer_Used);
+    if constexpr (endian::native == endian::little) {
+      x = __builtin_bswap64 (x);
+    }
+    memcpy (&m_Main_Buffer[m_Main_Buffer_Ptr], &x, g_ULL_SIZE_BYTES);
+    m_Main_Buffer_Ptr += (m_Write_Buffer_Used > g_UINT_SIZE_BITS) ? g_ULL_SIZE_BYTES : g_UINT_SIZE_BYTES;
   }
 
   //  Write the main-buffer to disk
@@ -98,9 +98,10 @@ bool BitBuffer::FlushWrite () {
       exit (EXIT_FAILURE);
     }
   }
+  m_File_Bytes += m_Main_Buffer_Ptr;
   m_Main_Buffer_Ptr = 0;
-  m_Mini_Buffer_Used = 0;
-  m_Mini_Buffer = 0;
+  m_Write_Buffer_Used = 0;
+  m_Write_Buffer = 0;
 
   SetFlushed (true);
 
@@ -124,7 +125,16 @@ bool BitBuffer::IsClosed () {
      \return Always returns true
 */
 bool BitBuffer::CloseRead () {
-  m_In_Fp.close ();
+  if (GetMode () != e_MODE_READ) {
+    //  A memory-mapped file is unmapped once no other BitBuffer shares it
+    m_Mapping.reset ();
+    m_In_Data = NULL;
+    m_In_Size = 0;
+    m_In_Buffer = m_Main_Buffer;
+  }
+  else {
+    m_In_Fp.close ();
+  }
 
   SetClosed (true);
 
@@ -157,7 +167,7 @@ bool BitBuffer::CloseWrite () {
 void BitBuffer::Flush () {
   if (!IsFlushed ()) {
     bool result = false;
-    if (GetMode () == e_MODE_READ) {
+    if (IsReadMode ()) {
       result = FlushRead ();
     }
     else if (GetMode () == e_MODE_WRITE) {
@@ -166,6 +176,10 @@ void BitBuffer::Flush () {
     else if (GetMode () == e_MODE_APPEND) {
       result = FlushWrite ();
     }
+    else if ((GetMode () == e_MODE_MEMORY_WRITE) || (GetMode () == e_MODE_UNSET)) {
+      //  Nothing to write out; the bits stay in memory
+      result = true;
+    }
 
     if (!result) {
       cerr << "WW\tUnexpected error while flushing the bit buffer." << endl;
@@ -188,7 +202,7 @@ void BitBuffer::Close () {
   
   if (!IsClosed ()) {
     bool result = false;
-    if (GetMode () == e_MODE_READ) {
+    if (IsReadMode ()) {
       result = CloseRead ();
     }
     else if (GetMode () == e_MODE_WRITE) {
@@ -197,6 +211,10 @@ void BitBuffer::Close () {
     else if (GetMode () == e_MODE_APPEND) {
       result = CloseWrite ();
     }
+    else if ((GetMode () == e_MODE_MEMORY_WRITE) || (GetMode () == e_MODE_UNSET)) {
+      SetClosed (true);
+      result = true;
+    }
 
     if (!result) {
       cerr << "WW\tUnexpected error while closing the bit buffer." << endl;
@@ -32,6 +32,11 @@
 #include <fstream>
 #include <cstdlib>  //  exit
 #include <cassert>  //  assert
+#include <vector>
+#include <cstring>  //  memcpy
+#include <bit>  //  endian
+#include <algorithm>  //  min
+#include <cstdint>  //  SIZE_MAX
 
 using namespace std;
 
@@ -46,71 +51,165 @@ using namespace std;
 
 
 /*!
-     A low-level read (private member function) that reads at *least* the given number of bits
-     from the main-buffer
+     Read the next part of the file into the main-buffer, which must be empty
 
-     \param[in] min_bits The minimum number of bits requested
-     \return Boolean indicating success or failure
-     \throw BitBuffer_Input_Exception
+     \return false if there is nothing left in the file; true otherwise
 */
-bool BitBuffer::ReadBitsLowLevel (unsigned int min_bits) {
+bool BitBuffer::ReadMainBuffer () {
   int bytes_read = 0;
 
+  if (GetMode () != e_MODE_READ) {
+    return (ReadMemoryBuffer ());
+  }
+
+  //  Cannot read from a closed file handle
+  assert (IsClosed () == false);
+
+  //  The main-buffer should have been used up
+  assert (m_Main_Buffer_Ptr == m_Main_Buffer_End);
+
+  m_In_Fp.read ((char*) m_Main_Buffer, g_BITBUFFER_SIZE);
+  bytes_read = m_In_Fp.gcount ();
+
+  //  Check if either the failbit or badbit flags are set
+  if (m_In_Fp.bad ()) {
+    cerr << "EE\tError:  Serious error in reading from input buffer after reading in " << bytes_read << " bytes." << endl;
+    exit (EXIT_FAILURE);
+  }
+  if (m_In_Fp.fail ()) {
+    if (bytes_read < g_BITBUFFER_SIZE) {
+      //  Clear the fail bit since we only reached the end of the buffer,
+      //  which is not a problem
+      m_In_Fp.clear ();
+    }
+    else {
+      cerr << "EE\tError:  Fail while reading from input buffer after reading in " << bytes_read << " bytes." << endl;
+    }
+  }
+
+  m_In_Buffer = m_Main_Buffer;
+  m_Main_Buffer_Ptr = 0;
+  m_Main_Buffer_End = bytes_read;
+  m_File_Bytes += bytes_read;
+
+  return (bytes_read != 0);
+}
+
+
+/*!
+     Point the main-buffer at the next part of m_In_Data instead of copying it.  A very
+     large file or buffer is handed out in parts of g_BITBUFFER_MEMORY_PART bytes.
+
+     \return false if there is nothing left; true otherwise
+*/
+bool BitBuffer::ReadMemoryBuffer () {
+  //  Cannot read from a closed file handle
+  assert (IsClosed () == false);
+
+  unsigned long long bytes_left = (m_File_Bytes < m_In_Size) ? (m_In_Size - m_File_Bytes) : 0;
+  size_t bytes_read = static_cast<size_t> (min (bytes_left, g_BITBUFFER_MEMORY_PART));
+
+  m_In_Buffer = m_In_Data + m_File_Bytes;
+  m_Main_Buffer_Ptr = 0;
+  m_Main_Buffer_End = bytes_read;
+  m_File_Bytes += bytes_read;
+
+  return (bytes_read != 0);
+}
+
+
+/*!
+     Top up the lookahead window near the end of the main-buffer, where 8 bytes cannot be
+     loaded at once; see Refill ().  Bytes are added one at a time, reading the next part of
+     the file when the main-buffer runs out.
+
+     \param[in] min_bits The number of bits that must be available afterwards
+     \throw BitBuffer_Input_Exception
+*/
+void BitBuffer::RefillBytes (unsigned int min_bits) {
   //  Cannot read from a closed file handle
   assert (IsClosed () == false);
 
   //  Ensure m_Main_Buffer_Ptr is not pointing out of bounds
   assert (m_Main_Buffer_Ptr <= m_Main_Buffer_End);
 
-  //  Check if the main-buffer is empty and if so, read from file
-  if (m_Main_Buffer_Ptr == m_Main_Buffer_End) {
-    m_In_Fp.read ((char*) m_Main_Buffer, g_BITBUFFER_SIZE);
-    bytes_read = m_In_Fp.gcount ();
+  m_Flushed = false;
+
+  while (m_Read_Buffer_Used <= g_ULL_SIZE_BITS - g_CHAR_SIZE_BITS) {
+    if ((m_Main_Buffer_Ptr == m_Main_Buffer_End) && (!ReadMainBuffer ())) {
+      break;
+    }
+    m_Read_Buffer |= (static_cast<unsigned long long> (m_In_Buffer[m_Main_Buffer_Ptr]) & g_MASK_LOWER_BYTE) << (g_ULL_SIZE_BITS - g_CHAR_SIZE_BITS - m_Read_Buffer_Used);
+    m_Main_Buffer_Ptr++;
+    m_Read_Buffer_Used += g_CHAR_SIZE_BITS;
+  }
+
+  if (m_Read_Buffer_Used < min_bits) {
+    throw BitBuffer_Input_Exception ();
+  }
+
+  return;
+}
+
 
-    //  Check if either the failbit or badbit flags are set
-    if (m_In_Fp.bad ()) {
-      cerr << "EE\tError:  Serious error in reading from input buffer after reading in " << bytes_read << " bytes." << endl;
+/*!
+     Empty the main-buffer once it has no room for the accumulator.  If writing to a file,
+     its contents are written out.  If writing to memory, the main-buffer is doubled in size
+     instead, but only up to m_Memory_Limit plus the room for one accumulator, so that
+     whatever was stored past the limit is caught here.
+*/
+void BitBuffer::WriteMainBuffer () {
+  if (GetMode () == e_MODE_MEMORY_WRITE) {
+    if ((m_Memory_Limit != 0) && (m_Main_Buffer_Ptr > m_Memory_Limit)) {
+      cerr << "EE\tThe bits written to memory would be more than the limit of " << m_Memory_Limit << " bytes [BitBuffer::WriteMainBuffer ()]." << endl;
       exit (EXIT_FAILURE);
     }
-    if (m_In_Fp.fail ()) {
-      if (bytes_read < g_BITBUFFER_SIZE) {
-        //  Clear the fail bit since we only reached the end of the buffer,
-        //  which is not a problem
-        m_In_Fp.clear ();
-      }
-      else {
-        cerr << "EE\tError:  Fail while reading from input buffer after reading in " << bytes_read << " bytes." << endl;
-      }
+    size_t new_size = (m_Main_Buffer_Size > SIZE_MAX / 2) ? 0 : 2 * m_Main_Buffer_Size;
+    if ((m_Memory_Limit != 0) && ((new_size == 0) || (new_size > m_Memory_Limit + g_ULL_SIZE_BYTES))) {
+      new_size = m_Memory_Limit + g_ULL_SIZE_BYTES;
     }
-
-    //  If nothing read, then error
-    if (bytes_read == 0) {
-      throw BitBuffer_Input_Exception ();
+    if (new_size < m_Main_Buffer_Ptr + g_ULL_SIZE_BYTES) {
+      cerr << "EE\tThe main buffer cannot grow beyond " << m_Main_Buffer_Size << " bytes [BitBuffer::WriteMainBuffer ()]." << endl;
+      exit (EXIT_FAILURE);
     }
+    char *tmp = new char[new_size];
+    memcpy (tmp, m_Main_Buffer, m_Main_Buffer_Ptr);
+    delete [] m_Main_Buffer;
+    m_Main_Buffer = tmp;
+    m_Main_Buffer_Size = new_size;
+    return;
+  }
 
-    m_Main_Buffer_Ptr = 0;
-    m_Main_Buffer_End = bytes_read;
+  m_Out_Fp.write ((char*) m_Main_Buffer, m_Main_Buffer_Ptr);
+  if (m_Out_Fp.bad ()) {
+    cerr << "EE\tError while writing to output file." << endl;
+    exit (EXIT_FAILURE);
   }
+  m_File_Bytes += m_Main_Buffer_Ptr;
+  m_Main_Buffer_Ptr = 0;
 
-  //  Copy the main-buffer to the mini-buffer
-  unsigned int new_bits = 0;
-  while (new_bits < g_UINT_SIZE_BITS) {
-    m_Mini_Buffer = m_Mini_Buffer << g_CHAR_SIZE_BITS;
-    m_Mini_Buffer |= static_cast<unsigned int>(m_Main_Buffer[m_Main_Buffer_Ptr]) & g_MASK_LOWER_BYTE;
-    m_Main_Buffer_Ptr++;
-    new_bits += g_CHAR_SIZE_BITS;
-    if (m_Main_Buffer_Ptr > m_Main_Buffer_End) {
-      m_Main_Buffer_End = m_Main_Buffer_Ptr;
-      break;
-    }
+  return;
+}
+
+
+/*!
+     Store the full accumulator in the main-buffer with one 64-bit write, most significant
+     byte first, and then empty the main-buffer if it has no room for the next one.
+
+     \param[in] x The value to store
+*/
+void BitBuffer::WriteLongWord (unsigned long long x) {
+  if constexpr (endian::native == endian::little) {
+    x = __builtin_bswap64 (x);
   }
+  memcpy (&m_Main_Buffer[m_Main_Buffer_Ptr], &x, g_ULL_SIZE_BYTES);
+  m_Main_Buffer_Ptr += g_ULL_SIZE_BYTES;
 
-  m_Mini_Buffer_Used = new_bits;
-  if (m_Mini_Buffer_Used < min_bits) {
-    throw BitBuffer_Input_Exception ();
+  if (m_Main_Buffer_Ptr + g_ULL_SIZE_BYTES > m_Main_Buffer_Size) {
+    WriteMainBuffer ();
   }
 
-  return true;
+  return;
 }
 
 
@@ -132,10 +231,8 @@ unsigned int BitBuffer::ReadBits (unsigned int num_bits) {
   //  Cannot read from a closed file handle
   assert (IsClosed () == false);
 
-  if (IsFlushed ()) {
-    SetFlushed (false);
-  }
-  
+  m_Flushed = false;
+
   if (num_bits > g_UINT_SIZE_BITS) {
     cerr << "EE\tMore bits (" << num_bits << ") requested than what can be provided [BitBuffer::ReadBits ()]." << endl;
     exit (EXIT_FAILURE);
@@ -146,30 +243,8 @@ unsigned int BitBuffer::ReadBits (unsigned int num_bits) {
     return (0);
   }
 
-  //  Initialize x depending on whether or not there are any bits in the
-  //  mini-buffer
-  if (m_Mini_Buffer_Used == 0) {
-    x = 0;
-  }
-  else {
-    x = (m_Mini_Buffer) >> (g_UINT_SIZE_BITS - num_bits);
-  }
-
-  //  Check if the mini-buffer has enough bits to satisfy our request
-  if (num_bits <= m_Mini_Buffer_Used) {
-    m_Mini_Buffer = m_Mini_Buffer << num_bits;
-    m_Mini_Buffer_Used -= num_bits;
-  }
-  else {
-    num_bits -= m_Mini_Buffer_Used;
-    bool retval = ReadBitsLowLevel (num_bits);
-    if (retval == false) {
-      throw BitBuffer_Input_Exception ();
-    }
-    x |= (m_Mini_Buffer) >> (g_UINT_SIZE_BITS - num_bits);
-    m_Mini_Buffer = m_Mini_Buffer << num_bits;
-    m_Mini_Buffer_Used -= num_bits;
-  }
+  x = static_cast<unsigned int> (Peek (num_bits));
+  Consume (num_bits);
 
   if (GetDebug ()) {
     cerr << "\tBitbuffer::ReadBits\t" << x << "\t" << num_bits << endl;
@@ -180,77 +255,38 @@ unsigned int BitBuffer::ReadBits (unsigned int num_bits) {
 
 
 /*!
-     Write a value using the specified number of bits.
+     Write a value using the specified number of bits.  The value is not masked, so it
+     must fit in them.
 
      \param[in] value Number to write
      \param[in] num_bits Number of bits to use
 */
 void BitBuffer::WriteBits (unsigned int value, unsigned int num_bits) {
-  unsigned int x = value;
-  unsigned int unused_bits = g_UINT_SIZE_BITS - m_Mini_Buffer_Used;
-
   //  Cannot write to a closed file handle
   assert (IsClosed () == false);
 
   //  Number of bits to be written out should never be greater than this limit
   assert (num_bits <= g_UINT_SIZE_BITS);
+  assert ((static_cast<unsigned long long> (value) >> num_bits) == 0);
 
-  if (IsFlushed ()) {
-    SetFlushed (false);
-  }
+  m_Flushed = false;
 
   if (GetDebug ()) {
     cerr << "\tBitbuffer::WriteBits\t" << value << "\t" << num_bits << endl;
   }
 
-  //  Check if there is space in the mini-buffer for the bits that we want to write
-  if (num_bits <= unused_bits) {
-    if (num_bits != g_UINT_SIZE_BITS) {
-      //  Make space for the bits and add them in.  The following line works even if
-      //  (num_bits == g_UINT_SIZE_BITS) since (1 << g_UINT_SIZE_BITS) == 0.
-      m_Mini_Buffer = (m_Mini_Buffer << num_bits) | (x & ((1 << num_bits) - 1));
-    }
-    else {
-      m_Mini_Buffer = x;
-    }
-
-    //  Update the number of bits in use
-    m_Mini_Buffer_Used += num_bits;
+  //  The accumulator holds fewer than 64 bits.  The bits are shifted in below them if they
+  //  fit; otherwise, the accumulator is filled, stored whole, and left with the bits that
+  //  did not fit.  Any bits above the valid ones have already been stored.
+  unsigned int room = g_ULL_SIZE_BITS - m_Write_Buffer_Used;
+  if (num_bits < room) {
+    m_Write_Buffer = (m_Write_Buffer << num_bits) | value;
+    m_Write_Buffer_Used += num_bits;
   }
   else {
-    //  If there is no space in the mini-buffer, make some space and add what we can,
-    //  (which is the first "unused_bits" of x)
-    m_Mini_Buffer = m_Mini_Buffer << unused_bits;
-    m_Mini_Buffer = m_Mini_Buffer | ((x >> (num_bits - unused_bits)) & ((1 << (unused_bits)) - 1));
-
-    //  Copy the mini-buffer to the main-buffer
-    unsigned int processed_bits = 0;
-    while (processed_bits < g_UINT_SIZE_BITS) {
-      m_Main_Buffer[m_Main_Buffer_Ptr] = static_cast<char>((m_Mini_Buffer >> (g_UINT_SIZE_BITS - g_CHAR_SIZE_BITS)) & g_MASK_LOWER_BYTE);
-
-      m_Main_Buffer_Ptr++;
-      m_Mini_Buffer = m_Mini_Buffer << g_CHAR_SIZE_BITS;
-      processed_bits += g_CHAR_SIZE_BITS;
-    }
-
-    //  Add the remaining bits to the mini-buffer, which is "num_bits - unused_bits"
-    if (num_bits - unused_bits != g_UINT_SIZE_BITS) {
-      m_Mini_Buffer = x & ((1 << (num_bits - unused_bits)) - 1);
-    }
-    else {
-      m_Mini_Buffer = x;
-    }
-    m_Mini_Buffer_Used = num_bits - unused_bits;
-
-    //  Check if the main-buffer needs to be written out
-    if (m_Main_Buffer_Ptr >= g_BITBUFFER_SIZE) {            /*  Write bits out  */
-      m_Out_Fp.write ((char*) m_Main_Buffer, m_Main_Buffer_Ptr);
-      if (m_Out_Fp.bad ()) {
-        cerr << "EE\tError while writing to output file." << endl;
-        exit (EXIT_FAILURE);
-      }
-      m_Main_Buffer_Ptr = 0;
-    }
+    m_Write_Buffer_Used = num_bits - room;
+    WriteLongWord ((m_Write_Buffer << room) | (static_cast<unsigned long long> (value) >> m_Write_Buffer_Used));
+    m_Write_Buffer = value;
   }
 
   return;
@@ -343,7 +379,7 @@ bool BitBuffer::ReadChars (char *buffer, int num_values) {
      \param[in] num_values The number of values to write
      \return true upon success; false otherwise.
 */
-bool BitBuffer::WriteChars (char *buffer, int num_values) {
+bool BitBuffer::WriteChars (const char *buffer, int num_values) {
   //  Cannot write to a closed file handle
   assert (IsClosed () == false);
 
@@ -352,10 +388,200 @@ bool BitBuffer::WriteChars (char *buffer, int num_values) {
   }
 
   for (int i = 0; i < num_values; i++) {
-    WriteBits (static_cast<unsigned int> (buffer[i]), 8);
+    WriteBits (static_cast<unsigned char> (buffer[i]), 8);
   }
 
   return true;
 }
 
 
+//  -----------------------------------------------------------------
+//  Public functions (BitBuffer)
+//  -----------------------------------------------------------------
+
+
+/*!
+     Append all of the bits written so far to a BitBuffer in e_MODE_MEMORY_WRITE.  The
+     bits are copied exactly, without any padding, so the result is the same as if they
+     had been written to this BitBuffer directly.  The source must not have been flushed.
+
+     \param[in] src The BitBuffer to copy the bits from
+*/
+void BitBuffer::WriteBitBuffer (const BitBuffer &src) {
+  //  Cannot write to a closed file handle
+  assert (IsClosed () == false);
+
+  if (src.GetMode () != e_MODE_MEMORY_WRITE) {
+    cerr << "EE\tOnly a BitBuffer written to memory can be appended [BitBuffer::WriteBitBuffer ()]." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  //  The main-buffer of the source only holds whole unsigned ints.  If this BitBuffer is
+  //  also on an unsigned int boundary, its bytes can be copied as-is.
+  if (m_Write_Buffer_Used == 0) {
+    size_t copied = 0;
+    while (copied < src.m_Main_Buffer_Ptr) {
+      size_t count = min (src.m_Main_Buffer_Ptr - copied, m_Main_Buffer_Size - m_Main_Buffer_Ptr);
+      memcpy (&m_Main_Buffer[m_Main_Buffer_Ptr], &src.m_Main_Buffer[copied], count);
+      m_Main_Buffer_Ptr += count;
+      copied += count;
+      if (m_Main_Buffer_Ptr + g_ULL_SIZE_BYTES > m_Main_Buffer_Size) {
+        WriteMainBuffer ();
+      }
+    }
+  }
+  else {
+    for (size_t i = 0; i < src.m_Main_Buffer_Ptr; i += g_UINT_SIZE_BYTES) {
+      unsigned int x = 0;
+      memcpy (&x, &src.m_Main_Buffer[i], g_UINT_SIZE_BYTES);
+      if constexpr (endian::native == endian::little) {
+        x = __builtin_bswap32 (x);
+      }
+      WriteBits (x, g_UINT_SIZE_BITS);
+    }
+  }
+
+  //  Followed by whatever bits are left in its accumulator, at most 32 at a time
+  unsigned int used = src.m_Write_Buffer_Used;
+  if (used > g_UINT_SIZE_BITS) {
+    used -= g_UINT_SIZE_BITS;
+    WriteBits (static_cast<unsigned int> (src.m_Write_Buffer >> used), g_UINT_SIZE_BITS);
+  }
+  if (used != 0) {
+    WriteBits (static_cast<unsigned int> (src.m_Write_Buffer & ((1ULL << used) - 1)), used);
+  }
+
+  m_Flushed = false;
+
+  return;
+}
+
+
+
+
+/*!
+     Copy all of the bits written so far by a BitBuffer in e_MODE_MEMORY_WRITE to a vector,
+     padded with 0's to a whole unsigned int as if they had been flushed to a file.  This
+     object is not changed, so more bits can be written afterwards.
+
+     \param[out] bytes The vector to fill; its previous contents are discarded
+*/
+void BitBuffer::GetBytes (vector<char> &bytes) const {
+  if (GetMode () != e_MODE_MEMORY_WRITE) {
+    cerr << "EE\tOnly the bits of a BitBuffer written to memory can be copied [BitBuffer::GetBytes ()]." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  //  The bits left in the accumulator are padded to whole unsigned ints
+  unsigned int num_bytes = 0;
+  if (m_Write_Buffer_Used != 0) {
+    num_bytes = (m_Write_Buffer_Used > g_UINT_SIZE_BITS) ? g_ULL_SIZE_BYTES : g_UINT_SIZE_BYTES;
+  }
+  if ((m_Memory_Limit != 0) && (m_Main_Buffer_Ptr + num_bytes > m_Memory_Limit)) {
+    cerr << "EE\tThe bits written to memory would be more than the limit of " << m_Memory_Limit << " bytes [BitBuffer::GetBytes ()]." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  bytes.assign (m_Main_Buffer, m_Main_Buffer + m_Main_Buffer_Ptr);
+
+  //  Followed by whatever bits are left in the accumulator
+  if (num_bytes != 0) {
+    unsigned long long x = m_Write_Buffer << (g_ULL_SIZE_BITS - m_Write_Buffer_Used);
+    for (unsigned int i = 0; i < num_bytes; i++) {
+      bytes.push_back (static_cast<char> ((x >> (g_ULL_SIZE_BITS - g_CHAR_SIZE_BITS * (i + 1))) & g_MASK_LOWER_BYTE));
+    }
+  }
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Public functions (positioning)
+//  -----------------------------------------------------------------
+
+
+/*!
+     Return the number of bits read or written so far.  For a file, this is the position
+     from the start of the file (or from the position where appending began).
+
+     \return The position in bits
+*/
+unsigned long long BitBuffer::GetPosition () const {
+  unsigned long long position = 0;
+
+  if (IsReadMode ()) {
+    position = (m_File_Bytes - (m_Main_Buffer_End - m_Main_Buffer_Ptr)) * g_CHAR_SIZE_BITS;
+    position -= m_Read_Buffer_Used;
+  }
+  else {
+    position = (m_File_Bytes + m_Main_Buffer_Ptr) * g_CHAR_SIZE_BITS;
+    position += m_Write_Buffer_Used;
+  }
+
+  return (position);
+}
+
+
+/*!
+     Skip over the bits until the position is a multiple of num_bits.  The bits skipped are
+     the ones added by AlignWrite ().
+
+     \param[in] num_bits The boundary to align to, in bits
+*/
+void BitBuffer::AlignRead (unsigned int num_bits) {
+  assert ((num_bits > 0) && (num_bits <= g_UINT_SIZE_BITS));
+
+  unsigned int remainder = static_cast<unsigned int> (GetPosition () % num_bits);
+  if (remainder != 0) {
+    ReadBits (num_bits - remainder);
+  }
+
+  return;
+}
+
+
+/*!
+     Move to a byte in the file so that the next bit read is its most significant bit.
+
+     \param[in] byte_offset Position in the file, in bytes
+*/
+void BitBuffer::SeekRead (unsigned long long byte_offset) {
+  assert (IsReadMode ());
+
+  //  Bytes in memory only need the position below to be changed
+  if (GetMode () == e_MODE_READ) {
+    m_In_Fp.clear ();
+    m_In_Fp.seekg (static_cast<streamoff> (byte_offset), ios::beg);
+    if (m_In_Fp.fail ()) {
+      cerr << "EE\tCannot move to byte " << byte_offset << " of " << GetFilename () << "." << endl;
+      exit (EXIT_FAILURE);
+    }
+  }
+
+  m_Read_Buffer = 0;
+  m_Read_Buffer_Used = 0;
+  m_Main_Buffer_Ptr = 0;
+  m_Main_Buffer_End = 0;
+  m_File_Bytes = byte_offset;
+
+  return;
+}
+
+
+/*!
+     Pad with 0's until the position is a multiple of num_bits.  With a num_bits of 8, the
+     next bit written starts a new byte.
+
+     \param[in] num_bits The boundary to align to, in bits
+*/
+void BitBuffer::AlignWrite (unsigned int num_bits) {
+  assert ((num_bits > 0) && (num_bits <= g_UINT_SIZE_BITS));
+
+  unsigned int remainder = static_cast<unsigned int> (GetPosition () % num_bits);
+  if (remainder != 0) {
+    WriteBits (0, num_bits - remainder);
+  }
+
+  return;
+}
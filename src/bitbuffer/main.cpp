@@ -74,6 +74,27 @@ int main(int argc, char **argv) {
   else if (strcmp (argv[1], "7") == 0) {
     result = TestUnsignedChars ();
   }
+  else if (strcmp (argv[1], "8") == 0) {
+    result = TestMemoryWrite ();
+  }
+  else if (strcmp (argv[1], "9") == 0) {
+    result = TestAlign ();
+  }
+  else if (strcmp (argv[1], "10") == 0) {
+    result = TestPeekConsume ();
+  }
+  else if (strcmp (argv[1], "11") == 0) {
+    result = TestMappedRead ();
+  }
+  else if (strcmp (argv[1], "12") == 0) {
+    result = TestMemoryRead ();
+  }
+  else if (strcmp (argv[1], "13") == 0) {
+    result = TestMemoryLimit (false);
+  }
+  else if (strcmp (argv[1], "14") == 0) {
+    result = TestMemoryLimit (true);
+  }
   else {
     cerr << "==\tError:  Test case unknown!" << endl;
     return (EXIT_FAILURE);
@@ -0,0 +1,158 @@
+//  ###########################################################################
+//  Copyright 2011-2015, 2024 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file mapped.cpp
+    Memory-mapped input (e_MODE_MAPPED_READ) for BitBuffer class.
+*/
+/*******************************************************************/
+
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <memory>  //  shared_ptr
+#include <algorithm>  //  min
+#include <cstdlib>  //  exit
+#include <cassert>  //  assert
+
+#include "BitBuffer_Config.hpp"
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>  //  mmap, madvise, munmap
+#include <sys/stat.h>  //  fstat
+#include <fcntl.h>  //  open
+#include <unistd.h>  //  close
+#endif
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer_exception.hpp"
+#include "bitbuffer.hpp"
+
+
+/*!
+     A read-only mapping of a whole file.  It is unmapped when the last BitBuffer
+     using it is closed or destroyed.
+*/
+struct BitBufferMapping {
+  //!  Start of the mapping
+  const char *m_Data;
+  //!  Length of the file, in bytes
+  unsigned long long m_Size;
+
+  ~BitBufferMapping () {
+#ifdef HAVE_SYS_MMAN_H
+    munmap (const_cast<char*> (m_Data), m_Size);
+#endif
+  }
+};
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+
+/*!
+     Map the whole file into memory and advise the kernel that it will be read
+     sequentially.  A file that cannot be mapped (i.e., one that is empty or not a
+     regular file) is left for the caller to read with an ifstream instead.
+
+     \return true if the file was mapped; false otherwise
+*/
+bool BitBuffer::MapFile () {
+#ifdef HAVE_SYS_MMAN_H
+  int fd = open (GetFilename ().c_str (), O_RDONLY);
+  if (fd == -1) {
+    cerr << "EE\tCannot open " << GetFilename () << " for reading." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  struct stat info;
+  if ((fstat (fd, &info) == -1) || (!S_ISREG (info.st_mode)) || (info.st_size == 0)) {
+    close (fd);
+    return false;
+  }
+
+  void *data = mmap (NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  madvise (data, info.st_size, MADV_SEQUENTIAL);
+
+  m_Mapping = shared_ptr<const BitBufferMapping> (new BitBufferMapping {static_cast<const char*> (data), static_cast<unsigned long long> (info.st_size)});
+  m_In_Data = m_Mapping -> m_Data;
+  m_In_Size = m_Mapping -> m_Size;
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+
+/*!
+     Initialization function for reading the same bytes as another BitBuffer in
+     e_MODE_MAPPED_READ or e_MODE_MEMORY_READ, without mapping or copying them again.
+     The two BitBuffers have their own positions, so each one can be used by a different
+     thread.  If the other BitBuffer is in e_MODE_READ instead, then the file is opened
+     again.
+
+     \param[in] src The BitBuffer whose file is read
+     \param[in] debug Whether or not debugging is turned on
+*/
+void BitBuffer::Initialize (const BitBuffer &src, bool debug) {
+  if (src.GetMode () == e_MODE_READ) {
+    Initialize (src.GetFilename (), e_MODE_READ, debug);
+    return;
+  }
+  if ((src.GetMode () != e_MODE_MAPPED_READ) && (src.GetMode () != e_MODE_MEMORY_READ)) {
+    cerr << "EE\tOnly a BitBuffer being read can be shared [BitBuffer::Initialize ()]." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  m_Debug = debug;
+  m_Filename = src.GetFilename ();
+  m_Mode = src.GetMode ();
+  m_Mapping = src.m_Mapping;
+  m_In_Data = src.m_In_Data;
+  m_In_Size = src.m_In_Size;
+  m_In_Buffer = m_In_Data;
+
+  m_Flushed = false;
+  m_Closed = false;
+  m_Read_Buffer = 0;
+  m_Read_Buffer_Used = 0;
+  m_Main_Buffer_Ptr = 0;
+  m_Main_Buffer_End = 0;
+  m_File_Bytes = 0;
+
+  return;
+}
@@ -31,6 +31,7 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <iterator>  //  istreambuf_iterator
 
 #include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE
 #include <cmath>  //  log
@@ -356,3 +357,380 @@ int TestUnsignedChars () {
   cerr << "==\tTestUnsignedChars successful!" << endl;
   return (EXIT_SUCCESS);
 }
+
+
+/*!
+     Produce random values with a variable width and write them out twice:  directly to a file and
+     through several BitBuffers in memory which are then appended to a second file.  Both files
+     must be identical.
+
+     \return The program exit condition
+*/
+int TestMemoryWrite () {
+  string str = "tmp.data";  //  Output filename for writing directly
+  string str_memory = "tmp-memory.data";  //  Output filename for writing via memory
+  vector<int> nums;
+  vector<int>::iterator iter;
+
+  //  Initialize the random seed
+  srand (time (NULL));
+
+  //  Generate random numbers
+  int i = 0;
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    int num = (rand() % g_TEST_RANGE) + 1;
+    nums.push_back (num);
+  }
+
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  for (iter = nums.begin(); iter != nums.end(); iter++) {
+    bitbuff_out.WriteBits (*iter, BitLength (*iter));
+  }
+  bitbuff_out.Finish ();
+
+  //  Write the same values in unevenly-sized pieces, re-using the staging BitBuffer
+  BitBuffer bitbuff_memory_out;
+  BitBuffer bitbuff_staging;
+  bitbuff_memory_out.Initialize (str_memory, e_MODE_WRITE);
+  i = 0;
+  int piece_size = 1;
+  while (i < g_TEST_SIZE) {
+    bitbuff_staging.Initialize (e_MODE_MEMORY_WRITE);
+    for (int j = 0; (j < piece_size) && (i < g_TEST_SIZE); j++, i++) {
+      bitbuff_staging.WriteBits (nums[i], BitLength (nums[i]));
+    }
+    bitbuff_memory_out.WriteBitBuffer (bitbuff_staging);
+    piece_size = (piece_size * 7) + 3;
+  }
+  bitbuff_memory_out.Finish ();
+
+  //  Compare the two files
+  ifstream fp_direct (str.c_str (), ios::in|ios::binary);
+  ifstream fp_memory (str_memory.c_str (), ios::in|ios::binary);
+  vector<char> bytes_direct ((istreambuf_iterator<char>(fp_direct)), istreambuf_iterator<char>());
+  vector<char> bytes_memory ((istreambuf_iterator<char>(fp_memory)), istreambuf_iterator<char>());
+  if (bytes_direct != bytes_memory) {
+    cerr << "==\tError:  Mismatch in file contents (" << bytes_direct.size () << " : " << bytes_memory.size () << " bytes)" << endl;
+    return (EXIT_FAILURE);
+  }
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str_memory, e_MODE_READ);
+  for (iter = nums.begin(); iter != nums.end(); iter++) {
+    int num = bitbuff_in.ReadBits (BitLength (*iter));
+    if (num != *iter) {
+      cerr << "==\tError:  Mismatch in number (" << num << " : " << *iter << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+  }
+  bitbuff_in.Finish ();
+
+  cerr << "==\tTestMemoryWrite successful!" << endl;
+  return (EXIT_SUCCESS);
+}
+
+
+/*!
+     Write random numbers of variable length, aligning to a byte or an unsigned int boundary
+     after some of them, and check the positions reported.  Then read them back, skipping over
+     the padding.
+
+     \return Returns EXIT_SUCCESS or EXIT_FAILURE
+*/
+int TestAlign () {
+  string str = "tmp.data";  //  Output filename
+  vector<int> nums;
+  vector<unsigned long long> positions;  //  Position after each number and its padding
+
+  //  Initialize the random seed
+  srand (time (NULL));
+
+  //  Generate random numbers
+  int i = 0;
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    int num = (rand() % g_TEST_RANGE) + 1;
+    nums.push_back (num);
+  }
+
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  unsigned long long expected = 0;
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    bitbuff_out.WriteBits (nums[i], BitLength (nums[i]));
+    expected += BitLength (nums[i]);
+    if (i % 3 == 0) {
+      bitbuff_out.AlignWrite (g_CHAR_SIZE_BITS);
+      expected = ((expected + g_CHAR_SIZE_BITS - 1) / g_CHAR_SIZE_BITS) * g_CHAR_SIZE_BITS;
+    }
+    else if (i % 7 == 0) {
+      bitbuff_out.AlignWrite (g_UINT_SIZE_BITS);
+      expected = ((expected + g_UINT_SIZE_BITS - 1) / g_UINT_SIZE_BITS) * g_UINT_SIZE_BITS;
+    }
+    if (bitbuff_out.GetPosition () != expected) {
+      cerr << "==\tError:  Mismatch in write position (" << bitbuff_out.GetPosition () << " : " << expected << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+    positions.push_back (expected);
+  }
+  bitbuff_out.Finish ();
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    int num = bitbuff_in.ReadBits (BitLength (nums[i]));
+    if (num != nums[i]) {
+      cerr << "==\tError:  Mismatch in number (" << num << " : " << nums[i] << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+    if (i % 3 == 0) {
+      bitbuff_in.AlignRead (g_CHAR_SIZE_BITS);
+    }
+    else if (i % 7 == 0) {
+      bitbuff_in.AlignRead (g_UINT_SIZE_BITS);
+    }
+    if (bitbuff_in.GetPosition () != positions[i]) {
+      cerr << "==\tError:  Mismatch in read position (" << bitbuff_in.GetPosition () << " : " << positions[i] << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+  }
+
+  //  Jump back to the numbers which follow a byte boundary, in reverse
+  for (i = g_TEST_SIZE - 2; i >= 0; i--) {
+    if (i % 3 == 0) {
+      bitbuff_in.SeekRead (positions[i] / g_CHAR_SIZE_BITS);
+      int num = bitbuff_in.ReadBits (BitLength (nums[i + 1]));
+      if (num != nums[i + 1]) {
+        cerr << "==\tError:  Mismatch in number after seeking (" << num << " : " << nums[i + 1] << ")" << endl;
+        return (EXIT_FAILURE);
+      }
+    }
+  }
+  bitbuff_in.Finish ();
+
+  cerr << "==\tTestAlign successful!" << endl;
+  return (EXIT_SUCCESS);
+}
+
+
+/*!
+     Write random numbers and then read the bits back with Peek () and Consume (), using
+     random widths, comparing against a copy of the bits kept in memory.
+
+     \return EXIT_SUCCESS or EXIT_FAILURE
+*/
+int TestPeekConsume () {
+  string str = "tmp.data";  //  Output filename
+  vector<bool> bits;  //  Copy of every bit written
+
+  //  Initialize the random seed
+  srand (time (NULL));
+
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  int i = 0;
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    int num = (rand() % g_TEST_RANGE) + 1;
+    int len = BitLength (num);
+    bitbuff_out.WriteBits (num, len);
+    for (int j = len - 1; j >= 0; j--) {
+      bits.push_back (((num >> j) & 1) == 1);
+    }
+  }
+  bitbuff_out.Finish ();
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  unsigned long long pos = 0;
+  while (pos < bits.size ()) {
+    unsigned int num_bits = (rand() % g_BITBUFFER_PEEK_MAX) + 1;
+    unsigned long long expected = 0;
+    for (unsigned int j = 0; j < num_bits; j++) {
+      bool bit = (pos + j < bits.size ()) ? bits[pos + j] : false;
+      expected = (expected << 1) | (bit ? 1 : 0);
+    }
+
+    unsigned long long x = bitbuff_in.Peek (num_bits);
+    if (x != expected) {
+      cerr << "==\tError:  Mismatch in " << num_bits << " bits peeked at position " << pos << " (" << x << " : " << expected << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+
+    //  Remove some of the bits looked at, but none past the end of what was written
+    unsigned int consumed = rand() % (num_bits + 1);
+    if (pos + consumed > bits.size ()) {
+      consumed = static_cast<unsigned int> (bits.size () - pos);
+    }
+    bitbuff_in.Consume (consumed);
+    pos += consumed;
+    if (bitbuff_in.GetPosition () != pos) {
+      cerr << "==\tError:  Mismatch in read position (" << bitbuff_in.GetPosition () << " : " << pos << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+  }
+  bitbuff_in.Finish ();
+
+  cerr << "==\tTestPeekConsume successful!" << endl;
+  return (EXIT_SUCCESS);
+}
+
+
+/*!
+     Write random numbers and read them back from a memory-mapped file, twice:  once
+     with the BitBuffer that mapped the file and once with a second BitBuffer sharing its
+     mapping.  The second one also seeks to the byte after each of the first numbers.
+
+     \return EXIT_SUCCESS or EXIT_FAILURE
+*/
+int TestMappedRead () {
+  string str = "tmp.data";  //  Output filename
+  vector<int> nums;
+
+  //  Initialize the random seed
+  srand (time (NULL));
+
+  //  Generate random numbers
+  int i = 0;
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    int num = (rand() % g_TEST_RANGE) + 1;
+    nums.push_back (num);
+  }
+
+  //  Write each number on its own byte so that it can be sought
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    bitbuff_out.WriteBits (nums[i], BitLength (nums[i]));
+    bitbuff_out.AlignWrite (g_CHAR_SIZE_BITS);
+  }
+  bitbuff_out.Finish ();
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_MAPPED_READ);
+  BitBuffer bitbuff_shared;
+  bitbuff_shared.Initialize (bitbuff_in);
+  vector<unsigned long long> positions;
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    positions.push_back (bitbuff_in.GetPosition ());
+    int num = bitbuff_in.ReadBits (BitLength (nums[i]));
+    if (num != nums[i]) {
+      cerr << "==\tError:  Mismatch in number (" << num << " : " << nums[i] << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+    bitbuff_in.AlignRead (g_CHAR_SIZE_BITS);
+  }
+  bitbuff_in.Finish ();
+
+  //  The mapping is still used by the second BitBuffer after the first is closed
+  for (i = g_TEST_SIZE - 1; i >= 0; i--) {
+    bitbuff_shared.SeekRead (positions[i] / g_CHAR_SIZE_BITS);
+    int num = bitbuff_shared.ReadBits (BitLength (nums[i]));
+    if (num != nums[i]) {
+      cerr << "==\tError:  Mismatch in number after seeking (" << num << " : " << nums[i] << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+  }
+  bitbuff_shared.Finish ();
+
+  cerr << "==\tTestMappedRead successful!" << endl;
+  return (EXIT_SUCCESS);
+}
+
+
+/*!
+     Write random numbers to memory and to a file, check that GetBytes () gives the same
+     bytes as the file, and then read the numbers back from those bytes in memory.
+
+     \return EXIT_SUCCESS or EXIT_FAILURE
+*/
+int TestMemoryRead () {
+  string str = "tmp.data";  //  Output filename
+  vector<int> nums;
+
+  //  Initialize the random seed
+  srand (time (NULL));
+
+  //  Generate random numbers
+  int i = 0;
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    int num = (rand() % g_TEST_RANGE) + 1;
+    nums.push_back (num);
+  }
+
+  BitBuffer bitbuff_file;
+  bitbuff_file.Initialize (str, e_MODE_WRITE);
+  BitBuffer bitbuff_memory;
+  bitbuff_memory.Initialize (e_MODE_MEMORY_WRITE);
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    bitbuff_file.WriteBits (nums[i], BitLength (nums[i]));
+    bitbuff_memory.WriteBits (nums[i], BitLength (nums[i]));
+  }
+  bitbuff_file.Finish ();
+
+  vector<char> bytes;
+  bitbuff_memory.GetBytes (bytes);
+  ifstream fp (str.c_str (), ios::in|ios::binary);
+  vector<char> file_bytes ((istreambuf_iterator<char> (fp)), istreambuf_iterator<char> ());
+  fp.close ();
+  if (bytes != file_bytes) {
+    cerr << "==\tError:  Mismatch between the bytes in memory and in the file (" << bytes.size () << " : " << file_bytes.size () << ")" << endl;
+    return (EXIT_FAILURE);
+  }
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (bytes.data (), bytes.size ());
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    int num = bitbuff_in.ReadBits (BitLength (nums[i]));
+    if (num != nums[i]) {
+      cerr << "==\tError:  Mismatch in number (" << num << " : " << nums[i] << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+  }
+  bitbuff_in.Finish ();
+
+  cerr << "==\tTestMemoryRead successful!" << endl;
+  return (EXIT_SUCCESS);
+}
+
+
+/*!
+     Write whole unsigned ints to memory with a limit which is not a multiple of their size,
+     and read them back.  If exceed is true, one unsigned int too many is written, so the
+     program should exit with an error.
+
+     \param[in] exceed Whether to write more than the limit
+     \return EXIT_SUCCESS or EXIT_FAILURE
+*/
+int TestMemoryLimit (bool exceed) {
+  unsigned int limit = (3 * g_BITBUFFER_SIZE) + 10;
+  unsigned int num_words = (limit / g_UINT_SIZE_BYTES) - (exceed ? 0 : 2);
+
+  BitBuffer bitbuff_memory;
+  bitbuff_memory.Initialize (e_MODE_MEMORY_WRITE);
+  bitbuff_memory.SetMemoryLimit (limit);
+  for (unsigned int i = 0; i < num_words; i++) {
+    bitbuff_memory.WriteBits (i, g_UINT_SIZE_BITS);
+  }
+  bitbuff_memory.WriteBits (5, 20);
+
+  vector<char> bytes;
+  bitbuff_memory.GetBytes (bytes);
+  if (bytes.size () > limit) {
+    cerr << "==\tError:  " << bytes.size () << " bytes were written with a limit of " << limit << endl;
+    return (EXIT_FAILURE);
+  }
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (bytes.data (), bytes.size ());
+  for (unsigned int i = 0; i < num_words; i++) {
+    unsigned int num = bitbuff_in.ReadBits (g_UINT_SIZE_BITS);
+    if (num != i) {
+      cerr << "==\tError:  Mismatch in number (" << num << " : " << i << ")" << endl;
+      return (EXIT_FAILURE);
+    }
+  }
+  bitbuff_in.Finish ();
+
+  cerr << "==\tTestMemoryLimit successful!" << endl;
+  return (EXIT_SUCCESS);
+}
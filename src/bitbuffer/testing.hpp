@@ -47,6 +47,12 @@ int GenerateFixed ();
 int GenerateVariable ();
 int TestUnsignedInts ();
 int TestUnsignedChars ();
+int TestMemoryWrite ();
+int TestAlign ();
+int TestPeekConsume ();
+int TestMappedRead ();
+int TestMemoryRead ();
+int TestMemoryLimit (bool exceed);
 
 #endif
 
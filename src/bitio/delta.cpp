@@ -32,15 +32,76 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <array>
+#include <bit>  //  bit_width, countl_one
 
 using namespace std;
 
+#include "common.hpp"
 #include "bitbuffer.hpp"
 #include "math_utils.hpp"
 #include "gamma.hpp"
 #include "delta.hpp"
 
 
+/*!
+     Number of bits used to index g_DELTA_TABLE.  The codewords of all values below 64 are
+     at most this long.
+*/
+const unsigned int g_DELTA_TABLE_BITS = 10;
+
+
+/*!
+     Entry of g_DELTA_TABLE
+*/
+struct DeltaTableEntry {
+  //!  Length of the codeword; 0 if it is longer than g_DELTA_TABLE_BITS
+  unsigned char length;
+  //!  Decoded value
+  unsigned char value;
+};
+
+
+/*!
+     Build the table for decoding short delta codewords.  Every entry whose index starts
+     with the codeword of a value holds that value and the length of its codeword.
+
+     \return The table, indexed by the next g_DELTA_TABLE_BITS bits
+*/
+static constexpr array<DeltaTableEntry, (1 << g_DELTA_TABLE_BITS)> BuildDeltaTable () {
+  array<DeltaTableEntry, (1 << g_DELTA_TABLE_BITS)> table {};
+
+  for (unsigned int value = 1; ; value++) {
+    unsigned int logx = bit_width (value) - 1;
+    unsigned int loglen = bit_width (logx + 1) - 1;
+    unsigned int length = 2 * loglen + 1 + logx;
+    if (length > g_DELTA_TABLE_BITS) {
+      break;
+    }
+
+    //  Gamma code of (logx + 1), i.e., loglen 1 bits, a 0 bit, and loglen bits of binary,
+    //  followed by logx bits of binary
+    unsigned int code = ((1u << loglen) - 1) << (loglen + 1);
+    code |= (logx + 1) - (1u << loglen);
+    code = (code << logx) | (value - (1u << logx));
+
+    unsigned int first = code << (g_DELTA_TABLE_BITS - length);
+    for (unsigned int i = 0; i < (1u << (g_DELTA_TABLE_BITS - length)); i++) {
+      table[first + i].length = static_cast<unsigned char> (length);
+      table[first + i].value = static_cast<unsigned char> (value);
+    }
+  }
+
+  return (table);
+}
+
+
+/*!
+     Table for decoding short delta codewords
+*/
+static constexpr array<DeltaTableEntry, (1 << g_DELTA_TABLE_BITS)> g_DELTA_TABLE = BuildDeltaTable ();
+
+
 //  -----------------------------------------------------------------
 //  Encoding functions
 //  -----------------------------------------------------------------
@@ -103,9 +164,31 @@ unsigned int DeltaLow_Encode (BitBuffer &bitbuffer, unsigned int value, unsigned
      \return decoded value
 */
 unsigned int Delta_Decode (BitBuffer &bitbuffer) {
-  unsigned int length = Gamma_Decode (bitbuffer) - 1;
-
-  return ((1 << length) + bitbuffer.ReadBits (length));
+  unsigned long long bits = bitbuffer.Peek (g_BITBUFFER_PEEK_MAX);
+  const DeltaTableEntry &entry = g_DELTA_TABLE[bits >> (g_BITBUFFER_PEEK_MAX - g_DELTA_TABLE_BITS)];
+  unsigned int length = 0;
+
+  //  Short codewords are looked up directly
+  if (entry.length != 0) {
+    bitbuffer.Consume (entry.length);
+    return (entry.value);
+  }
+
+  //  Otherwise, the length of the gamma code is given by the number of leading 1 bits; if
+  //  the whole codeword is in the lookahead window, decode it from there
+  unsigned int loglen = countl_one (bits << (g_ULL_SIZE_BITS - g_BITBUFFER_PEEK_MAX));
+  unsigned int gamma_length = 2 * loglen + 1;
+  if (gamma_length <= g_BITBUFFER_PEEK_MAX) {
+    length = (1u << loglen) + (static_cast<unsigned int> (bits >> (g_BITBUFFER_PEEK_MAX - gamma_length)) & ((1u << loglen) - 1)) - 1;
+    if ((length < g_UINT_SIZE_BITS) && (gamma_length + length <= g_BITBUFFER_PEEK_MAX)) {
+      bitbuffer.Consume (gamma_length + length);
+      return ((1u << length) + (static_cast<unsigned int> (bits >> (g_BITBUFFER_PEEK_MAX - gamma_length - length)) & ((1u << length) - 1)));
+    }
+  }
+
+  length = Gamma_Decode (bitbuffer) - 1;
+
+  return ((1u << length) + bitbuffer.ReadBits (length));
 }
 
 
@@ -116,9 +199,8 @@ unsigned int Delta_Decode (BitBuffer &bitbuffer) {
      \param low Lower bound on x
 */
 unsigned int DeltaLow_Decode (BitBuffer &bitbuffer, unsigned int low) {
-  unsigned int length = GammaLow_Decode (bitbuffer, 0) - 1;
-
-  return (low + (1 << length) + bitbuffer.ReadBits (length));
+  //  The codeword is the same as the delta code of (x - low); see DeltaLow_Encode ()
+  return (low + Delta_Decode (bitbuffer));
 }
 
 
@@ -32,9 +32,11 @@
 #include <fstream>
 #include <cstdlib>  //  exit
 #include <climits>
+#include <bit>  //  countl_one
 
 using namespace std;
 
+#include "common.hpp"
 #include "bitbuffer.hpp"
 #include "math_utils.hpp"
 #include "unary.hpp"
@@ -124,12 +126,23 @@ unsigned int GammaLowHigh_Encode (BitBuffer &bitbuffer, unsigned int value, unsi
      \return decoded value
 */
 unsigned int Gamma_Decode (BitBuffer &bitbuffer) {
-  unsigned int length = Unary_Decode (bitbuffer) - 1;
+  unsigned long long bits = bitbuffer.Peek (g_BITBUFFER_PEEK_MAX);
+  unsigned int length = countl_one (bits << (g_ULL_SIZE_BITS - g_BITBUFFER_PEEK_MAX));
+  unsigned int code_length = 2 * length + 1;
   unsigned int temp = 0;
   unsigned int temp2 = 0;
 
+  //  The length in unary is the number of leading 1 bits, so if the whole codeword is
+  //  in the lookahead window, it can be decoded without reading the bits one at a time
+  if (code_length <= g_BITBUFFER_PEEK_MAX) {
+    bitbuffer.Consume (code_length);
+    temp2 = static_cast<unsigned int> (bits >> (g_BITBUFFER_PEEK_MAX - code_length)) & ((1u << length) - 1);
+    return ((1u << length) + temp2);
+  }
+
+  length = Unary_Decode (bitbuffer) - 1;
   temp2 = bitbuffer.ReadBits (length);
-  temp = (1 << length) + temp2;
+  temp = (1u << length) + temp2;
 
   return (temp);
 }
@@ -31,6 +31,7 @@
 #include <fstream>
 #include <cstdlib>  //  exit
 #include <cmath>
+#include <bit>  //  bit_width
 
 using namespace std;
 
@@ -43,20 +44,12 @@ using namespace std;
      \return floor (lb (x))
 */
 unsigned int FloorLog (unsigned int value) {
-  unsigned int x = value;
-  unsigned int y = 0;
-
-  while (x != 0) {
-    x = x >> 1;
-    y++;
-  }
-
-  if (y == 0) {
+  if (value == 0) {
     cerr << "EE\tCannot calculate log2 (0) in " << __FILE__ << "::FloorLog!" << endl;
     exit (EXIT_FAILURE);
   }
 
-  return (y - 1);
+  return (bit_width (value) - 1);
 }
 
 
@@ -74,11 +67,7 @@ unsigned int CeilLog (unsigned int x) {
     exit (EXIT_FAILURE);
   }
 
-  x--;
-  while (x != 0) {
-    x >>= 1;
-    y++;
-  }
+  y = bit_width (x - 1);
 
   return (y);
 }
@@ -98,11 +87,7 @@ unsigned int CeilLogULL (unsigned long long int x) {
     exit (EXIT_FAILURE);
   }
 
-  x--;
-  while (x != 0) {
-    x >>= g_ONE_ULL;
-    y++;
-  }
+  y = bit_width (x - g_ONE_ULL);
 
   return (y);
 }
@@ -89,6 +89,7 @@ void ShowInfo () {
 */
 bool ProcessOptions (int argc, char *argv[]) {
   bool random = false;
+  bool wide = false;
   unsigned int showlengths = UINT_MAX;
   string method = "";
   unsigned int param = 5;
@@ -103,6 +104,7 @@ bool ProcessOptions (int argc, char *argv[]) {
       ("help,h", "This help message")
       ("showinfo", "Show simple information.")
       ("random", "Employ random tests.")
+      ("wide", "Employ random tests with values of every bit length (gamma and delta only).")
       ("showlengths", po::value<int>() -> default_value (UINT_MAX), "Employ tests to show bit lengths up to the value given [Default:  -1, do not run test].")
       ("method", po::value<string> (), "Method to use.  No default; choose from [unary, binary, gamma, delta, golomb, rice].")
       ("param", po::value<unsigned int> (), "Parameter for Golomb/Rice coding.")
@@ -139,6 +141,10 @@ bool ProcessOptions (int argc, char *argv[]) {
       random = true;
     }
 
+    if (vm.count ("wide")) {
+      wide = true;
+    }
+
     //  Integers
     if (vm.count ("showlengths")) {
       showlengths = vm["showlengths"].as<int>();
@@ -162,7 +168,19 @@ bool ProcessOptions (int argc, char *argv[]) {
     return false;
   }
 
-  if (random) {
+  if (wide) {
+    if (method == "gamma") {
+      result = TestGammaWide ();
+    }
+    else if (method == "delta") {
+      result = TestDeltaWide ();
+    }
+    else {
+      cerr << "==\t* Error:  Test case unknown:   wide " << method << endl;
+      return (false);
+    }
+  }
+  else if (random) {
     if (method == "unary") {
       result = TestUnaryRandom ();
     }
@@ -201,6 +201,102 @@ int TestDeltaRandom () {
 }
 
 
+/*!
+     Generate a random number with a random bit length between 1 and g_UINT_SIZE_BITS,
+     so that both short and long codewords are tested.
+
+     \return The random number, which is greater than 0
+*/
+unsigned int RandomWide () {
+  unsigned int length = (rand () % g_UINT_SIZE_BITS) + 1;
+  unsigned int num = (static_cast<unsigned int> (rand ()) << 16) ^ static_cast<unsigned int> (rand ());
+
+  if (length < g_UINT_SIZE_BITS) {
+    num &= (1u << length) - 1;
+  }
+
+  return (num | (1u << (length - 1)));
+}
+
+
+/*!
+     Apply gamma coding to a random list of g_TEST_SIZE numbers of every bit length.
+
+     \return The program exit condition
+*/
+int TestGammaWide () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> nums;
+  vector<unsigned int>::iterator iter;
+
+  //  Initialize the random seed
+  srand (time (NULL));
+
+  unsigned int i = 0;
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    unsigned int num = RandomWide ();
+    nums.push_back (num);
+    Gamma_Encode (bitbuff_out, num);
+  }
+  bitbuff_out.Finish ();
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  for (iter = nums.begin(); iter != nums.end(); iter++) {
+    unsigned int num = Gamma_Decode (bitbuff_in);
+    if (num != *iter) {
+      cerr << "EE\tError:  Mismatch in number (" << num << " : " << *iter << ")" << endl;
+      return (false);
+    }
+  }
+  bitbuff_in.Finish ();
+
+  cerr << "II\tWide gamma coding successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Apply delta coding to a random list of g_TEST_SIZE numbers of every bit length.
+
+     \return The program exit condition
+*/
+int TestDeltaWide () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> nums;
+  vector<unsigned int>::iterator iter;
+
+  //  Initialize the random seed
+  srand (time (NULL));
+
+  unsigned int i = 0;
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  for (i = 0; i < g_TEST_SIZE; i++) {
+    unsigned int num = RandomWide ();
+    nums.push_back (num);
+    Delta_Encode (bitbuff_out, num);
+  }
+  bitbuff_out.Finish ();
+
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  for (iter = nums.begin(); iter != nums.end(); iter++) {
+    unsigned int num = Delta_Decode (bitbuff_in);
+    if (num != *iter) {
+      cerr << "EE\tError:  Mismatch in number (" << num << " : " << *iter << ")" << endl;
+      return (false);
+    }
+  }
+  bitbuff_in.Finish ();
+
+  cerr << "II\tWide delta coding successful!" << endl;
+  return (true);
+}
+
+
 /*!
      Apply Golomb coding to a random list of g_TEST_SIZE numbers.
 
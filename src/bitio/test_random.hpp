@@ -40,6 +40,9 @@ int TestUnaryRandom ();
 int TestBinaryRandom ();
 int TestGammaRandom ();
 int TestDeltaRandom ();
+unsigned int RandomWide ();
+int TestGammaWide ();
+int TestDeltaWide ();
 int TestGolombRandom (unsigned int b);
 int TestRiceRandom (unsigned int k);
 
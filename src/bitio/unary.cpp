@@ -31,6 +31,7 @@
 #include <string>
 #include <fstream>
 #include <climits>
+#include <bit>  //  countl_one
 
 using namespace std;
 
@@ -62,7 +63,7 @@ unsigned int Unary_Encode (BitBuffer &bitbuffer, unsigned int value) {
     bits_written += g_UINT_SIZE_BITS;
   }
 
-  bitbuffer.WriteBits ((ALL_1_EXCEPT_LAST), x);
+  bitbuffer.WriteBits (static_cast<unsigned int> (((1ULL << x) - 1) & ALL_1_EXCEPT_LAST), x);
   bits_written += (x);
 
   return (bits_written);
@@ -99,13 +100,23 @@ unsigned int UnaryLow_Encode (BitBuffer &bitbuffer, unsigned int value, unsigned
      \return decoded value
 */
 unsigned int Unary_Decode (BitBuffer &bitbuffer) {
-  unsigned int x = 0;
+  unsigned int x = 1;
+  unsigned int ones = 0;
+
+  //  Count the 1 bits in the lookahead window at once; only a run longer than
+  //  the window needs another look
+  do {
+    ones = countl_one (bitbuffer.Peek (g_BITBUFFER_PEEK_MAX) << (g_ULL_SIZE_BITS - g_BITBUFFER_PEEK_MAX));
+    if (ones > g_BITBUFFER_PEEK_MAX) {
+      ones = g_BITBUFFER_PEEK_MAX;
+    }
+    bitbuffer.Consume (ones);
+    x += ones;
+  } while (ones == g_BITBUFFER_PEEK_MAX);
+
+  //  Skip the terminating 0 bit
+  bitbuffer.Consume (1);
 
-  while (bitbuffer.ReadBits (1) == 1) {
-    x++;
-  }
-  x++;
-  
   return (x);
 }
 
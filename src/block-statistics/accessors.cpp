@@ -99,9 +99,7 @@ unsigned int BlockStatistics::GetIDsToQScoresSize () const {
 
      \return Vector indicating remapping
 */
-vector<unsigned int> BlockStatistics::GetQScoresToIDs () {
-  vector<unsigned int> result;
-
+const vector<unsigned int> &BlockStatistics::GetQScoresToIDs () {
   //  Ensure that we've sorted already
   if (!m_IsSorted) {
     ApplySort ();
@@ -116,7 +114,7 @@ vector<unsigned int> BlockStatistics::GetQScoresToIDs () {
 
      \return Vector indicating remapping
 */
-vector<unsigned int> BlockStatistics::GetIDsToQScores () {
+const vector<unsigned int> &BlockStatistics::GetIDsToQScores () {
   return m_IDsToQScores;
 }
 
@@ -75,12 +75,14 @@ class BlockStatistics {
     unsigned int GetFrequencyTableFreq (unsigned int pos) const;
     unsigned int GetFrequencyTableID (unsigned int pos) const;
     unsigned int GetIDsToQScoresSize () const;
-    vector<unsigned int> GetQScoresToIDs ();
-    vector<unsigned int> GetIDsToQScores ();
+    const vector<unsigned int> &GetQScoresToIDs ();
+    const vector<unsigned int> &GetIDsToQScores ();
 
     //  Main processing functions  [process.cpp]
-    void UpdateFrequencyTable (vector<unsigned int> x);
-    void CopyIDsToQScores (vector<unsigned int> x);
+    void UpdateFrequencyTable (const vector<unsigned int> &x);
+    void UpdateFrequencyTable (const unsigned char *x, unsigned long long len);
+    void UpdateFrequencyTable (const vector<unsigned long long> &counts, unsigned int k);
+    void CopyIDsToQScores (const vector<unsigned int> &x);
   private:
     //  Main processing functions  [process.cpp]
     void ApplySort ();  //  Called by GetRemapping () only
@@ -97,7 +97,7 @@ bool SortByQScore (FrequencyEntry const& lhs, FrequencyEntry const& rhs) {
      
      \param[in] x The vector of integers to update the table with
 */
-void BlockStatistics::UpdateFrequencyTable (vector<unsigned int> x) {
+void BlockStatistics::UpdateFrequencyTable (const vector<unsigned int> &x) {
   for (unsigned int i = 0; i < x.size (); i++) {
     unsigned int pos = x[i];
     m_FrequencyTable[pos].freq++;
@@ -107,12 +107,47 @@ void BlockStatistics::UpdateFrequencyTable (vector<unsigned int> x) {
 }
 
 
+/*!
+     Update the frequency table using an array of values, such as all of the values of a block
+
+     \param[in] x The values to update the table with
+     \param[in] len The number of values
+*/
+void BlockStatistics::UpdateFrequencyTable (const unsigned char *x, unsigned long long len) {
+  for (unsigned long long i = 0; i < len; i++) {
+    m_FrequencyTable[x[i]].freq++;
+  }
+
+  return;
+}
+
+
+/*!
+     Update the frequency table using the number of times each value occurs, with each
+     value rescaled by k first as in QScoresBlock::ApplyRescaling ().  Values which do not
+     fit in the table are not counted.
+
+     \param[in] counts The number of times each value occurs, indexed by value
+     \param[in] k The value to subtract off; if 0, the values are not rescaled
+*/
+void BlockStatistics::UpdateFrequencyTable (const vector<unsigned long long> &counts, unsigned int k) {
+  for (unsigned int i = 0; i < counts.size (); i++) {
+    unsigned int pos = (k == 0) ? i : (i - k + 1);
+    if ((counts[i] != 0) && (i >= k) && (pos < m_FrequencyTable.size ())) {
+      m_FrequencyTable[pos].freq += static_cast<unsigned int> (counts[i]);
+    }
+  }
+
+  return;
+}
+
+
 /*!
      Copy the remapping table into the private member variable for decoding
      
      \param[in] x The remapping table
 */
-void BlockStatistics::CopyIDsToQScores (vector<unsigned int> x) {
+void BlockStatistics::CopyIDsToQScores (const vector<unsigned int> &x) {
   for (unsigned int i = 0; i <  x.size (); i++) {
     m_IDsToQScores[i] = x[i];
   }
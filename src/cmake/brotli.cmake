@@ -0,0 +1,34 @@
+###########################################################################
+##  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+##    https://github.com/rwanwork/QScores-Archiver
+##
+##  This file is part of QScores-Archiver.
+##
+##  QScores-Archiver is free software; you can redistribute it and/or
+##  modify it under the terms of the GNU Lesser General Public License
+##  as published by the Free Software Foundation; either version
+##  3 of the License, or (at your option) any later version.
+##
+##  QScores-Archiver is distributed in the hope that it will be useful,
+##  but WITHOUT ANY WARRANTY; without even the implied warranty of
+##  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+##  GNU Lesser General Public License for more details.
+##
+##  You should have received a copy of the GNU Lesser General Public
+##  License along with QScores-Archiver; if not, see
+##  <http://www.gnu.org/licenses/>.
+###########################################################################
+
+
+##  Brotli is split into an encoder and a decoder library, and both are needed.
+##  Sets BROTLI_FOUND, BROTLI_INCLUDE_DIR, BROTLI_ENCODER_LIBRARY, and BROTLI_DECODER_LIBRARY.
+find_path (BROTLI_INCLUDE_DIR brotli/encode.h)
+find_library (BROTLI_ENCODER_LIBRARY NAMES brotlienc)
+find_library (BROTLI_DECODER_LIBRARY NAMES brotlidec)
+
+if (BROTLI_INCLUDE_DIR AND BROTLI_ENCODER_LIBRARY AND BROTLI_DECODER_LIBRARY)
+  set (BROTLI_FOUND TRUE)
+  message (STATUS "Found Brotli:  ${BROTLI_ENCODER_LIBRARY}")
+else ()
+  set (BROTLI_FOUND FALSE)
+endif ()
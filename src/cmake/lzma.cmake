@@ -0,0 +1,33 @@
+###########################################################################
+##  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+##    https://github.com/rwanwork/QScores-Archiver
+##
+##  This file is part of QScores-Archiver.
+##
+##  QScores-Archiver is free software; you can redistribute it and/or
+##  modify it under the terms of the GNU Lesser General Public License
+##  as published by the Free Software Foundation; either version
+##  3 of the License, or (at your option) any later version.
+##
+##  QScores-Archiver is distributed in the hope that it will be useful,
+##  but WITHOUT ANY WARRANTY; without even the implied warranty of
+##  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+##  GNU Lesser General Public License for more details.
+##
+##  You should have received a copy of the GNU Lesser General Public
+##  License along with QScores-Archiver; if not, see
+##  <http://www.gnu.org/licenses/>.
+###########################################################################
+
+
+##  Look for liblzma directly, in the same way as zstd, so that it is detected as LZMA_FOUND.
+##  Sets LZMA_FOUND, LZMA_INCLUDE_DIR, and LZMA_LIBRARY.
+find_path (LZMA_INCLUDE_DIR lzma.h)
+find_library (LZMA_LIBRARY NAMES lzma)
+
+if (LZMA_INCLUDE_DIR AND LZMA_LIBRARY)
+  set (LZMA_FOUND TRUE)
+  message (STATUS "Found liblzma:  ${LZMA_LIBRARY}")
+else ()
+  set (LZMA_FOUND FALSE)
+endif ()
@@ -33,3 +33,18 @@ if (BZIP2_FOUND)
   endif (NOT BZIP2_NEED_PREFIX)
 endif (BZIP2_FOUND)
 
+if (ZSTD_FOUND)
+  include_directories (${ZSTD_INCLUDE_DIR})
+  target_link_libraries (${TARGET_NAME_EXEC} PRIVATE ${ZSTD_LIBRARY})
+endif (ZSTD_FOUND)
+
+if (LZMA_FOUND)
+  include_directories (${LZMA_INCLUDE_DIR})
+  target_link_libraries (${TARGET_NAME_EXEC} PRIVATE ${LZMA_LIBRARY})
+endif (LZMA_FOUND)
+
+if (BROTLI_FOUND)
+  include_directories (${BROTLI_INCLUDE_DIR})
+  target_link_libraries (${TARGET_NAME_EXEC} PRIVATE ${BROTLI_ENCODER_LIBRARY} ${BROTLI_DECODER_LIBRARY})
+endif (BROTLI_FOUND)
+
@@ -0,0 +1,33 @@
+###########################################################################
+##  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+##    https://github.com/rwanwork/QScores-Archiver
+##
+##  This file is part of QScores-Archiver.
+##
+##  QScores-Archiver is free software; you can redistribute it and/or
+##  modify it under the terms of the GNU Lesser General Public License
+##  as published by the Free Software Foundation; either version
+##  3 of the License, or (at your option) any later version.
+##
+##  QScores-Archiver is distributed in the hope that it will be useful,
+##  but WITHOUT ANY WARRANTY; without even the implied warranty of
+##  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+##  GNU Lesser General Public License for more details.
+##
+##  You should have received a copy of the GNU Lesser General Public
+##  License along with QScores-Archiver; if not, see
+##  <http://www.gnu.org/licenses/>.
+###########################################################################
+
+
+##  There is no find_package () module for zstd in older versions of CMake, so the header
+##  and library are looked for directly.  Sets ZSTD_FOUND, ZSTD_INCLUDE_DIR, and ZSTD_LIBRARY.
+find_path (ZSTD_INCLUDE_DIR zstd.h)
+find_library (ZSTD_LIBRARY NAMES zstd)
+
+if (ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+  set (ZSTD_FOUND TRUE)
+  message (STATUS "Found zstd:  ${ZSTD_LIBRARY}")
+else ()
+  set (ZSTD_FOUND FALSE)
+endif ()
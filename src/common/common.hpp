@@ -35,6 +35,14 @@ const unsigned int g_UINT_SIZE_BITS = 32;
 const unsigned int g_UINT_SIZE_BYTES = 4;
 
 
+//!  Number of bits per [un]signed long long
+const unsigned int g_ULL_SIZE_BITS = 64;
+
+
+//!  Number of bytes per [un]signed long long
+const unsigned int g_ULL_SIZE_BYTES = 8;
+
+
 //!  Number of bits per [un]signed character (byte)
 const unsigned int g_CHAR_SIZE_BITS = 8;
 
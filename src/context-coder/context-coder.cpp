@@ -0,0 +1,163 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file context-coder.cpp
+    Constructor and destructor for ContextCoder class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "context-coder.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Friends
+//  -----------------------------------------------------------------
+
+
+/*!
+     Overloaded << operator defined as a friend of ContextCoder for debugging purposes.
+
+     \param[in] os Output stream
+     \param[in] cc ContextCoder passed as reference
+     \return Output stream
+*/
+ostream &operator<< (ostream &os, const ContextCoder& cc) {
+  os << "II\tMessage length:  " << cc.m_MessageLength << endl;
+  os << "II\tAlphabet size:  " << cc.m_AlphabetSize << endl;
+  os << "II\tRead length:  " << cc.m_ReadLength << endl;
+  os << "II\tOrder:  " << cc.m_Order << endl;
+  os << "II\tContexts:  " << cc.GetContexts () << endl;
+
+  return os;
+}
+
+
+//  -----------------------------------------------------------------
+//  Constructors and destructors
+//  -----------------------------------------------------------------
+
+
+/*!
+     Default constructor that takes one optional argument.
+
+     \param[in] debug Set to true if in debug mode; false by default
+*/
+ContextCoder::ContextCoder (bool debug)
+  : m_Debug (debug),
+    m_MessageLength (0),
+    m_AlphabetSize (0),
+    m_Order (0),
+    m_ReadLength (0),
+    m_Buckets (),
+    m_Frequencies (),
+    m_Totals ()
+{
+}
+
+
+/*!
+     Destructor that takes no arguments
+*/
+ContextCoder::~ContextCoder () {
+}
+
+
+//  -----------------------------------------------------------------
+//  Accessors and mutators
+//  -----------------------------------------------------------------
+
+/*!
+     Return m_Debug
+
+     \return Debug mode or not
+*/
+bool ContextCoder::GetDebug () const {
+  return m_Debug;
+}
+
+
+/*!
+     Set m_Debug to true
+*/
+void ContextCoder::SetDebug () {
+  m_Debug = true;
+}
+
+
+/*!
+     Return the length of the message
+
+     \return Length of the message
+*/
+unsigned int ContextCoder::GetMessageLength () const {
+  return m_MessageLength;
+}
+
+
+/*!
+     Return the number of symbols in the alphabet
+
+     \return Size of the alphabet
+*/
+unsigned int ContextCoder::GetAlphabetSize () const {
+  return m_AlphabetSize;
+}
+
+
+/*!
+     Return the number of previous symbols in the context
+
+     \return 1 or 2; 0 if no message has been coded
+*/
+unsigned int ContextCoder::GetOrder () const {
+  return m_Order;
+}
+
+
+/*!
+     Return the number of contexts of the model
+
+     \return Number of contexts
+*/
+unsigned int ContextCoder::GetContexts () const {
+  return m_Totals.size ();
+}
+
+
+/*!
+     Return the length of the reads used for the contexts
+
+     \return Length of the reads
+*/
+unsigned int ContextCoder::GetReadLength () const {
+  return m_ReadLength;
+}
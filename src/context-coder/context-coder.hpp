@@ -0,0 +1,211 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file context-coder.hpp
+    Header file for ContextCoder class.
+*/
+/*******************************************************************/
+
+#ifndef CONTEXT_CODER_HPP
+#define CONTEXT_CODER_HPP
+
+
+/*!
+     Largest alphabet that can be coded; the symbols must be less than this
+*/
+const unsigned int g_CONTEXT_ALPHABET_MAX = 256;
+
+
+/*!
+     Number of ranges into which the positions of a read are quantised
+*/
+const unsigned int g_CONTEXT_POSITION_BUCKETS = 8;
+
+
+/*!
+     Largest number of frequencies in the model.  If the previous two symbols would need
+     more than this, only the previous symbol is used.
+*/
+const unsigned int g_CONTEXT_FREQUENCIES_MAX = (1U << 22);
+
+
+/*!
+     Amount added to the frequency of a symbol each time it is coded
+*/
+const unsigned int g_CONTEXT_INCREMENT = 32;
+
+
+/*!
+     Largest total frequency of a context.  When it is exceeded, the frequencies of the
+     context are halved.  It must leave the range coder at least 8 bits of precision and
+     keep every frequency within an unsigned short.
+*/
+const unsigned int g_CONTEXT_TOTAL_MAX = (1U << 15);
+
+
+/*!
+     The range of the coder is kept at or above this by moving bytes out of it
+*/
+const unsigned int g_CONTEXT_RANGE_BOTTOM = (1U << 24);
+
+
+/*!
+     Longest message that can be coded.  Its length plus one and the number of bytes are
+     written as unsigned ints; since no frequency is less than 1 in g_CONTEXT_TOTAL_MAX, a
+     symbol takes less than 2 bytes.
+*/
+const unsigned int g_CONTEXT_MESSAGE_MAX = UINT_MAX / 2;
+
+
+/*!
+    \class ContextCoder
+
+    \details Class used to represent adaptive arithmetic coding with a context model
+    built from the previous one or two symbols and the position within the read.  Each
+    context has its own frequencies, which start at 1 for every symbol and grow as the
+    symbols are coded, so nothing about them needs to be written.  Quality scores depend
+    strongly on their neighbours and fall towards the end of a read, so this costs much
+    less than coding them with the frequencies of the whole block.
+
+    The positions of a read of length l are quantised into g_CONTEXT_POSITION_BUCKETS
+    equal ranges, and the symbols before the start of a read are taken to be the symbol
+    one past the largest.  Both of the previous symbols are used unless the alphabet is
+    so large that there would be more than g_CONTEXT_FREQUENCIES_MAX frequencies; then
+    only the previous symbol is.  The reads must all be of length l, except that the last
+    one can be shorter.
+
+    The symbols are coded with a range coder that keeps a 32-bit range and moves a byte
+    out at a time, with a carry into the bytes already written (as in the LZMA range
+    coder).  Unlike RANS, the symbols are coded in order, but one symbol has to be decoded
+    before the context of the next one is known, so decoding is slower.  As with RANS,
+    the BitBuffer is not a member of this class and has to be passed around.
+
+    For encoding, do the following:
+
+    1)  Initialize the BitBuffer.
+    2)  Create a ContextCoder object.
+    3)  Encode the message using EncodeMessage ().
+
+    For decoding:
+
+    1)  Initialize the BitBuffer.
+    2)  Create a ContextCoder object.
+    3)  Decode the message using DecodeMessage (), with the same read length.
+
+    See the test driver in testing.cpp for example usage.
+*/
+class ContextCoder {
+  //  Friend function to print out statistics for debugging  [context-coder.cpp]
+  friend ostream &operator<< (ostream &os, const ContextCoder& cc);
+
+  public:
+    //  Constructors/destructors  [context-coder.cpp]
+    ContextCoder (bool debug=false);
+    ~ContextCoder ();
+    bool GetDebug () const;
+    void SetDebug ();
+    unsigned int GetMessageLength () const;
+    unsigned int GetAlphabetSize () const;
+    unsigned int GetOrder () const;
+    unsigned int GetContexts () const;
+    unsigned int GetReadLength () const;
+
+    //  Encoding functions  [encode.cpp]
+    void EncodeMessage (BitBuffer &bitbuffer, const vector<unsigned int> &x, unsigned int read_length);
+    void EncodeMessage (BitBuffer &bitbuffer, const unsigned char *x, unsigned long long len, unsigned int read_length);
+
+    //  Decoding functions  [decode.cpp]
+    vector<unsigned int> DecodeMessage (BitBuffer &bitbuffer, unsigned int read_length);
+    void DecodeMessage (BitBuffer &bitbuffer, unsigned char *x, unsigned long long len, unsigned int read_length);
+  private:
+    //  Encoding functions  [encode.cpp]
+    template <typename T>
+    void EncodeSymbols (BitBuffer &bitbuffer, const T *x, size_t len, unsigned int read_length);
+
+    //  Decoding functions  [decode.cpp]
+    template <typename T>
+    void DecodeSymbols (BitBuffer &bitbuffer, T *x, unsigned int read_length);
+
+    //  Model functions  [model.cpp]
+    void InitializeModel (unsigned int alphabet_size, unsigned int read_length);
+    void RescaleContext (unsigned int context);
+    unsigned int GetContext (unsigned int prev1, unsigned int prev2, unsigned int pos) const;
+    void UpdateContext (unsigned int context, unsigned int symbol);
+
+    //!  Debug mode?
+    bool m_Debug;
+    //!  Length of the message (i.e., number of symbols to encode/decode)
+    unsigned int m_MessageLength;
+    //!  Number of symbols in the alphabet; the symbols are from 0 to one less than this
+    unsigned int m_AlphabetSize;
+    //!  Number of previous symbols in the context (1 or 2)
+    unsigned int m_Order;
+    //!  Length of the reads; the context goes back to the start of a read after this many symbols
+    unsigned int m_ReadLength;
+
+    //!  Position range of each position of a read, up to the length of the message
+    vector<unsigned int> m_Buckets;
+    //!  Frequency of each symbol in each context, m_AlphabetSize at a time
+    vector<unsigned short> m_Frequencies;
+    //!  Total frequency of each context
+    vector<unsigned int> m_Totals;
+};
+
+
+/*!
+     Return the context of a symbol.  Defined here so that it can be inlined into the
+     encoder and decoder.
+
+     \param[in] prev1 The previous symbol, or m_AlphabetSize at the start of a read
+     \param[in] prev2 The symbol before it, or m_AlphabetSize at the start of a read
+     \param[in] pos The position of the symbol within its read
+     \return The context
+*/
+inline unsigned int ContextCoder::GetContext (unsigned int prev1, unsigned int prev2, unsigned int pos) const {
+  unsigned int context = prev1;
+  if (m_Order == 2) {
+    context += prev2 * (m_AlphabetSize + 1);
+  }
+
+  return (context * g_CONTEXT_POSITION_BUCKETS + m_Buckets[pos]);
+}
+
+
+/*!
+     Add to the frequency of a symbol in a context after it has been coded
+
+     \param[in] context The context
+     \param[in] symbol The symbol
+*/
+inline void ContextCoder::UpdateContext (unsigned int context, unsigned int symbol) {
+  m_Frequencies[context * m_AlphabetSize + symbol] += g_CONTEXT_INCREMENT;
+  m_Totals[context] += g_CONTEXT_INCREMENT;
+  if (m_Totals[context] > g_CONTEXT_TOTAL_MAX) {
+    RescaleContext (context);
+  }
+
+  return;
+}
+
+#endif
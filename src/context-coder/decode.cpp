@@ -0,0 +1,182 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file decode.cpp
+    Decoding functions for ContextCoder class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "bitio-defn.hpp"
+#include "context-coder.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+/*!
+     Decode a whole message written by EncodeMessage ().
+
+     \param[in] bitbuffer The BitBuffer to read from
+     \param[in] read_length The length of the reads, as given to EncodeMessage ()
+     \return The message
+*/
+vector<unsigned int> ContextCoder::DecodeMessage (BitBuffer &bitbuffer, unsigned int read_length) {
+  m_MessageLength = Delta_Decode (bitbuffer) - 1;
+  vector<unsigned int> result (m_MessageLength);
+  if (m_MessageLength == 0) {
+    return (result);
+  }
+
+  DecodeSymbols (bitbuffer, result.data (), read_length);
+
+  return (result);
+}
+
+
+/*!
+     Decode a whole message written by EncodeMessage () into an array of bytes, whose
+     length is already known.
+
+     \param[in] bitbuffer The BitBuffer to read from
+     \param[out] x Where to write the symbols
+     \param[in] len The number of symbols expected
+     \param[in] read_length The length of the reads, as given to EncodeMessage ()
+*/
+void ContextCoder::DecodeMessage (BitBuffer &bitbuffer, unsigned char *x, unsigned long long len, unsigned int read_length) {
+  m_MessageLength = Delta_Decode (bitbuffer) - 1;
+  if (m_MessageLength != len) {
+    cerr << "EE\tExpected " << len << " symbols, but the context coded message has " << m_MessageLength << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+  if (m_MessageLength == 0) {
+    return;
+  }
+
+  DecodeSymbols (bitbuffer, x, read_length);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Decode the symbols of a message whose length has been read, which is shared by the
+     DecodeMessage () functions.  The symbols fit in a byte, since the alphabet has at
+     most g_CONTEXT_ALPHABET_MAX symbols.
+
+     \param[in] bitbuffer The BitBuffer to read from
+     \param[out] x Where to write the m_MessageLength symbols
+     \param[in] read_length The length of the reads, as given to EncodeMessage ()
+*/
+template <typename T>
+void ContextCoder::DecodeSymbols (BitBuffer &bitbuffer, T *x, unsigned int read_length) {
+  InitializeModel (Delta_Decode (bitbuffer), read_length);
+
+  unsigned int num_bytes = Delta_Decode (bitbuffer);
+  if (num_bytes <= g_UINT_SIZE_BYTES) {
+    cerr << "EE\tThe context coded message is too short (" << num_bytes << " bytes)." << endl;
+    exit (EXIT_FAILURE);
+  }
+  vector<unsigned char> bytes (num_bytes);
+  for (unsigned int i = 0; i < num_bytes; i++) {
+    bytes[i] = static_cast<unsigned char> (bitbuffer.ReadBits (g_CHAR_SIZE_BITS));
+  }
+
+  //  The first byte is always 0 and is shifted out of the code
+  const unsigned char *ptr = bytes.data ();
+  const unsigned char *end = bytes.data () + num_bytes;
+  unsigned int code = 0;
+  unsigned int range = 0xFFFFFFFF;
+  for (unsigned int i = 0; i <= g_UINT_SIZE_BYTES; i++) {
+    code = (code << g_CHAR_SIZE_BITS) | *ptr++;
+  }
+
+  unsigned int prev1 = m_AlphabetSize;
+  unsigned int prev2 = m_AlphabetSize;
+  unsigned int pos = 0;
+  for (unsigned int i = 0; i < m_MessageLength; i++) {
+    unsigned int context = GetContext (prev1, prev2, pos);
+    const unsigned short *frequencies = &m_Frequencies[context * m_AlphabetSize];
+
+    unsigned int r = range / m_Totals[context];
+    unsigned int target = code / r;
+    if (target >= m_Totals[context]) {
+      target = m_Totals[context] - 1;
+    }
+
+    unsigned int symbol = 0;
+    unsigned int cumulative = 0;
+    while (cumulative + frequencies[symbol] <= target) {
+      cumulative += frequencies[symbol];
+      symbol++;
+    }
+    x[i] = static_cast<T> (symbol);
+
+    code -= r * cumulative;
+    range = r * frequencies[symbol];
+    while (range < g_CONTEXT_RANGE_BOTTOM) {
+      unsigned int byte = 0;
+      if (ptr < end) {
+        byte = *ptr++;
+      }
+      code = (code << g_CHAR_SIZE_BITS) | byte;
+      range <<= g_CHAR_SIZE_BITS;
+    }
+    UpdateContext (context, symbol);
+
+    prev2 = prev1;
+    prev1 = symbol;
+    pos++;
+    if (pos == m_ReadLength) {
+      prev1 = m_AlphabetSize;
+      prev2 = m_AlphabetSize;
+      pos = 0;
+    }
+  }
+
+  //  The decoder reads exactly as many bytes as the encoder wrote
+  if (ptr != end) {
+    cerr << "EE\tThe context coded message could not be decoded." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  if (m_Debug) {
+    cerr << "II\tDecoded " << m_MessageLength << " symbols from " << num_bytes << " bytes." << endl;
+  }
+
+  return;
+}
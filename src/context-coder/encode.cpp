@@ -0,0 +1,200 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file encode.cpp
+    Encoding functions for ContextCoder class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <climits>  //  UINT_MAX
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "bitio-defn.hpp"
+#include "context-coder.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Local functions
+//  -----------------------------------------------------------------
+
+/*!
+     Move the top byte of the low end of the range out of the coder.  The byte is held
+     back while it could still be changed by a carry; so is every 0xFF byte after it,
+     since a carry would pass through them.
+
+     \param[in,out] low The low end of the range, with the carry in bit 32
+     \param[in,out] cache The byte held back
+     \param[in,out] cache_size The number of bytes held back
+     \param[in,out] bytes The bytes written so far
+*/
+static void ShiftLow (unsigned long long &low, unsigned char &cache, unsigned long long &cache_size, vector<unsigned char> &bytes) {
+  if ((low < 0xFF000000ULL) || (low >= (1ULL << g_UINT_SIZE_BITS))) {
+    unsigned char carry = static_cast<unsigned char> (low >> g_UINT_SIZE_BITS);
+    unsigned char temp = cache;
+    do {
+      bytes.push_back (static_cast<unsigned char> (temp + carry));
+      temp = 0xFF;
+    } while (--cache_size != 0);
+    cache = static_cast<unsigned char> (low >> 24);
+  }
+  cache_size++;
+  low = (low & 0x00FFFFFFULL) << g_CHAR_SIZE_BITS;
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+/*!
+     Encode a whole message.  Its length and the size of its alphabet are written first,
+     followed by the number of bytes of the encoded message and the bytes themselves.  A
+     message longer than g_CONTEXT_MESSAGE_MAX exits with an error.
+
+     \param[in] bitbuffer The BitBuffer to write to
+     \param[in] x The message
+     \param[in] read_length The length of the reads; 0 if the message is a single read
+*/
+void ContextCoder::EncodeMessage (BitBuffer &bitbuffer, const vector<unsigned int> &x, unsigned int read_length) {
+  EncodeSymbols (bitbuffer, x.data (), x.size (), read_length);
+
+  return;
+}
+
+
+/*!
+     Encode a whole message of byte values, such as the quality scores of a QScoresBlock,
+     without copying it into a vector first.  The output is the same as EncodeMessage ()
+     gives for the same values in a vector.
+
+     \param[in] bitbuffer The BitBuffer to write to
+     \param[in] x The message
+     \param[in] len The number of values
+     \param[in] read_length The length of the reads; 0 if the message is a single read
+*/
+void ContextCoder::EncodeMessage (BitBuffer &bitbuffer, const unsigned char *x, unsigned long long len, unsigned int read_length) {
+  EncodeSymbols (bitbuffer, x, len, read_length);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Encode a whole message for EncodeMessage (), whatever the type of its symbols.
+
+     \param[in] bitbuffer The BitBuffer to write to
+     \param[in] x The message
+     \param[in] len The number of symbols
+     \param[in] read_length The length of the reads; 0 if the message is a single read
+*/
+template <typename T>
+void ContextCoder::EncodeSymbols (BitBuffer &bitbuffer, const T *x, size_t len, unsigned int read_length) {
+  if (len > g_CONTEXT_MESSAGE_MAX) {
+    cerr << "EE\tAt most " << g_CONTEXT_MESSAGE_MAX << " symbols can be context coded at once; found " << len << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  m_MessageLength = static_cast<unsigned int> (len);
+  Delta_Encode (bitbuffer, m_MessageLength + 1);
+  if (m_MessageLength == 0) {
+    return;
+  }
+
+  unsigned int maximum = 0;
+  for (size_t i = 0; i < len; i++) {
+    if (x[i] > maximum) {
+      maximum = x[i];
+    }
+  }
+  Delta_Encode (bitbuffer, maximum + 1);
+  InitializeModel (maximum + 1, read_length);
+
+  vector<unsigned char> bytes;
+  bytes.reserve (len / 2 + g_UINT_SIZE_BYTES + 1);
+  unsigned long long low = 0;
+  unsigned int range = 0xFFFFFFFF;
+  unsigned char cache = 0;
+  unsigned long long cache_size = 1;
+
+  unsigned int prev1 = m_AlphabetSize;
+  unsigned int prev2 = m_AlphabetSize;
+  unsigned int pos = 0;
+  for (size_t i = 0; i < len; i++) {
+    unsigned int symbol = x[i];
+    unsigned int context = GetContext (prev1, prev2, pos);
+    const unsigned short *frequencies = &m_Frequencies[context * m_AlphabetSize];
+
+    unsigned int cumulative = 0;
+    for (unsigned int j = 0; j < symbol; j++) {
+      cumulative += frequencies[j];
+    }
+
+    unsigned int r = range / m_Totals[context];
+    low += static_cast<unsigned long long> (r) * cumulative;
+    range = r * frequencies[symbol];
+    while (range < g_CONTEXT_RANGE_BOTTOM) {
+      range <<= g_CHAR_SIZE_BITS;
+      ShiftLow (low, cache, cache_size, bytes);
+    }
+    UpdateContext (context, symbol);
+
+    prev2 = prev1;
+    prev1 = symbol;
+    pos++;
+    if (pos == m_ReadLength) {
+      prev1 = m_AlphabetSize;
+      prev2 = m_AlphabetSize;
+      pos = 0;
+    }
+  }
+
+  //  Move out all of low, along with the bytes held back
+  for (unsigned int i = 0; i <= g_UINT_SIZE_BYTES; i++) {
+    ShiftLow (low, cache, cache_size, bytes);
+  }
+
+  Delta_Encode (bitbuffer, bytes.size ());
+  for (unsigned int i = 0; i < bytes.size (); i++) {
+    bitbuffer.WriteBits (bytes[i], g_CHAR_SIZE_BITS);
+  }
+
+  if (m_Debug) {
+    cerr << "II\tEncoded " << m_MessageLength << " symbols in " << bytes.size () << " bytes." << endl;
+  }
+
+  return;
+}
@@ -0,0 +1,105 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file model.cpp
+    Context model functions for ContextCoder class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "context-coder.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Set up the contexts for a message, with a frequency of 1 for every symbol in every
+     context.  The encoder and decoder must call this with the same arguments.
+
+     \param[in] alphabet_size The number of symbols in the alphabet
+     \param[in] read_length The length of the reads; 0 if the message is a single read
+*/
+void ContextCoder::InitializeModel (unsigned int alphabet_size, unsigned int read_length) {
+  if ((alphabet_size == 0) || (alphabet_size > g_CONTEXT_ALPHABET_MAX)) {
+    cerr << "EE\tContext modelling needs from 1 to " << g_CONTEXT_ALPHABET_MAX << " symbols; found " << alphabet_size << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+  m_AlphabetSize = alphabet_size;
+
+  m_ReadLength = read_length;
+  if ((m_ReadLength == 0) || (m_ReadLength > m_MessageLength)) {
+    m_ReadLength = m_MessageLength;
+  }
+
+  //  The previous symbols range from 0 to m_AlphabetSize, the last meaning the start of a read
+  unsigned long long previous = m_AlphabetSize + 1;
+  m_Order = 2;
+  if (previous * previous * g_CONTEXT_POSITION_BUCKETS * m_AlphabetSize > g_CONTEXT_FREQUENCIES_MAX) {
+    m_Order = 1;
+  }
+  unsigned int contexts = static_cast<unsigned int> (previous) * g_CONTEXT_POSITION_BUCKETS;
+  if (m_Order == 2) {
+    contexts *= static_cast<unsigned int> (previous);
+  }
+
+  m_Frequencies.assign (static_cast<unsigned long long> (contexts) * m_AlphabetSize, 1);
+  m_Totals.assign (contexts, m_AlphabetSize);
+
+  m_Buckets.resize (m_ReadLength);
+  for (unsigned int i = 0; i < m_ReadLength; i++) {
+    m_Buckets[i] = static_cast<unsigned int> ((static_cast<unsigned long long> (i) * g_CONTEXT_POSITION_BUCKETS) / m_ReadLength);
+  }
+
+  return;
+}
+
+
+/*!
+     Halve the frequencies of a context, so that it adapts to recent symbols and its total
+     stays within g_CONTEXT_TOTAL_MAX.  No frequency falls to 0.
+
+     \param[in] context The context
+*/
+void ContextCoder::RescaleContext (unsigned int context) {
+  unsigned short *frequencies = &m_Frequencies[static_cast<unsigned long long> (context) * m_AlphabetSize];
+  unsigned int total = 0;
+
+  for (unsigned int i = 0; i < m_AlphabetSize; i++) {
+    frequencies[i] = (frequencies[i] + 1) / 2;
+    total += frequencies[i];
+  }
+  m_Totals[context] = total;
+
+  return;
+}
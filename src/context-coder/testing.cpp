@@ -0,0 +1,298 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file testing.cpp
+    Testing functions of main-test.
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "ContextCoder_Config.hpp"
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "context-coder.hpp"
+#include "testing.hpp"
+
+
+/*!
+     Compare two vectors
+
+     \return true if the vectors are the same; false otherwise
+*/
+bool VectorSame (vector<unsigned int> x, vector<unsigned int> y) {
+  if (x.size () != y.size ()) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < x.size (); i++) {
+    if (x[i] != y[i]) {
+      cerr << "EE\tMismatch at position " << i << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*!
+     Encode a message to a file, decode it, and compare the two.
+
+     \param[in] tmp The message
+     \param[in] read_length The length of the reads
+     \return true if the decoded message is the same; false otherwise
+*/
+bool ContextCoderRoundTrip (vector<unsigned int> tmp, unsigned int read_length) {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> tmp2;
+
+  //  Test encoding
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  ContextCoder cc_out;
+  cc_out.SetDebug ();
+  cc_out.EncodeMessage (bitbuff_out, tmp, read_length);
+  cout << cc_out << endl;
+
+  bitbuff_out.Finish ();
+  cerr << "II\tFinished encoding..." << endl;
+
+  //  Test decoding
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  ContextCoder cc_in;
+  cc_in.SetDebug ();
+  tmp2 = cc_in.DecodeMessage (bitbuff_in, read_length);
+  cout << cc_in << endl;
+
+  bitbuff_in.Finish ();
+  cerr << "II\tFinished decoding... " << tmp2.size () << " symbols." << endl;
+
+  return (VectorSame (tmp, tmp2));
+}
+
+
+/*!
+     Show basic information about the program
+
+     \return Always returns true
+*/
+bool ShowInfo () {
+  cout << "ContextCoder version " << CONTEXTCODER_PROGRAM_VERSION << " compiled on:  " << __DATE__ <<  " (" << __TIME__ << ")" << endl;
+  cout << "Git hash:  " << CONTEXTCODER_GIT_HASH << endl;
+
+  cout << "II\tShowInfo successful!" << endl;
+
+  return (true);
+}
+
+
+/*!
+     Simple example with only one symbol in the alphabet, as a single read.
+
+     \return true if the test was successful; false otherwise
+*/
+bool ContextCoderSimple1Example () {
+  vector<unsigned int> tmp;
+
+  //  Generate test data
+  for (unsigned int i = 0; i < 11; i++) {
+    tmp.push_back (10);
+  }
+
+  if (!ContextCoderRoundTrip (tmp, 0)) {
+    cerr << "EE\tContext coding of Simple1 example unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tContext coding of Simple1 example successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Context code a set of random numbers as reads of length g_TEST_READ_LENGTH, the last
+     of which is shorter.  The alphabet is large enough that only the previous symbol is
+     used for the context.
+
+     \return true if the test was successful; false otherwise
+*/
+bool ContextCoderRandom () {
+  vector<unsigned int> tmp;
+
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data
+  for (unsigned int i = 0; i < g_TEST_SIZE * 10 + 7; i++) {
+    tmp.push_back (rand () % (g_MAX_ASCII + 1));
+  }
+
+  if (!ContextCoderRoundTrip (tmp, g_TEST_READ_LENGTH)) {
+    cerr << "EE\tContext coding of random numbers unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tContext coding of random numbers successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Context code an empty message followed by reads in which each symbol is close to the
+     previous one and falls towards the end of the read, as quality scores do.  A marker
+     is written after the messages to check that the decoder stops at the right bit, and
+     the message must take fewer bits than with a fixed-length code.
+
+     \return true if the test was successful; false otherwise
+*/
+bool ContextCoderCorrelated () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> empty;
+  vector<unsigned int> tmp;
+  vector<unsigned int> tmp2;
+  unsigned int marker = 0xA5A5A5A5;
+  const unsigned int alphabet_size = 42;
+
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data; a random walk that drifts down along each read
+  for (unsigned int i = 0; i < g_TEST_SIZE * 10; i++) {
+    int curr = alphabet_size - 1;
+    for (unsigned int j = 0; j < g_TEST_READ_LENGTH; j++) {
+      curr += (rand () % 3) - 1 - ((rand () % g_TEST_READ_LENGTH) < j ? 1 : 0);
+      if (curr < 0) {
+        curr = 0;
+      }
+      if (curr >= static_cast<int> (alphabet_size)) {
+        curr = alphabet_size - 1;
+      }
+      tmp.push_back (curr);
+    }
+  }
+
+  //  Test encoding
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  ContextCoder cc_empty_out;
+  cc_empty_out.EncodeMessage (bitbuff_out, empty, g_TEST_READ_LENGTH);
+  ContextCoder cc_out;
+  cc_out.EncodeMessage (bitbuff_out, tmp, g_TEST_READ_LENGTH);
+  bitbuff_out.WriteBits (marker, g_UINT_SIZE_BITS);
+  unsigned long long num_bits = bitbuff_out.GetPosition ();
+  bitbuff_out.Finish ();
+
+  //  Test decoding
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  ContextCoder cc_empty_in;
+  vector<unsigned int> empty2 = cc_empty_in.DecodeMessage (bitbuff_in, g_TEST_READ_LENGTH);
+  ContextCoder cc_in;
+  tmp2 = cc_in.DecodeMessage (bitbuff_in, g_TEST_READ_LENGTH);
+  unsigned int marker_in = bitbuff_in.ReadBits (g_UINT_SIZE_BITS);
+  bitbuff_in.Finish ();
+
+  if ((empty2.size () != 0) || (!VectorSame (tmp, tmp2)) || (marker_in != marker) || (cc_in.GetOrder () != 2)) {
+    cerr << "EE\tContext coding of correlated random numbers unsuccessful!" << endl;
+    return (false);
+  }
+
+  //  A fixed-length code would need 6 bits per symbol
+  cerr << "II\t" << num_bits << " bits for " << tmp.size () << " symbols." << endl;
+  if (num_bits >= tmp.size () * 6) {
+    cerr << "EE\tContext coding of correlated random numbers did not compress!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tContext coding of correlated random numbers successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Context code random reads as an array of bytes and check that the output is the same as
+     when they are given as a vector.  The last read is shorter than the others.  The
+     message is then decoded.
+
+     \return true if the test was successful; false otherwise
+*/
+bool ContextCoderBytes () {
+  vector<unsigned int> tmp;
+  vector<unsigned char> tmp_bytes;
+
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data
+  for (unsigned int i = 0; i < g_TEST_SIZE * g_TEST_READ_LENGTH + g_TEST_READ_LENGTH / 2; i++) {
+    unsigned int symbol = rand () % (g_MAX_ASCII + 1);
+    tmp.push_back (symbol);
+    tmp_bytes.push_back (static_cast<unsigned char> (symbol));
+  }
+
+  //  Test encoding
+  BitBuffer bitbuff_vector;
+  bitbuff_vector.Initialize (e_MODE_MEMORY_WRITE);
+  ContextCoder cc_vector_out;
+  cc_vector_out.EncodeMessage (bitbuff_vector, tmp, g_TEST_READ_LENGTH);
+  vector<char> bytes_vector;
+  bitbuff_vector.GetBytes (bytes_vector);
+
+  BitBuffer bitbuff_bytes;
+  bitbuff_bytes.Initialize (e_MODE_MEMORY_WRITE);
+  ContextCoder cc_bytes_out;
+  cc_bytes_out.EncodeMessage (bitbuff_bytes, tmp_bytes.data (), tmp_bytes.size (), g_TEST_READ_LENGTH);
+  vector<char> bytes;
+  bitbuff_bytes.GetBytes (bytes);
+
+  //  Test decoding
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (bytes.data (), bytes.size ());
+  ContextCoder cc_in;
+  vector<unsigned int> tmp2 = cc_in.DecodeMessage (bitbuff_in, g_TEST_READ_LENGTH);
+
+  BitBuffer bitbuff_bytes_in;
+  bitbuff_bytes_in.Initialize (bytes.data (), bytes.size ());
+  ContextCoder cc_bytes_in;
+  vector<unsigned char> tmp2_bytes (tmp_bytes.size ());
+  cc_bytes_in.DecodeMessage (bitbuff_bytes_in, tmp2_bytes.data (), tmp2_bytes.size (), g_TEST_READ_LENGTH);
+
+  if ((bytes != bytes_vector) || (!VectorSame (tmp, tmp2)) || (tmp2_bytes != tmp_bytes)) {
+    cerr << "EE\tContext coding of bytes unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tContext coding of bytes successful!" << endl;
+  return (true);
+}
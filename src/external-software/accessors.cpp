@@ -52,6 +52,36 @@ bool ExternalSoftware::GetDebug () const {
 }
 
 
+/*!
+     Get the compression level used by the libraries that have one.
+
+     \return The compression level; 0 for the library's default.
+*/
+int ExternalSoftware::GetCompressionLevel () const {
+  return (m_CompressionLevel);
+}
+
+
+/*!
+     Get whether each block is split into chunks which are compressed independently.
+
+     \return Boolean value representing the setting.
+*/
+bool ExternalSoftware::GetChunked () const {
+  return (m_Chunked);
+}
+
+
+/*!
+     Get the number of threads used for the chunks of a block.
+
+     \return Number of threads
+*/
+unsigned int ExternalSoftware::GetThreads () const {
+  return (m_Threads);
+}
+
+
 /*!
      Get the initialize setting.
 
@@ -0,0 +1,151 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file brotli.cpp
+    Main processing functions for Brotli.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <climits>
+
+using namespace std;
+
+#include "external-software-local.hpp"
+#include "external-software-exception.hpp"
+#include "external-software.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+#if BROTLI_FOUND
+/*!
+     Compress a buffer of input with the Brotli library, without copying it into m_InBuffer.
+     An encoder is made by the first buffer of a block, at the highest quality unless
+     m_CompressionLevel says otherwise, and destroyed by the last one.  If the whole block is
+     given at once, the window is made no larger than the block.  In the end, the compressed
+     data is in m_OutBuffer, occupying m_OutBufferPtr bytes.
+
+     \param[in] buffer The buffer of data to compress
+     \param[in] buffer_size Size of the buffer to process
+     \param[in] last Indicate if this is the last buffer
+*/
+void ExternalSoftware::ProcessBrotli (const char* buffer, unsigned int buffer_size, bool last) {
+  if (m_BrotliEncoder == NULL) {
+    m_BrotliEncoder = BrotliEncoderCreateInstance (NULL, NULL, NULL);
+    if (m_BrotliEncoder == NULL) {
+      cerr << "EE\tError in initializing Brotli for compression." << endl;
+      exit (EXIT_FAILURE);
+    }
+
+    //  A window of window_bits holds (1 << window_bits) - 16 bytes
+    uint32_t window_bits = BROTLI_MAX_WINDOW_BITS;
+    if (last) {
+      window_bits = BROTLI_MIN_WINDOW_BITS;
+      while ((window_bits < BROTLI_MAX_WINDOW_BITS) && (((1U << window_bits) - 16) < buffer_size)) {
+        window_bits++;
+      }
+      BrotliEncoderSetParameter (m_BrotliEncoder, BROTLI_PARAM_SIZE_HINT, buffer_size);
+    }
+    BrotliEncoderSetParameter (m_BrotliEncoder, BROTLI_PARAM_QUALITY, (m_CompressionLevel == 0) ? BROTLI_MAX_QUALITY : static_cast<uint32_t> (m_CompressionLevel));
+    BrotliEncoderSetParameter (m_BrotliEncoder, BROTLI_PARAM_LGWIN, window_bits);
+  }
+
+  ReserveOutBuffer (BrotliEncoderMaxCompressedSize (buffer_size));
+
+  size_t available_in = buffer_size;
+  const uint8_t *next_in = reinterpret_cast<const uint8_t*> (buffer);
+  BrotliEncoderOperation operation = last ? BROTLI_OPERATION_FINISH : BROTLI_OPERATION_PROCESS;
+
+  do {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (g_INIT_BUFFER_SIZE);
+    }
+    size_t available_out = (m_OutBufferSize - m_OutBufferPtr);
+    uint8_t *next_out = reinterpret_cast<uint8_t*> (&m_OutBuffer[m_OutBufferPtr]);
+
+    if (!BrotliEncoderCompressStream (m_BrotliEncoder, operation, &available_in, &next_in, &available_out, &next_out, NULL)) {
+      cerr << "EE\tBrotli compressor error." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_OutBufferPtr = (m_OutBufferSize - static_cast<unsigned int> (available_out));
+  } while ((available_in != 0) || (BrotliEncoderHasMoreOutput (m_BrotliEncoder)) || ((last) && (!BrotliEncoderIsFinished (m_BrotliEncoder))));
+
+  if (last) {
+    BrotliEncoderDestroyInstance (m_BrotliEncoder);
+    m_BrotliEncoder = NULL;
+  }
+
+  return;
+}
+
+
+/*!
+     Unprocess a buffer of input using the Brotli library.  The data is decompressed from
+     m_InBuffer straight into m_OutBuffer.  In the end, the decompressed data is in
+     m_OutBuffer, occupying m_OutBufferPtr bytes.
+*/
+void ExternalSoftware::UnProcessBrotli () {
+  BrotliDecoderState *decoder = BrotliDecoderCreateInstance (NULL, NULL, NULL);
+  if (decoder == NULL) {
+    cerr << "EE\tError in initializing Brotli for decompression." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  size_t available_in = m_InBufferPtr;
+  const uint8_t *next_in = reinterpret_cast<const uint8_t*> (m_InBuffer);
+
+  ReserveDecompressedBuffer ();
+
+  BrotliDecoderResult result = BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT;
+  while (result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (m_OutBufferSize);
+    }
+    size_t available_out = (m_OutBufferSize - m_OutBufferPtr);
+    uint8_t *next_out = reinterpret_cast<uint8_t*> (&m_OutBuffer[m_OutBufferPtr]);
+
+    result = BrotliDecoderDecompressStream (decoder, &available_in, &next_in, &available_out, &next_out, NULL);
+    m_OutBufferPtr = (m_OutBufferSize - static_cast<unsigned int> (available_out));
+  }
+
+  if (result == BROTLI_DECODER_RESULT_ERROR) {
+    cerr << "EE\tBrotli decompressor error -- " << BrotliDecoderErrorString (BrotliDecoderGetErrorCode (decoder)) << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+  if (result != BROTLI_DECODER_RESULT_SUCCESS) {
+    cerr << "EE\tBrotli decompressor error -- the data is truncated." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  BrotliDecoderDestroyInstance (decoder);
+
+  return;
+}
+#endif
@@ -85,15 +85,10 @@ void ExternalSoftware::ProcessBZlib () {
     return_value = BZ2_bzCompress (m_BZStream, BZ_FINISH);
     compressed_size = (m_OutBufferSize - m_OutBufferPtr) - (m_BZStream -> avail_out);
 
+    m_OutBufferPtr += compressed_size;
     if (m_BZStream -> avail_out == 0) {
-      m_OutBufferSize = m_OutBufferSize + g_INIT_BUFFER_SIZE;
-      if (m_OutBufferSize == UINT_MAX) {
-        cerr << "EE\tOutBuffer size exhausted while executing ExternalSoftware::ProcessBZlib ()!" << endl;
-        exit (EXIT_FAILURE);
-      }
-      m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
+      ReserveOutBuffer (g_INIT_BUFFER_SIZE);
     }
-    m_OutBufferPtr += compressed_size;
   } while (m_BZStream -> avail_out == 0);
   
   if (BZ2_bzCompressEnd (m_BZStream) != BZ_OK) {
@@ -144,15 +139,10 @@ void ExternalSoftware::UnProcessBZlib () {
     }
     decompressed_size = (m_OutBufferSize - m_OutBufferPtr) - (m_BZStream -> avail_out);
 
+    m_OutBufferPtr += decompressed_size;
     if (m_BZStream -> avail_out == 0) {
-      m_OutBufferSize = m_OutBufferSize + g_INIT_BUFFER_SIZE;
-      if (m_OutBufferSize == UINT_MAX) {
-        cerr << "EE\tOutBuffer size exhausted while executing ExternalSoftware::UnProcessBZlib ()!" << endl;
-        exit (EXIT_FAILURE);
-      }
-      m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
+      ReserveOutBuffer (g_INIT_BUFFER_SIZE);
     }
-    m_OutBufferPtr += decompressed_size;
   } while (return_value != BZ_STREAM_END);
     
   if (BZ2_bzDecompressEnd (m_BZStream) != BZ_OK) {
@@ -172,8 +162,6 @@ void ExternalSoftware::UnProcessBZlib () {
      \throw External_Software_Exception
 */
 void ExternalSoftware::ProcessBzip () {
-  unsigned int return_value = 0;
-  
   if (!GetInitializePaths ()) {
     InitializePaths ();
   }
@@ -181,42 +169,11 @@ void ExternalSoftware::ProcessBzip () {
   if (!GetBzipCommand ()) {
     throw External_Software_Exception ();
   }
-  
-  FILE* fp = fopen (g_TEMP_IN_FILENAME.c_str (), "wb");
-  if (!fp) {
-    cerr << "EE\tError in initializing bzip2 for compression." << endl;
-    exit (EXIT_FAILURE);
-  }
-  
-  return_value = fwrite (m_InBuffer, sizeof (char), m_InBufferPtr, fp);
-  if (return_value != m_InBufferPtr) {
-    cerr << "EE\tProblem writing to temporary file " << g_TEMP_IN_FILENAME << " while executing bzip2!" << endl;
-    exit (EXIT_FAILURE);
-  }
-  fclose (fp);
-  
-  string cmd = GetBzipCommandPath () + " -9 --stdout " + g_TEMP_IN_FILENAME + " >" + g_TEMP_OUT_FILENAME;
 
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
-  }
-    
-  //  Determine the size of the binary representation
-  bfs::path output_path (g_TEMP_OUT_FILENAME);
-  m_OutBufferSize = file_size (output_path);
-
-  //  Read in binary representation
-  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
-  ifstream fp_in (g_TEMP_OUT_FILENAME.c_str (), ios::in|ios::binary);
-  fp_in.read ((char*)&(m_OutBuffer[0]), sizeof (char) * m_OutBufferSize);
-  fp_in.close ();
-  m_OutBufferPtr = m_OutBufferSize;
-  
-  //  Remove temporary files
-  bfs::path input_path (g_TEMP_IN_FILENAME);
-  remove (input_path);
-  remove (output_path);
+  vector<string> args = {GetBzipCommandPath (), "-9", "--stdout"};
+
+  m_OutBufferPtr = 0;
+  RunCommand (args, m_InBuffer, m_InBufferPtr);
   
   return;
 }
@@ -229,8 +186,6 @@ void ExternalSoftware::ProcessBzip () {
      \throw External_Software_Exception
 */
 void ExternalSoftware::UnProcessBzip () {
-  unsigned int return_value = 0;
-
   if (!GetInitializePaths ()) {
     InitializePaths ();
   }
@@ -238,42 +193,11 @@ void ExternalSoftware::UnProcessBzip () {
   if (!GetBunzipCommand ()) {
     throw External_Software_Exception ();
   }
-  
-  FILE* fp = fopen (g_TEMP_IN_FILENAME.c_str (), "wb");
-  if (!fp) {
-    cerr << "EE\tError in initializing gzip for compression." << endl;
-    exit (EXIT_FAILURE);
-  }
-  
-  return_value = fwrite (m_InBuffer, sizeof (char), m_InBufferPtr, fp);
-  if (return_value != m_InBufferPtr) {
-    cerr << "EE\tProblem writing to temporary file " << g_TEMP_IN_FILENAME << " while executing gzip!" << endl;
-    exit (EXIT_FAILURE);
-  }
-  fclose (fp);
 
-  string cmd = GetBunzipCommandPath () + " --stdout " + g_TEMP_IN_FILENAME + " >" + g_TEMP_OUT_FILENAME;
+  vector<string> args = {GetBunzipCommandPath (), "--stdout"};
 
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
-  }
-    
-  //  Determine the size of the binary representation
-  bfs::path output_path (g_TEMP_OUT_FILENAME);
-  m_OutBufferSize = file_size (output_path);
-
-  //  Read in binary representation
-  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
-  ifstream fp_in (g_TEMP_OUT_FILENAME.c_str (), ios::in|ios::binary);
-  fp_in.read ((char*)&(m_OutBuffer[0]), sizeof (char) * m_OutBufferSize);
-  fp_in.close ();
-  m_OutBufferPtr = m_OutBufferSize;
-  
-  //  Remove temporary files
-  bfs::path input_path (g_TEMP_IN_FILENAME);
-  remove (input_path);
-  remove (output_path);
+  m_OutBufferPtr = 0;
+  RunCommand (args, m_InBuffer, m_InBufferPtr);
   
   return;
 }
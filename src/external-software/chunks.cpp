@@ -0,0 +1,221 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file chunks.cpp
+    Blocks split into chunks which are compressed independently by several threads, in the
+    same way as pigz and pbzip2.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>  //  memcpy
+#include <climits>  //  UINT_MAX
+#include <algorithm>  //  min, max
+#include <future>  //  async
+
+using namespace std;
+
+#include "external-software-local.hpp"
+#include "external-software-exception.hpp"
+#include "external-software.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Local functions
+//  -----------------------------------------------------------------
+
+//!  Number of bytes of each number in the chunk table
+const unsigned int g_CHUNK_TABLE_BYTES = 4;
+
+
+/*!
+     Write an unsigned integer in big-endian order.
+
+     \param[out] buffer Where to write the g_CHUNK_TABLE_BYTES bytes
+     \param[in] value The integer
+*/
+static void WriteChunkNumber (char *buffer, unsigned int value) {
+  for (unsigned int i = 0; i < g_CHUNK_TABLE_BYTES; i++) {
+    buffer[i] = static_cast<char> ((value >> (8 * (g_CHUNK_TABLE_BYTES - 1 - i))) & 0xFF);
+  }
+
+  return;
+}
+
+
+/*!
+     Read an unsigned integer written by WriteChunkNumber ().
+
+     \param[in] buffer Where to read the g_CHUNK_TABLE_BYTES bytes
+     \return The integer
+*/
+static unsigned int ReadChunkNumber (const char *buffer) {
+  unsigned int value = 0;
+
+  for (unsigned int i = 0; i < g_CHUNK_TABLE_BYTES; i++) {
+    value = (value << 8) | static_cast<unsigned char> (buffer[i]);
+  }
+
+  return (value);
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Compress a whole block as a set of chunks, each of which is compressed on its own by one of
+     m_Threads threads.  The block may be larger than an unsigned int, since only the chunks and
+     the compressed block have to fit in one.  The block is written to m_OutBuffer as the number of chunks, the
+     compressed size of each chunk, and then the chunks themselves.  Chunks lose a little
+     compression since they cannot refer to each other, less so for bzip2 whose chunks are the
+     size of its own blocks.
+
+     \param[in] buffer The block to compress
+     \param[in] buffer_size Size of the block
+*/
+void ExternalSoftware::ProcessChunks (const char* buffer, unsigned long long buffer_size) {
+  unsigned int chunk_size = (m_Method == e_EXTERNAL_METHOD_BZIP_BZLIB) ? g_CHUNK_SIZE_BZIP : g_CHUNK_SIZE_GZIP;
+  if ((buffer_size + chunk_size - 1) / chunk_size >= UINT_MAX) {
+    cerr << "EE\tA block of " << buffer_size << " bytes has too many chunks for the chunk table." << endl;
+    exit (EXIT_FAILURE);
+  }
+  unsigned int num_chunks = static_cast<unsigned int> ((buffer_size + chunk_size - 1) / chunk_size);
+  unsigned int num_threads = min (max (m_Threads, 1U), max (num_chunks, 1U));
+  vector< vector<char> > chunks (num_chunks);
+
+  //  Each thread compresses every num_threads-th chunk with its own instance
+  vector< future<void> > threads;
+  for (unsigned int t = 0; t < num_threads; t++) {
+    threads.push_back (async (launch::async, [this, t, num_threads, num_chunks, chunk_size, buffer, buffer_size, &chunks] () {
+      ExternalSoftware helper (m_Debug);
+      helper.m_SearchPaths = m_SearchPaths;
+      helper.Initialize (m_Method, true);
+      for (unsigned int i = t; i < num_chunks; i += num_threads) {
+        unsigned long long start = static_cast<unsigned long long> (i) * chunk_size;
+        helper.Process (&buffer[start], static_cast<unsigned int> (min (static_cast<unsigned long long> (chunk_size), buffer_size - start)), true);
+        chunks[i].assign (helper.GetOutBuffer (), helper.GetOutBuffer () + helper.GetOutBufferLength ());
+        helper.UnInitialize ();
+      }
+    }));
+  }
+  for (unsigned int t = 0; t < num_threads; t++) {
+    threads[t].get ();
+  }
+
+  //  Write the chunk table followed by the chunks
+  unsigned long long total = static_cast<unsigned long long> (num_chunks + 1) * g_CHUNK_TABLE_BYTES;
+  for (unsigned int i = 0; i < num_chunks; i++) {
+    total += chunks[i].size ();
+  }
+  m_OutBufferPtr = 0;
+  ReserveOutBuffer (total);
+
+  WriteChunkNumber (&m_OutBuffer[m_OutBufferPtr], num_chunks);
+  m_OutBufferPtr += g_CHUNK_TABLE_BYTES;
+  for (unsigned int i = 0; i < num_chunks; i++) {
+    WriteChunkNumber (&m_OutBuffer[m_OutBufferPtr], static_cast<unsigned int> (chunks[i].size ()));
+    m_OutBufferPtr += g_CHUNK_TABLE_BYTES;
+  }
+  for (unsigned int i = 0; i < num_chunks; i++) {
+    memcpy (&m_OutBuffer[m_OutBufferPtr], chunks[i].data (), chunks[i].size ());
+    m_OutBufferPtr += chunks[i].size ();
+  }
+
+  if (m_Debug) {
+    cerr << "DD\t" << buffer_size << " bytes compressed as " << num_chunks << " chunks by " << num_threads << " threads." << endl;
+  }
+
+  return;
+}
+
+
+/*!
+     Decompress a block written by ProcessChunks () from m_InBuffer, with the chunks shared
+     among m_Threads threads.  The chunks are joined together in m_OutBuffer.
+*/
+void ExternalSoftware::UnProcessChunks () {
+  if (m_InBufferPtr < g_CHUNK_TABLE_BYTES) {
+    cerr << "EE\tThe chunk table of a block is truncated." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  unsigned int num_chunks = ReadChunkNumber (m_InBuffer);
+  if ((m_InBufferPtr - g_CHUNK_TABLE_BYTES) / g_CHUNK_TABLE_BYTES < num_chunks) {
+    cerr << "EE\tThe chunk table of a block is truncated." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  //  Find where each chunk starts
+  vector<unsigned int> starts (num_chunks + 1);
+  unsigned long long pos = static_cast<unsigned long long> (num_chunks + 1) * g_CHUNK_TABLE_BYTES;
+  for (unsigned int i = 0; i < num_chunks; i++) {
+    starts[i] = static_cast<unsigned int> (pos);
+    pos += ReadChunkNumber (&m_InBuffer[(i + 1) * g_CHUNK_TABLE_BYTES]);
+    if (pos > m_InBufferPtr) {
+      cerr << "EE\tChunk " << i << " of a block is truncated." << endl;
+      exit (EXIT_FAILURE);
+    }
+  }
+  starts[num_chunks] = static_cast<unsigned int> (pos);
+
+  unsigned int num_threads = min (max (m_Threads, 1U), max (num_chunks, 1U));
+  vector< vector<char> > chunks (num_chunks);
+
+  //  Each thread decompresses every num_threads-th chunk with its own instance
+  vector< future<void> > threads;
+  for (unsigned int t = 0; t < num_threads; t++) {
+    threads.push_back (async (launch::async, [this, t, num_threads, num_chunks, &starts, &chunks] () {
+      ExternalSoftware helper (m_Debug);
+      helper.m_SearchPaths = m_SearchPaths;
+      helper.Initialize (m_Method, false);
+      for (unsigned int i = t; i < num_chunks; i += num_threads) {
+        helper.UnProcess (&m_InBuffer[starts[i]], starts[i + 1] - starts[i], true);
+        chunks[i].assign (helper.GetOutBuffer (), helper.GetOutBuffer () + helper.GetOutBufferLength ());
+        helper.UnInitialize ();
+      }
+    }));
+  }
+  for (unsigned int t = 0; t < num_threads; t++) {
+    threads[t].get ();
+  }
+
+  unsigned long long total = 0;
+  for (unsigned int i = 0; i < num_chunks; i++) {
+    total += chunks[i].size ();
+  }
+  m_OutBufferPtr = 0;
+  ReserveOutBuffer (total);
+  for (unsigned int i = 0; i < num_chunks; i++) {
+    memcpy (&m_OutBuffer[m_OutBufferPtr], chunks[i].data (), chunks[i].size ());
+    m_OutBufferPtr += chunks[i].size ();
+  }
+
+  return;
+}
+
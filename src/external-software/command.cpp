@@ -0,0 +1,335 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file command.cpp
+    Running external programs for gzip, bzip2, and Re-Pair.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <string.h>
+#include <cstdlib>
+#include <cstdio>  //  fopen
+#include <climits>
+#include <cerrno>  //  errno
+#include <algorithm>  //  min
+#include <mutex>
+#include <fstream>
+
+#include "ExternalSoftware_Config.hpp"
+
+#ifdef HAVE_SPAWN_H
+#include <spawn.h>  //  posix_spawn
+#include <unistd.h>  //  pipe, read, write, close
+#include <fcntl.h>  //  fcntl
+#include <poll.h>  //  poll
+#include <signal.h>  //  sigaddset, sigtimedwait
+#include <pthread.h>  //  pthread_sigmask
+#include <time.h>  //  timespec
+#include <sys/wait.h>  //  waitpid
+#endif
+
+#include "boost/filesystem.hpp"   // includes all needed Boost.Filesystem declarations
+
+using namespace std;
+namespace bfs = boost::filesystem;
+
+#include "external-software-local.hpp"
+#include "external-software-exception.hpp"
+#include "external-software.hpp"
+
+#ifdef HAVE_SPAWN_H
+extern char **environ;
+#endif
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Return this object's temporary directory, creating it with mkdtemp () the first time.
+     It is placed in $TMPDIR (or /tmp) and has a unique name, so several archivers, or
+     several threads of one archiver, never share their temporary files.
+
+     \return The path of the temporary directory
+*/
+string ExternalSoftware::GetTempDirectory () {
+  if (m_TempDirectory.empty ()) {
+    const char *tmpdir = getenv ("TMPDIR");
+    string pattern = ((tmpdir != NULL) && (tmpdir[0] != '\0')) ? tmpdir : g_PATH_TMP;
+    pattern = pattern + "/" + g_TEMP_DIRECTORY_PREFIX + "XXXXXX";
+
+    vector<char> name (pattern.begin (), pattern.end ());
+    name.push_back ('\0');
+    if (mkdtemp (name.data ()) == NULL) {
+      cerr << "EE\tUnable to create a temporary directory from " << pattern << "!" << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_TempDirectory = name.data ();
+  }
+
+  return (m_TempDirectory);
+}
+
+
+/*!
+     Remove the temporary directory, if one was created, along with anything left in it.
+*/
+void ExternalSoftware::RemoveTempDirectory () {
+  if (!m_TempDirectory.empty ()) {
+    boost::system::error_code error;
+    bfs::remove_all (bfs::path (m_TempDirectory), error);
+    m_TempDirectory = "";
+  }
+
+  return;
+}
+
+
+/*!
+     Run an external program as a filter, giving it input_size bytes of input on its standard
+     input and appending its standard output to m_OutBuffer, after m_OutBufferPtr.
+
+     If posix_spawn () is available, the program is started directly and both streams pass
+     through pipes, which are written and read in turn so that neither side blocks.  Otherwise,
+     the streams go through files in the temporary directory and the program is run with system ().
+
+     \param[in] args The path of the program, followed by its arguments
+     \param[in] input The input to the program; may be NULL if input_size is 0
+     \param[in] input_size Number of bytes of input
+     \throw External_Software_Exception
+*/
+void ExternalSoftware::RunCommand (const vector<string> &args, const char *input, unsigned int input_size) {
+#ifdef HAVE_SPAWN_H
+  //  Pipes are created and handed over one program at a time, so that a program started by
+  //  another thread never inherits the ends of this program's pipes
+  static mutex spawn_mutex;
+
+  vector<char*> argv;
+  for (unsigned int i = 0; i < args.size (); i++) {
+    argv.push_back (const_cast<char*> (args[i].c_str ()));
+  }
+  argv.push_back (NULL);
+
+  int to_child[2];
+  int from_child[2];
+  pid_t pid = 0;
+  int return_value = 0;
+  {
+    lock_guard<mutex> lock (spawn_mutex);
+
+    if (pipe (to_child) != 0) {
+      throw External_Software_Exception ();
+    }
+    if (pipe (from_child) != 0) {
+      close (to_child[0]);
+      close (to_child[1]);
+      throw External_Software_Exception ();
+    }
+    fcntl (to_child[1], F_SETFD, FD_CLOEXEC);
+    fcntl (from_child[0], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init (&actions);
+    posix_spawn_file_actions_adddup2 (&actions, to_child[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2 (&actions, from_child[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose (&actions, to_child[0]);
+    posix_spawn_file_actions_addclose (&actions, from_child[1]);
+
+    return_value = posix_spawn (&pid, argv[0], &actions, NULL, argv.data (), environ);
+
+    posix_spawn_file_actions_destroy (&actions);
+    close (to_child[0]);
+    close (from_child[1]);
+  }
+
+  if (return_value != 0) {
+    close (to_child[1]);
+    close (from_child[0]);
+    throw External_Software_Exception ();
+  }
+
+  int in_fd = to_child[1];
+  int out_fd = from_child[0];
+  unsigned int written = 0;
+  bool failed = false;
+
+  //  A program which exits without reading all of its input must not kill the archiver;
+  //  the failure is reported by its exit status instead.  SIGPIPE is blocked in this thread
+  //  only, so that the rest of the process keeps its own handling of the signal.
+  sigset_t sigpipe_set;
+  sigset_t old_set;
+  sigemptyset (&sigpipe_set);
+  sigaddset (&sigpipe_set, SIGPIPE);
+  pthread_sigmask (SIG_BLOCK, &sigpipe_set, &old_set);
+  sigset_t pending_set;
+  sigpending (&pending_set);
+  bool sigpipe_pending = (sigismember (&pending_set, SIGPIPE) == 1);
+
+  fcntl (in_fd, F_SETFL, O_NONBLOCK);
+  if (input_size == 0) {
+    close (in_fd);
+    in_fd = -1;
+  }
+
+  while (out_fd != -1) {
+    struct pollfd fds[2];
+    nfds_t num_fds = 1;
+    fds[0].fd = out_fd;
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    if (in_fd != -1) {
+      fds[1].fd = in_fd;
+      fds[1].events = POLLOUT;
+      fds[1].revents = 0;
+      num_fds = 2;
+    }
+
+    if (poll (fds, num_fds, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      failed = true;
+      break;
+    }
+
+    //  Give the program as much input as it will take
+    if ((num_fds == 2) && (fds[1].revents != 0)) {
+      ssize_t count = write (in_fd, input + written, min (input_size - written, g_INIT_BUFFER_SIZE));
+      if (count > 0) {
+        written += count;
+      }
+      else if ((count < 0) && (errno != EAGAIN) && (errno != EINTR)) {
+        failed = true;
+        written = input_size;
+      }
+
+      if (written == input_size) {
+        close (in_fd);
+        in_fd = -1;
+      }
+    }
+
+    //  Collect its output
+    if (fds[0].revents != 0) {
+      ReserveOutBuffer (g_INIT_BUFFER_SIZE);
+      ssize_t count = read (out_fd, &m_OutBuffer[m_OutBufferPtr], m_OutBufferSize - m_OutBufferPtr);
+      if (count > 0) {
+        m_OutBufferPtr += count;
+      }
+      else if ((count == 0) || ((errno != EAGAIN) && (errno != EINTR))) {
+        failed = failed || (count != 0);
+        close (out_fd);
+        out_fd = -1;
+      }
+    }
+  }
+
+  if (in_fd != -1) {
+    close (in_fd);
+  }
+  if (out_fd != -1) {
+    close (out_fd);
+  }
+
+  //  Discard a SIGPIPE raised by the writes above before unblocking it again
+  if (!sigpipe_pending) {
+    sigpending (&pending_set);
+    if (sigismember (&pending_set, SIGPIPE) == 1) {
+      struct timespec no_wait = { 0, 0 };
+      while ((sigtimedwait (&sigpipe_set, NULL, &no_wait) < 0) && (errno == EINTR)) {
+      }
+    }
+  }
+  pthread_sigmask (SIG_SETMASK, &old_set, NULL);
+
+  int status = 0;
+  while (waitpid (pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      throw External_Software_Exception ();
+    }
+  }
+
+  if ((failed) || (!WIFEXITED (status)) || (WEXITSTATUS (status) != 0)) {
+    throw External_Software_Exception ();
+  }
+#else
+  string directory = GetTempDirectory ();
+  string in_fn = directory + "/" + g_TEMP_IN_FILENAME;
+  string out_fn = directory + "/" + g_TEMP_OUT_FILENAME;
+
+  FILE* fp = fopen (in_fn.c_str (), "wb");
+  if (!fp) {
+    cerr << "EE\tError in creating temporary file " << in_fn << "!" << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  unsigned int return_value = fwrite (input, sizeof (unsigned char), input_size, fp);
+  if (return_value != input_size) {
+    cerr << "EE\tProblem writing to temporary file " << in_fn << " while executing " << args[0] << "!" << endl;
+    exit (EXIT_FAILURE);
+  }
+  fclose (fp);
+
+  //  Quote every argument for the shell
+  string cmd = "";
+  for (unsigned int i = 0; i < args.size (); i++) {
+    cmd = cmd + "'";
+    for (unsigned int j = 0; j < args[i].size (); j++) {
+      if (args[i][j] == '\'') {
+        cmd = cmd + "'\\''";
+      }
+      else {
+        cmd = cmd + args[i][j];
+      }
+    }
+    cmd = cmd + "' ";
+  }
+  cmd = cmd + "<'" + in_fn + "' >'" + out_fn + "'";
+
+  return_value = system (cmd.c_str ());
+  if (return_value != g_COMMAND_SUCCESS) {
+    throw External_Software_Exception ();
+  }
+
+  //  Append the output to m_OutBuffer
+  bfs::path output_path (out_fn);
+  unsigned int output_size = file_size (output_path);
+  ReserveOutBuffer (output_size);
+  ifstream fp_in (out_fn.c_str (), ios::in|ios::binary);
+  fp_in.read (&(m_OutBuffer[m_OutBufferPtr]), sizeof (char) * output_size);
+  fp_in.close ();
+  m_OutBufferPtr += output_size;
+
+  //  Remove temporary files
+  bfs::path input_path (in_fn);
+  remove (input_path);
+  remove (output_path);
+#endif
+
+  return;
+}
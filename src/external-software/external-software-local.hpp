@@ -33,10 +33,34 @@
 //!  Size of the buffers
 const unsigned int g_INIT_BUFFER_SIZE = 131072;
 
-//!  Temporary input file
+//!  Prefix of the temporary directory made by mkdtemp ()
+const string g_TEMP_DIRECTORY_PREFIX = "qscores-archiver-";
+
+//!  Largest dictionary trained for zstd, as used by the zstd program
+const unsigned int g_ZSTD_DICTIONARY_SIZE = 112640;
+
+//!  Most data used to train a zstd dictionary, as a multiple of g_ZSTD_DICTIONARY_SIZE
+const unsigned int g_ZSTD_TRAINING_RATIO = 100;
+
+//!  Least data needed to train a zstd dictionary, as a multiple of g_ZSTD_DICTIONARY_SIZE; with less, it costs more than it saves
+const unsigned int g_ZSTD_TRAINING_MINIMUM = 5;
+
+//!  Largest piece of a block given to Process () at once by ProcessBlock ()
+const unsigned int g_PROCESS_PIECE_SIZE = (1U << 30);
+
+//!  Uncompressed size of each gzip chunk when blocks are chunked; the same as pigz
+const unsigned int g_CHUNK_SIZE_GZIP = 131072;
+
+//!  Uncompressed size of each bzip2 chunk when blocks are chunked; the size of a block of bzip2 -9
+const unsigned int g_CHUNK_SIZE_BZIP = 900000;
+
+//!  Preset used by liblzma, which is also made "extreme"; the highest, as used by xz -9e
+const unsigned int g_LZMA_PRESET = 9;
+
+//!  Temporary input file, within the temporary directory
 const string g_TEMP_IN_FILENAME = "input.tmp";
 
-//!  Temporary output file
+//!  Temporary output file, within the temporary directory
 const string g_TEMP_OUT_FILENAME = "output.tmp";
 
 //!  Constant returned from system () indicating success
@@ -48,6 +72,9 @@ const string g_COMMAND_NOT_FOUND_STR = "N/A";
 //!  Path to main /bin directory
 const string g_PATH_BIN = "/bin";
 
+//!  Directory for temporary files if $TMPDIR is not set
+const string g_PATH_TMP = "/tmp";
+
 //!  gzip command
 const string g_COMMAND_GZIP = "gzip";
 
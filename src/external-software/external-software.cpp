@@ -49,6 +49,9 @@ ExternalSoftware::ExternalSoftware (bool debug)
   : m_Debug (debug),
     m_Compress (true),
     m_Method (e_EXTERNAL_METHOD_UNSET),
+    m_CompressionLevel (0),
+    m_Chunked (false),
+    m_Threads (1),
     m_InitializePaths (false),
     m_SearchPaths (0),
     m_GzipCommand (""),
@@ -58,12 +61,29 @@ ExternalSoftware::ExternalSoftware (bool debug)
     m_RepairCommand (""),
     m_DespairCommand (""),
     m_ShuffCommand (""),
+    m_TempDirectory (""),
 #if ZLIB_FOUND
     m_ZStream (NULL),
+    m_ZStreamActive (false),
 #endif
 #if BZIP2_FOUND
     m_BZStream (NULL),
 #endif
+#if ZSTD_FOUND
+    m_ZstdCCtx (NULL),
+    m_ZstdDCtx (NULL),
+    m_ZstdCDict (NULL),
+    m_ZstdDDict (NULL),
+    m_ZstdStreamActive (false),
+#endif
+#if LZMA_FOUND
+    m_LzmaStream (),
+    m_LzmaStreamActive (false),
+#endif
+#if BROTLI_FOUND
+    m_BrotliEncoder (NULL),
+#endif
+    m_ZstdDictionary (),
     m_InBuffer (),
     m_InBufferPtr (0),
     m_InBufferRetrieval (0),
@@ -79,6 +99,10 @@ ExternalSoftware::ExternalSoftware (bool debug)
 #if BZIP2_FOUND
   m_BZStream = (bz_stream*) (malloc (sizeof (bz_stream)));
 #endif
+#if ZSTD_FOUND
+  m_ZstdCCtx = ZSTD_createCCtx ();
+  m_ZstdDCtx = ZSTD_createDCtx ();
+#endif
 
   m_SearchPaths.push_back (g_PATH_BIN);
   
@@ -106,12 +130,31 @@ ExternalSoftware::ExternalSoftware (bool debug)
      Destructor that takes no arguments
 */
 ExternalSoftware::~ExternalSoftware () {
+  RemoveTempDirectory ();
+
 #if ZLIB_FOUND
+  if (m_ZStreamActive) {
+    (void) deflateEnd (m_ZStream);
+  }
   free (m_ZStream);
 #endif
 #if BZIP2_FOUND
   free (m_BZStream);
 #endif
+#if ZSTD_FOUND
+  ZSTD_freeCCtx (m_ZstdCCtx);
+  ZSTD_freeDCtx (m_ZstdDCtx);
+  ZSTD_freeCDict (m_ZstdCDict);
+  ZSTD_freeDDict (m_ZstdDDict);
+#endif
+#if LZMA_FOUND
+  lzma_end (&m_LzmaStream);
+#endif
+#if BROTLI_FOUND
+  if (m_BrotliEncoder != NULL) {
+    BrotliEncoderDestroyInstance (m_BrotliEncoder);
+  }
+#endif
 
   if (m_DictionaryBuffer != NULL) {
     free (m_DictionaryBuffer);
@@ -153,6 +196,24 @@ ostream &operator<< (ostream &os, const ExternalSoftware& es) {
   os << left << setw (g_VERBOSE_WIDTH) << "II\t  bzlib2:" << "Unavailable" << endl;
 #endif
 
+#if ZSTD_FOUND
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  zstd:" << "Available" << endl;
+#else
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  zstd:" << "Unavailable" << endl;
+#endif
+
+#if LZMA_FOUND
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  liblzma:" << "Available" << endl;
+#else
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  liblzma:" << "Unavailable" << endl;
+#endif
+
+#if BROTLI_FOUND
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  Brotli:" << "Available" << endl;
+#else
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  Brotli:" << "Unavailable" << endl;
+#endif
+
   os << left << setw (g_VERBOSE_WIDTH) << "II\tExternal software:" << endl;  
   os << left << setw (g_VERBOSE_WIDTH) << "II\t  gzip:" << es.GetGzipCommandPath () << endl;
   os << left << setw (g_VERBOSE_WIDTH) << "II\t  gunzip:" << es.GetGunzipCommandPath () << endl;
@@ -45,6 +45,36 @@ const bool g_USE_BZLIB = true;
 const bool g_USE_BZLIB = false;
 #endif
 
+#if ZSTD_FOUND
+#include "zstd.h"
+#include "zdict.h"
+const bool g_USE_ZSTD = true;
+#else
+const bool g_USE_ZSTD = false;
+#endif
+
+#if LZMA_FOUND
+#include "lzma.h"
+const bool g_USE_LZMA = true;
+#else
+const bool g_USE_LZMA = false;
+#endif
+
+#if BROTLI_FOUND
+#include "brotli/encode.h"
+#include "brotli/decode.h"
+const bool g_USE_BROTLI = true;
+#else
+const bool g_USE_BROTLI = false;
+#endif
+
+/*!
+     Expected ratio of the size of a block to its compressed size, for decompressors that
+     cannot tell in advance how large the output will be.  Quality scores usually compress
+     by a factor of two to four.
+*/
+const unsigned int g_EXPECTED_COMPRESSION_RATIO = 4;
+
 
 /*!
      \enum e_EXTERNAL_METHOD
@@ -55,6 +85,9 @@ enum e_EXTERNAL_METHOD {
   e_EXTERNAL_METHOD_GZIP_ZLIB,  /*!< Gzip/Zlib method */
   e_EXTERNAL_METHOD_BZIP_BZLIB,  /*!< Bzip2/BZlib method */
   e_EXTERNAL_METHOD_REPAIR,  /*!< Re-Pair method */
+  e_EXTERNAL_METHOD_ZSTD,  /*!< Zstd method */
+  e_EXTERNAL_METHOD_LZMA,  /*!< xz/LZMA method */
+  e_EXTERNAL_METHOD_BROTLI,  /*!< Brotli method */
   e_EXTERNAL_METHOD_LAST  /*!< Last external method */
 };
 
@@ -79,7 +112,8 @@ class ExternalSoftware {
     void InitializePaths ();
 
     //  Main processing functions  [process.cpp]
-    void Process (char* buffer, unsigned int buffer_size, bool last);
+    void Process (const char* buffer, unsigned int buffer_size, bool last);
+    void ProcessBlock (const char* buffer, unsigned long long buffer_size);
     void UnProcess (char* buffer, unsigned int buffer_size, bool last);
     unsigned int RetrieveUCharBlock (unsigned char* buffer, unsigned int buffer_size, bool& last);
     unsigned int RetrieveCharBlock (char* buffer, unsigned int buffer_size, bool& last);
@@ -87,9 +121,20 @@ class ExternalSoftware {
     char* RetrieveChar ();
     unsigned int GetInBufferLength () const;
     unsigned int GetOutBufferLength () const;
+    const char* GetOutBuffer () const;
+
+    //  Dictionaries for zstd  [zstd.cpp]
+    bool TrainZstdDictionary (const char *samples, const vector<size_t> &sample_sizes, const vector<size_t> &block_sizes);
+    void SetZstdDictionary (const char *dictionary, unsigned int size);
+    const char* GetZstdDictionary () const;
+    unsigned int GetZstdDictionaryLength () const;
+    unsigned long long GetZstdTrainingSize () const;
   
     //  Accessors  [accessors.cpp]
     bool GetDebug () const;
+    int GetCompressionLevel () const;
+    bool GetChunked () const;
+    unsigned int GetThreads () const;
     bool GetInitializePaths () const;
     bool GetGzipCommand () const;
     bool GetGunzipCommand () const;
@@ -109,6 +154,9 @@ class ExternalSoftware {
 
     //  Mutators  [mutators.cpp]
     bool SetDebug ();
+    void SetCompressionLevel (int level);
+    void SetChunked ();
+    void SetThreads (unsigned int threads);
     bool SetInitializePaths ();
     bool SetGzipCommand (std::string cmd);
     bool SetGunzipCommand (std::string cmd);
@@ -119,8 +167,17 @@ class ExternalSoftware {
     bool SetShuffCommand (std::string cmd);
     void AddSearchPath (std::string path);
   private:
+    //  Buffer management  [process.cpp]
+    void ReserveOutBuffer (unsigned long long size);
+    void ReserveDecompressedBuffer ();
+
+    //  Running external programs  [command.cpp]
+    std::string GetTempDirectory ();
+    void RemoveTempDirectory ();
+    void RunCommand (const vector<std::string> &args, const char *input, unsigned int input_size);
+
     //  Main zlib/gzip processing functions  [gzip-zlib.cpp]
-    void ProcessZlib ();
+    void ProcessZlib (const char* buffer, unsigned int buffer_size, bool last);
     void UnProcessZlib ();
     void ProcessGzip ();
     void UnProcessGzip ();
@@ -133,6 +190,23 @@ class ExternalSoftware {
     void ProcessBzip ();
     void UnProcessBzip ();
 
+    //  Main zstd processing functions  [zstd.cpp]
+    void ProcessZstd (const char* buffer, unsigned int buffer_size, bool last);
+    void UnProcessZstd ();
+    bool ZstdDictionarySaves (const char *dictionary, size_t dictionary_size, const char *blocks, const vector<size_t> &block_sizes) const;
+
+    //  Main xz/LZMA processing functions  [xz-lzma.cpp]
+    void ProcessLzma (const char* buffer, unsigned int buffer_size, bool last);
+    void UnProcessLzma ();
+
+    //  Main Brotli processing functions  [brotli.cpp]
+    void ProcessBrotli (const char* buffer, unsigned int buffer_size, bool last);
+    void UnProcessBrotli ();
+
+    //  Blocks split into chunks which are compressed independently  [chunks.cpp]
+    void ProcessChunks (const char* buffer, unsigned long long buffer_size);
+    void UnProcessChunks ();
+
     //  Main zlib/gzip processing functions  [repair-shuff.cpp]
     void ProcessRePair ();
     void UnProcessRePair ();
@@ -146,6 +220,15 @@ class ExternalSoftware {
     //!  The external method to used
     enum e_EXTERNAL_METHOD m_Method;
 
+    //!  Compression level for the libraries that have one; 0 for the library's default
+    int m_CompressionLevel;
+
+    //!  Is each block split into chunks, which are compressed independently?
+    bool m_Chunked;
+
+    //!  Number of threads used to compress or decompress the chunks of a block
+    unsigned int m_Threads;
+
     //!  Have we initialized the paths yet?
     bool m_InitializePaths;
 
@@ -173,9 +256,15 @@ class ExternalSoftware {
     //!  Command to run Shuff
     std::string m_ShuffCommand;
 
+    //!  Temporary directory for external programs; empty until it is needed
+    std::string m_TempDirectory;
+
 #if ZLIB_FOUND
     //  Data structure required for using zlib
     z_stream *m_ZStream;
+
+    //!  Has deflateInit () been called on m_ZStream without a matching deflateEnd ()?
+    bool m_ZStreamActive;
 #endif
 
 #if BZIP2_FOUND
@@ -183,6 +272,39 @@ class ExternalSoftware {
     bz_stream *m_BZStream;
 #endif
 
+#if ZSTD_FOUND
+    //!  Context for compressing with zstd
+    ZSTD_CCtx *m_ZstdCCtx;
+
+    //!  Context for decompressing with zstd
+    ZSTD_DCtx *m_ZstdDCtx;
+
+    //!  m_ZstdDictionary prepared for compression; NULL until it is needed
+    ZSTD_CDict *m_ZstdCDict;
+
+    //!  m_ZstdDictionary prepared for decompression; NULL until it is needed
+    ZSTD_DDict *m_ZstdDDict;
+
+    //!  Has a zstd frame been started by ProcessZstd () but not yet finished?
+    bool m_ZstdStreamActive;
+#endif
+
+#if LZMA_FOUND
+    //!  Data structure required for using liblzma, for both compressing and decompressing
+    lzma_stream m_LzmaStream;
+
+    //!  Has an xz stream been started by ProcessLzma () but not yet finished?
+    bool m_LzmaStreamActive;
+#endif
+
+#if BROTLI_FOUND
+    //!  Brotli encoder of the current block; NULL between blocks
+    BrotliEncoderState *m_BrotliEncoder;
+#endif
+
+    //!  Dictionary used by zstd for every block; empty if there is none
+    vector<char> m_ZstdDictionary;
+
     //!  Dictionary buffer
     char *m_DictionaryBuffer;
 
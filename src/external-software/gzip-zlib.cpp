@@ -55,80 +55,72 @@ namespace bfs = boost::filesystem;
 
 #if ZLIB_FOUND
 /*!
-     Process the buffer of input using the zlib library.  In the end, the compressed data is in 
-     m_OutBuffer, occupying m_OutBufferPtr bytes.
-
-     \throw External_Software_Exception
+     Compress a buffer of input with the zlib library, without copying it into m_InBuffer.
+     The deflate stream is started by the first buffer of a block and finished by the last
+     one.  Before each buffer, m_OutBuffer is enlarged to deflateBound () of everything given
+     so far, so it rarely has to be enlarged while deflating.  In the end, the compressed data
+     is in m_OutBuffer, occupying m_OutBufferPtr bytes.
+
+     \param[in] buffer The buffer of data to compress
+     \param[in] buffer_size Size of the buffer to process
+     \param[in] last Indicate if this is the last buffer
 */
-void ExternalSoftware::ProcessZlib () {
-  unsigned int compressed_size = 0;
-
-  //  Use the standard malloc/free routines
-  m_ZStream -> zalloc = Z_NULL;
-  m_ZStream -> zfree = Z_NULL;
-  m_ZStream -> opaque = Z_NULL;
-  
-  int return_value = deflateInit (m_ZStream, Z_BEST_COMPRESSION);
-  if (return_value != Z_OK) {
-    cerr << "EE\tError in initializing zlib for compression." << endl;
-    exit (EXIT_FAILURE);
+void ExternalSoftware::ProcessZlib (const char* buffer, unsigned int buffer_size, bool last) {
+  int flush = last ? Z_FINISH : Z_NO_FLUSH;
+  int return_value = Z_OK;
+
+  if (!m_ZStreamActive) {
+    //  Use the standard malloc/free routines
+    m_ZStream -> zalloc = Z_NULL;
+    m_ZStream -> zfree = Z_NULL;
+    m_ZStream -> opaque = Z_NULL;
+
+    return_value = deflateInit (m_ZStream, Z_BEST_COMPRESSION);
+    if (return_value != Z_OK) {
+      cerr << "EE\tError in initializing zlib for compression." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_ZStreamActive = true;
   }
 
-  return_value = 0;
-  
-  //  Create temporary buffers that are of type unsigned char*, as
-  //  required by the library
-  unsigned char* in_buffer = (unsigned char*) calloc (m_InBufferSize, sizeof (unsigned char));
-  unsigned char* out_buffer = (unsigned char*) calloc (m_OutBufferSize, sizeof (unsigned char));
+  unsigned long long bound = deflateBound (m_ZStream, m_ZStream -> total_in + buffer_size);
+  if (bound > m_OutBufferPtr) {
+    ReserveOutBuffer (bound - m_OutBufferPtr);
+  }
 
-  //  Copy the contents of m_InBuffer to in_buffer
-  memcpy (in_buffer, m_InBuffer, m_InBufferPtr);
-  
-  m_ZStream -> avail_in = m_InBufferPtr;
-  m_ZStream -> next_in = in_buffer;
+  m_ZStream -> avail_in = buffer_size;
+  m_ZStream -> next_in = reinterpret_cast<Bytef*> (const_cast<char*> (buffer));
 
   do {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (g_INIT_BUFFER_SIZE);
+    }
     m_ZStream -> avail_out = (m_OutBufferSize - m_OutBufferPtr);
-    m_ZStream -> next_out = &out_buffer[m_OutBufferPtr];
-    
-    return_value = deflate (m_ZStream, Z_FINISH);
-    assert (return_value != Z_STREAM_ERROR);
-    compressed_size = (m_OutBufferSize - m_OutBufferPtr) - m_ZStream -> avail_out;
+    m_ZStream -> next_out = reinterpret_cast<Bytef*> (&m_OutBuffer[m_OutBufferPtr]);
 
-    if (m_ZStream -> avail_out == 0) {
-      m_OutBufferSize = m_OutBufferSize + g_INIT_BUFFER_SIZE;
-      if (m_OutBufferSize == UINT_MAX) {
-        cerr << "EE\tOutBuffer size exhausted while executing ExternalSoftware::ProcessZlib ()!" << endl;
-        exit (EXIT_FAILURE);
-      }
-      out_buffer = (unsigned char*) realloc (out_buffer, sizeof (unsigned char) * m_OutBufferSize);
-    }
-    m_OutBufferPtr += compressed_size;
-  } while (m_ZStream -> avail_out == 0);
-  
-  (void) deflateEnd (m_ZStream);
+    return_value = deflate (m_ZStream, flush);
+    assert (return_value != Z_STREAM_ERROR);
+    m_OutBufferPtr = (m_OutBufferSize - m_ZStream -> avail_out);
+  } while ((m_ZStream -> avail_out == 0) || ((last) && (return_value != Z_STREAM_END)));
 
-  //  Copy the contents of out_buffer to m_OutBuffer to 
-  //  in_buffer, after allocating the necessary space
-  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
-  memcpy (m_OutBuffer, out_buffer, m_OutBufferPtr);
+  if (last) {
+    (void) deflateEnd (m_ZStream);
+    m_ZStreamActive = false;
+  }
 
-  free (in_buffer);
-  free (out_buffer);
-  
   return;
 }
   
 
 /*!
-     Unprocess a buffer of input using the zlib library.  In the end, the decompressed data is in 
-     m_OutBuffer, occupying m_OutBufferPtr bytes.
+     Unprocess a buffer of input using the zlib library.  The data is inflated from m_InBuffer
+     straight into m_OutBuffer, which is doubled whenever inflate () fills it, since zlib does
+     not record how large the data is.  In the end, the decompressed data is in m_OutBuffer,
+     occupying m_OutBufferPtr bytes.
 
      \throw External_Software_Exception
 */
 void ExternalSoftware::UnProcessZlib () {
-  unsigned int decompressed_size = 0;
-  
   //  Use the standard malloc/free routines
   m_ZStream -> zalloc = Z_NULL;
   m_ZStream -> zfree = Z_NULL;
@@ -141,21 +133,16 @@ void ExternalSoftware::UnProcessZlib () {
   }
 
   int return_value = 0;
-  
-  //  Create temporary buffers that are of type char*, as
-  //  required by the library
-  unsigned char* in_buffer = (unsigned char*) calloc (m_InBufferSize, sizeof (char));
-  unsigned char* out_buffer = (unsigned char*) calloc (m_OutBufferSize, sizeof (char));
-  
-  //  Copy the contents of m_InBuffer to in_buffer
-  memcpy (in_buffer, m_InBuffer, m_InBufferPtr);
-  
+
   m_ZStream -> avail_in = m_InBufferPtr;
-  m_ZStream -> next_in = in_buffer;
-  
+  m_ZStream -> next_in = reinterpret_cast<Bytef*> (m_InBuffer);
+
   do {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (m_OutBufferSize);
+    }
     m_ZStream -> avail_out = (m_OutBufferSize - m_OutBufferPtr);
-    m_ZStream -> next_out = &out_buffer[m_OutBufferPtr];
+    m_ZStream -> next_out = reinterpret_cast<Bytef*> (&m_OutBuffer[m_OutBufferPtr]);
     
     return_value = inflate (m_ZStream, Z_NO_FLUSH);
     switch (return_value) {
@@ -169,29 +156,11 @@ void ExternalSoftware::UnProcessZlib () {
         cerr << "EE\tZlib decompressor error -- Z_MEM_ERROR." << endl;
         exit (EXIT_FAILURE);
     }
-    decompressed_size = (m_OutBufferSize - m_OutBufferPtr) - m_ZStream -> avail_out;
-
-    if (m_ZStream -> avail_out == 0) {
-      m_OutBufferSize = m_OutBufferSize + g_INIT_BUFFER_SIZE;
-      if (m_OutBufferSize == UINT_MAX) {
-        cerr << "EE\tOutBuffer size exhausted while executing ExternalSoftware::UnProcessZlib ()!" << endl;
-        exit (EXIT_FAILURE);
-      }
-      out_buffer = (unsigned char*) realloc (out_buffer, sizeof (unsigned char) * m_OutBufferSize);
-    }
-    m_OutBufferPtr += decompressed_size;
+    m_OutBufferPtr = (m_OutBufferSize - m_ZStream -> avail_out);
   } while (m_ZStream -> avail_out == 0);
   
   (void) inflateEnd (m_ZStream);
 
-  //  Copy the contents of out_buffer to m_OutBuffer to 
-  //  in_buffer, after allocating the necessary space
-  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
-  memcpy (m_OutBuffer, out_buffer, m_OutBufferPtr);
-
-  free (in_buffer);
-  free (out_buffer);
-
   return;
 }
 #endif
@@ -204,8 +173,6 @@ void ExternalSoftware::UnProcessZlib () {
      \throw External_Software_Exception
 */
 void ExternalSoftware::ProcessGzip () {
-  unsigned int return_value = 0;
-
   if (!GetInitializePaths ()) {
     InitializePaths ();
   }
@@ -213,42 +180,11 @@ void ExternalSoftware::ProcessGzip () {
   if (!GetGzipCommand ()) {
     throw External_Software_Exception ();
   }
-  
-  FILE* fp = fopen (g_TEMP_IN_FILENAME.c_str (), "wb");
-  if (!fp) {
-    cerr << "EE\tError in initializing gzip for compression." << endl;
-    exit (EXIT_FAILURE);
-  }
-  
-  return_value = fwrite (m_InBuffer, sizeof (unsigned char), m_InBufferPtr, fp);
-  if (return_value != m_InBufferPtr) {
-    cerr << "EE\tProblem writing to temporary file " << g_TEMP_IN_FILENAME << " while executing gzip!" << endl;
-    exit (EXIT_FAILURE);
-  }
-  fclose (fp);
-
-  string cmd = GetGzipCommandPath () + " -9 --stdout " + g_TEMP_IN_FILENAME + " >" + g_TEMP_OUT_FILENAME;
 
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
-  }
+  vector<string> args = {GetGzipCommandPath (), "-9", "--no-name", "--stdout"};
 
-  //  Determine the size of the binary representation
-  bfs::path output_path (g_TEMP_OUT_FILENAME);
-  m_OutBufferSize = file_size (output_path);
-
-  //  Read in binary representation
-  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
-  ifstream fp_in (g_TEMP_OUT_FILENAME.c_str (), ios::in|ios::binary);
-  fp_in.read (&(m_OutBuffer[0]), sizeof (char) * m_OutBufferSize);
-  fp_in.close ();
-  m_OutBufferPtr = m_OutBufferSize;
-
-  //  Remove temporary files
-  bfs::path input_path (g_TEMP_IN_FILENAME);
-  remove (input_path);
-  remove (output_path);
+  m_OutBufferPtr = 0;
+  RunCommand (args, m_InBuffer, m_InBufferPtr);
   
   return;
 }
@@ -261,8 +197,6 @@ void ExternalSoftware::ProcessGzip () {
      \throw External_Software_Exception
 */
 void ExternalSoftware::UnProcessGzip () {
-  unsigned int return_value = 0;
-
   if (!GetInitializePaths ()) {
     InitializePaths ();
   }
@@ -270,42 +204,11 @@ void ExternalSoftware::UnProcessGzip () {
   if (!GetGunzipCommand ()) {
     throw External_Software_Exception ();
   }
-  
-  FILE* fp = fopen (g_TEMP_IN_FILENAME.c_str (), "wb");
-  if (!fp) {
-    cerr << "EE\tError in initializing gzip for decompression." << endl;
-    exit (EXIT_FAILURE);
-  }
-  
-  return_value = fwrite (m_InBuffer, sizeof (unsigned char), m_InBufferPtr, fp);
-  if (return_value != m_InBufferPtr) {
-    cerr << "EE\tProblem writing to temporary file " << g_TEMP_IN_FILENAME << " while executing gzip!" << endl;
-    exit (EXIT_FAILURE);
-  }
-  fclose (fp);
 
-  string cmd = GetGunzipCommandPath () + " --stdout " + g_TEMP_IN_FILENAME + " >" + g_TEMP_OUT_FILENAME;
+  vector<string> args = {GetGunzipCommandPath (), "--stdout"};
 
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
-  }
-    
-  //  Determine the size of the binary representation
-  bfs::path output_path (g_TEMP_OUT_FILENAME);
-  m_OutBufferSize = file_size (output_path);
-
-  //  Read in binary representation
-  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
-  ifstream fp_in (g_TEMP_OUT_FILENAME.c_str (), ios::in|ios::binary);
-  fp_in.read (&(m_OutBuffer[0]), sizeof (char) * m_OutBufferSize);
-  fp_in.close ();
-  m_OutBufferPtr = m_OutBufferSize;
-  
-  //  Remove temporary files
-  bfs::path input_path (g_TEMP_IN_FILENAME);
-  remove (input_path);
-  remove (output_path);
+  m_OutBufferPtr = 0;
+  RunCommand (args, m_InBuffer, m_InBufferPtr);
   
   return;
 }
@@ -33,6 +33,7 @@
 #include <iostream>
 #include <cstring>  //  strcmp
 #include <cstdio>  //  printf
+#include <algorithm>  //  min
 
 using namespace std;
 
@@ -64,7 +65,8 @@ int main(int argc, char **argv) {
     ExternalSoftware external_software (true);
     cout << external_software << endl;
   }
-  else if ((strcmp (argv[1], "3") == 0) || (strcmp (argv[1], "5") == 0)) {
+  else if ((strcmp (argv[1], "3") == 0) || (strcmp (argv[1], "5") == 0) || (strcmp (argv[1], "7") == 0) ||
+           (strcmp (argv[1], "10") == 0) || (strcmp (argv[1], "12") == 0)) {
     enum e_EXTERNAL_METHOD method;
     if (strcmp (argv[1], "3") == 0) {
       method = e_EXTERNAL_METHOD_GZIP_ZLIB;
@@ -72,6 +74,15 @@ int main(int argc, char **argv) {
     if (strcmp (argv[1], "5") == 0) {
       method = e_EXTERNAL_METHOD_BZIP_BZLIB;
     }
+    if (strcmp (argv[1], "7") == 0) {
+      method = e_EXTERNAL_METHOD_ZSTD;
+    }
+    if (strcmp (argv[1], "10") == 0) {
+      method = e_EXTERNAL_METHOD_LZMA;
+    }
+    if (strcmp (argv[1], "12") == 0) {
+      method = e_EXTERNAL_METHOD_BROTLI;
+    }
     
     unsigned int size = 100;
     char tmp1[32] = "zenzizenzizenzizenzizenzizenzic";
@@ -100,7 +111,8 @@ int main(int argc, char **argv) {
     free (tmp2);
     free (tmp3);
   }
-  else if ((strcmp (argv[1], "4") == 0) || (strcmp (argv[1], "6") == 0)) {
+  else if ((strcmp (argv[1], "4") == 0) || (strcmp (argv[1], "6") == 0) || (strcmp (argv[1], "8") == 0) ||
+           (strcmp (argv[1], "11") == 0) || (strcmp (argv[1], "13") == 0)) {
     enum e_EXTERNAL_METHOD method;
     if (strcmp (argv[1], "4") == 0) {
       method = e_EXTERNAL_METHOD_GZIP_ZLIB;
@@ -108,6 +120,15 @@ int main(int argc, char **argv) {
     if (strcmp (argv[1], "6") == 0) {
       method = e_EXTERNAL_METHOD_BZIP_BZLIB;
     }
+    if (strcmp (argv[1], "8") == 0) {
+      method = e_EXTERNAL_METHOD_ZSTD;
+    }
+    if (strcmp (argv[1], "11") == 0) {
+      method = e_EXTERNAL_METHOD_LZMA;
+    }
+    if (strcmp (argv[1], "13") == 0) {
+      method = e_EXTERNAL_METHOD_BROTLI;
+    }
     
     unsigned int size = 0;
     char* tmp1 = ReadFile (string (argv[2]), size);
@@ -158,6 +179,193 @@ int main(int argc, char **argv) {
     free (tmp2);
     free (tmp3);
   }
+  else if (strcmp (argv[1], "9") == 0) {
+    unsigned int size = 0;
+    char* tmp1 = GenerateQualityScores (20000, 100, size);
+
+    //  Train on every line, as it is kept for blocks of g_BLOCK_SIZE bytes, and then compress a
+    //  short piece from the middle
+    vector<size_t> sample_sizes;
+    unsigned int start = 0;
+    for (unsigned int i = 0; i < size; i++) {
+      if (tmp1[i] == '\n') {
+        sample_sizes.push_back (i + 1 - start);
+        start = i + 1;
+      }
+    }
+    vector<size_t> block_sizes;
+    for (unsigned int pos = 0; pos < size; pos += g_BLOCK_SIZE) {
+      block_sizes.push_back (min (g_BLOCK_SIZE, size - pos));
+    }
+    char* piece = &tmp1[size / 2];
+    unsigned int piece_size = min (g_BLOCK_SIZE, size - (size / 2));
+
+    ExternalSoftware external_software1 (true);
+    external_software1.Initialize (e_EXTERNAL_METHOD_ZSTD, true);
+    external_software1.SetCompressionLevel (19);
+    if (!external_software1.TrainZstdDictionary (tmp1, sample_sizes, block_sizes)) {
+      cerr << "EE\tNo dictionary was trained." << endl;
+      return (EXIT_FAILURE);
+    }
+    external_software1.Process (piece, piece_size, true);
+    unsigned int outbuffer_size = external_software1.GetOutBufferLength ();
+    char* tmp2 = (char*) calloc (outbuffer_size, sizeof (char));
+    external_software1.RetrieveCharBlock (tmp2, outbuffer_size, last);
+
+    //  Without the dictionary, for comparison
+    ExternalSoftware external_software3 (true);
+    external_software3.Initialize (e_EXTERNAL_METHOD_ZSTD, true);
+    external_software3.SetCompressionLevel (19);
+    external_software3.Process (piece, piece_size, true);
+    cout << "II\t" << piece_size << " bytes compressed to " << outbuffer_size << " bytes with a dictionary of " << external_software1.GetZstdDictionaryLength () << " bytes, and " << external_software3.GetOutBufferLength () << " bytes without." << endl;
+    if (outbuffer_size >= external_software3.GetOutBufferLength ()) {
+      cerr << "EE\tThe dictionary did not help." << endl;
+      return (EXIT_FAILURE);
+    }
+
+    ExternalSoftware external_software2 (true);
+    external_software2.Initialize (e_EXTERNAL_METHOD_ZSTD, false);
+    external_software2.SetZstdDictionary (external_software1.GetZstdDictionary (), external_software1.GetZstdDictionaryLength ());
+    external_software2.UnProcess (tmp2, outbuffer_size, true);
+    outbuffer_size = external_software2.GetOutBufferLength ();
+    char* tmp3 = (char*) calloc (outbuffer_size, sizeof (char));
+    external_software2.RetrieveCharBlock (tmp3, outbuffer_size, last);
+    if ((outbuffer_size != piece_size) || (!CompareChar (piece, tmp3, outbuffer_size))) {
+      cerr << "EE\tStrings failed to match." << endl;
+      return (EXIT_FAILURE);
+    }
+
+    free (tmp1);
+    free (tmp2);
+    free (tmp3);
+  }
+  else if (strcmp (argv[1], "16") == 0) {
+    unsigned int size = 0;
+    char* tmp1 = GenerateQualityScores (20000, 100, size);
+
+    //  Every line is a sample, and the lines are then compressed in small blocks
+    vector<size_t> sample_sizes;
+    unsigned int start = 0;
+    for (unsigned int i = 0; i < size; i++) {
+      if (tmp1[i] == '\n') {
+        sample_sizes.push_back (i + 1 - start);
+        start = i + 1;
+      }
+    }
+    unsigned int small_block = 1000;
+
+    //  The samples of a single small block are too few to train on
+    vector<size_t> first_sizes;
+    unsigned int first_total = 0;
+    for (unsigned int i = 0; (i < sample_sizes.size ()) && (first_total < small_block); i++) {
+      first_sizes.push_back (sample_sizes[i]);
+      first_total += sample_sizes[i];
+    }
+    ExternalSoftware external_software1 (true);
+    external_software1.Initialize (e_EXTERNAL_METHOD_ZSTD, true);
+    external_software1.SetCompressionLevel (3);
+    if ((external_software1.TrainZstdDictionary (tmp1, first_sizes, vector<size_t> (1, first_total))) || (external_software1.GetZstdDictionaryLength () != 0)) {
+      cerr << "EE\tA dictionary was trained on " << first_total << " bytes." << endl;
+      return (EXIT_FAILURE);
+    }
+
+    //  A dictionary is not kept if the samples are compressed as one block, since it then
+    //  saves less than its own size
+    ExternalSoftware external_software3 (true);
+    external_software3.Initialize (e_EXTERNAL_METHOD_ZSTD, true);
+    external_software3.SetCompressionLevel (3);
+    if ((external_software3.TrainZstdDictionary (tmp1, sample_sizes, vector<size_t> (1, size))) || (external_software3.GetZstdDictionaryLength () != 0)) {
+      cerr << "EE\tA dictionary was kept for a single block of " << size << " bytes." << endl;
+      return (EXIT_FAILURE);
+    }
+
+    //  Compress the small blocks with and without a dictionary trained on all of the samples,
+    //  which is kept since it pays for itself
+    vector<size_t> block_sizes;
+    for (unsigned int pos = 0; pos < size; pos += small_block) {
+      block_sizes.push_back (min (small_block, size - pos));
+    }
+    ExternalSoftware external_software2 (true);
+    external_software2.Initialize (e_EXTERNAL_METHOD_ZSTD, true);
+    external_software2.SetCompressionLevel (3);
+    if (!external_software2.TrainZstdDictionary (tmp1, sample_sizes, block_sizes)) {
+      cerr << "EE\tNo dictionary was trained." << endl;
+      return (EXIT_FAILURE);
+    }
+    unsigned long long with_dictionary = external_software2.GetZstdDictionaryLength ();
+    unsigned long long without_dictionary = 0;
+    for (unsigned int pos = 0; pos < size; pos += small_block) {
+      unsigned int piece_size = min (small_block, size - pos);
+      external_software1.Process (&tmp1[pos], piece_size, true);
+      without_dictionary += external_software1.GetOutBufferLength ();
+      external_software1.UnInitialize ();
+      external_software2.Process (&tmp1[pos], piece_size, true);
+      with_dictionary += external_software2.GetOutBufferLength ();
+      external_software2.UnInitialize ();
+    }
+    cout << "II\t" << size << " bytes in blocks of " << small_block << " bytes compressed to " << with_dictionary << " bytes with a dictionary, and " << without_dictionary << " bytes without." << endl;
+    if (with_dictionary >= without_dictionary) {
+      cerr << "EE\tThe dictionary did not make small blocks smaller." << endl;
+      return (EXIT_FAILURE);
+    }
+
+    free (tmp1);
+  }
+  else if ((strcmp (argv[1], "14") == 0) || (strcmp (argv[1], "15") == 0)) {
+    enum e_EXTERNAL_METHOD method = e_EXTERNAL_METHOD_GZIP_ZLIB;
+    if (strcmp (argv[1], "15") == 0) {
+      method = e_EXTERNAL_METHOD_BZIP_BZLIB;
+    }
+
+    unsigned int size = 0;
+    char* tmp1 = ReadFile (string (argv[2]), size);
+    if (tmp1 == NULL) {
+      return (EXIT_FAILURE);
+    }
+
+    //  Repeat the file so that there are several chunks of either size
+    unsigned int copies = 3;
+    char* block = (char*) calloc (size * copies, sizeof (char));
+    for (unsigned int i = 0; i < copies; i++) {
+      memcpy (&block[i * size], tmp1, size);
+    }
+    size = size * copies;
+
+    ExternalSoftware external_software1 (true);
+    external_software1.Initialize (method, true);
+    external_software1.SetChunked ();
+    external_software1.SetThreads (4);
+    external_software1.ProcessBlock (block, size);
+    unsigned int outbuffer_size = external_software1.GetOutBufferLength ();
+    char* tmp2 = (char*) calloc (outbuffer_size, sizeof (char));
+    external_software1.RetrieveCharBlock (tmp2, outbuffer_size, last);
+
+    //  Decompress in pieces, with a different number of threads
+    ExternalSoftware external_software2 (true);
+    external_software2.Initialize (method, false);
+    external_software2.SetChunked ();
+    external_software2.SetThreads (3);
+    unsigned int pos = 0;
+    while ((outbuffer_size - (pos * g_BLOCK_SIZE)) > g_BLOCK_SIZE) {
+      external_software2.UnProcess (&tmp2[pos * g_BLOCK_SIZE], g_BLOCK_SIZE, false);
+      pos++;
+    }
+    external_software2.UnProcess (&tmp2[pos * g_BLOCK_SIZE], (outbuffer_size - (pos * g_BLOCK_SIZE)), true);
+    cout << "II\t" << size << " bytes compressed to " << outbuffer_size << " bytes in chunks." << endl;
+
+    outbuffer_size = external_software2.GetOutBufferLength ();
+    char* tmp3 = (char*) calloc (outbuffer_size, sizeof (char));
+    external_software2.RetrieveCharBlock (tmp3, outbuffer_size, last);
+    if ((outbuffer_size != size) || (!CompareChar (block, tmp3, outbuffer_size))) {
+      cerr << "EE\tStrings failed to match." << endl;
+      return (EXIT_FAILURE);
+    }
+
+    free (tmp1);
+    free (tmp2);
+    free (tmp3);
+    free (block);
+  }
   cerr << "Hello" << endl;
   return (EXIT_SUCCESS);
 }
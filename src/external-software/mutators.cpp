@@ -56,6 +56,38 @@ bool ExternalSoftware::SetDebug () {
 }
 
 
+/*!
+     Set the compression level used by the libraries that have one.
+
+     \param[in] level The compression level; 0 for the library's default
+*/
+void ExternalSoftware::SetCompressionLevel (int level) {
+  m_CompressionLevel = level;
+  return;
+}
+
+
+/*!
+     Split each block into chunks which are compressed independently, like pigz and pbzip2.
+     The format of the compressed block changes, so the same has to be done to decompress it.
+*/
+void ExternalSoftware::SetChunked () {
+  m_Chunked = true;
+  return;
+}
+
+
+/*!
+     Set the number of threads used for the chunks of a block.
+
+     \param[in] threads Number of threads
+*/
+void ExternalSoftware::SetThreads (unsigned int threads) {
+  m_Threads = threads;
+  return;
+}
+
+
 /*!
      Indicate that we have initialized already.
 
@@ -51,24 +51,63 @@ using namespace std;
 
 /*!
      Process a buffer of input.  Add it to m_InBuffer, enlarging it if necessary.  If this is
-     the last buffer, then compress it using zlib/gzip or bzlib/bzip2.
+     the last buffer, then compress it using zlib/gzip or bzlib/bzip2.  The zlib, zstd, liblzma,
+     and Brotli libraries are instead given each buffer as it arrives, so nothing is copied into
+     m_InBuffer.  If blocks are chunked, see ProcessChunks ().
 
      \param[in] buffer The buffer of data to compress
      \param[in] buffer_size Size of the buffer to process
      \param[in] last Indicate if this is the last buffer
      \throw External_Software_Exception
 */
-void ExternalSoftware::Process (char* buffer, unsigned int buffer_size, bool last) {
+void ExternalSoftware::Process (const char* buffer, unsigned int buffer_size, bool last) {
+  //  The chunks are made from the whole block, which is only copied if it arrives in pieces
+  if ((m_Chunked) && (last) && (m_InBufferPtr == 0)) {
+    ProcessChunks (buffer, buffer_size);
+    return;
+  }
+
+#if ZLIB_FOUND
+  if ((m_Method == e_EXTERNAL_METHOD_GZIP_ZLIB) && (!m_Chunked)) {
+    ProcessZlib (buffer, buffer_size, last);
+    return;
+  }
+#endif
+#if ZSTD_FOUND
+  if (m_Method == e_EXTERNAL_METHOD_ZSTD) {
+    ProcessZstd (buffer, buffer_size, last);
+    return;
+  }
+#endif
+#if LZMA_FOUND
+  if (m_Method == e_EXTERNAL_METHOD_LZMA) {
+    ProcessLzma (buffer, buffer_size, last);
+    return;
+  }
+#endif
+#if BROTLI_FOUND
+  if (m_Method == e_EXTERNAL_METHOD_BROTLI) {
+    ProcessBrotli (buffer, buffer_size, last);
+    return;
+  }
+#endif
+
   //  Copy the data from the temporary buffer to m_InBuffer
   if (buffer_size != 0) {
     if (buffer_size > (m_InBufferSize - m_InBufferPtr)) {
-      while (buffer_size > (m_InBufferSize - m_InBufferPtr)) {
-        m_InBufferSize = m_InBufferSize + g_INIT_BUFFER_SIZE;
-        if (m_InBufferSize == UINT_MAX) {
-          cerr << "EE\tInBuffer size exhausted while executing ExternalSoftware::Process ()!" << endl;
-          exit (EXIT_FAILURE);
-        }
+      unsigned long long required = static_cast<unsigned long long> (m_InBufferPtr) + buffer_size;
+      if (required >= UINT_MAX) {
+        cerr << "EE\tInBuffer size exhausted while executing ExternalSoftware::Process ()!" << endl;
+        exit (EXIT_FAILURE);
+      }
+      unsigned long long new_size = m_InBufferSize;
+      while (new_size < required) {
+        new_size = new_size + g_INIT_BUFFER_SIZE;
       }
+      if (new_size >= UINT_MAX) {
+        new_size = required;
+      }
+      m_InBufferSize = static_cast<unsigned int> (new_size);
       m_InBuffer = (char*) realloc (m_InBuffer, sizeof (char) * m_InBufferSize);
     }
     memcpy (&m_InBuffer[m_InBufferPtr], buffer, buffer_size);
@@ -81,15 +120,15 @@ void ExternalSoftware::Process (char* buffer, unsigned int buffer_size, bool las
   }
 
   //  If this is the last block, then compress the buffer
+  if (m_Chunked) {
+    ProcessChunks (m_InBuffer, m_InBufferPtr);
+    return;
+  }
+
   try {
     switch (m_Method) {
       case e_EXTERNAL_METHOD_GZIP_ZLIB :
-        if (g_USE_ZLIB) {
-          ProcessZlib ();
-        }
-        else {
-          ProcessGzip ();
-        }
+        ProcessGzip ();
         break;
       case e_EXTERNAL_METHOD_BZIP_BZLIB :
         if (g_USE_BZLIB) {
@@ -114,6 +153,34 @@ void ExternalSoftware::Process (char* buffer, unsigned int buffer_size, bool las
 }
 
 
+/*!
+     Process a whole block, which may be larger than an unsigned int, by giving it to Process ()
+     in pieces of at most g_PROCESS_PIECE_SIZE bytes.  The libraries that are given each buffer
+     as it arrives can compress any size of block, as can ProcessChunks (); otherwise, a block
+     which does not fit in m_InBuffer exits with an error rather than being cut short.
+
+     \param[in] buffer The block to compress
+     \param[in] buffer_size Size of the block
+*/
+void ExternalSoftware::ProcessBlock (const char* buffer, unsigned long long buffer_size) {
+  unsigned long long pos = 0;
+
+  //  The chunks are made straight from the block, whatever its size
+  if (m_Chunked) {
+    ProcessChunks (buffer, buffer_size);
+    return;
+  }
+
+  while (buffer_size - pos > g_PROCESS_PIECE_SIZE) {
+    Process (&buffer[pos], g_PROCESS_PIECE_SIZE, false);
+    pos += g_PROCESS_PIECE_SIZE;
+  }
+  Process (&buffer[pos], static_cast<unsigned int> (buffer_size - pos), true);
+
+  return;
+}
+
+
 /*!
      Process a buffer of input using either gzip or the zlib library.  Arguments simply passed to the
      corresponding function.
@@ -127,13 +194,19 @@ void ExternalSoftware::UnProcess (char* buffer, unsigned int buffer_size, bool l
   //  Copy the data from the temporary buffer to m_InBuffer
   if (buffer_size != 0) {
     if (buffer_size > (m_InBufferSize - m_InBufferPtr)) {
-      while (buffer_size > (m_InBufferSize - m_InBufferPtr)) {
-        m_InBufferSize = m_InBufferSize + g_INIT_BUFFER_SIZE;
-        if (m_InBufferSize == UINT_MAX) {
-          cerr << "EE\tInBuffer size exhausted while executing ExternalSoftware::UnProcess ()!" << endl;
-          exit (EXIT_FAILURE);
-        }
+      unsigned long long required = static_cast<unsigned long long> (m_InBufferPtr) + buffer_size;
+      if (required >= UINT_MAX) {
+        cerr << "EE\tInBuffer size exhausted while executing ExternalSoftware::UnProcess ()!" << endl;
+        exit (EXIT_FAILURE);
+      }
+      unsigned long long new_size = m_InBufferSize;
+      while (new_size < required) {
+        new_size = new_size + g_INIT_BUFFER_SIZE;
+      }
+      if (new_size >= UINT_MAX) {
+        new_size = required;
       }
+      m_InBufferSize = static_cast<unsigned int> (new_size);
       m_InBuffer = (char*) realloc (m_InBuffer, sizeof (char) * m_InBufferSize);
     }
     memcpy (&m_InBuffer[m_InBufferPtr], buffer, buffer_size);
@@ -146,6 +219,11 @@ void ExternalSoftware::UnProcess (char* buffer, unsigned int buffer_size, bool l
   }
 
   //  If this is the last block, then uncompress the buffer
+  if (m_Chunked) {
+    UnProcessChunks ();
+    return;
+  }
+
   try {
     switch (m_Method) {
       case e_EXTERNAL_METHOD_GZIP_ZLIB :
@@ -164,6 +242,21 @@ void ExternalSoftware::UnProcess (char* buffer, unsigned int buffer_size, bool l
           UnProcessBzip ();
         }
         break;
+#if ZSTD_FOUND
+      case e_EXTERNAL_METHOD_ZSTD :
+        UnProcessZstd ();
+        break;
+#endif
+#if LZMA_FOUND
+      case e_EXTERNAL_METHOD_LZMA :
+        UnProcessLzma ();
+        break;
+#endif
+#if BROTLI_FOUND
+      case e_EXTERNAL_METHOD_BROTLI :
+        UnProcessBrotli ();
+        break;
+#endif
       default :
         cerr << "EE\tMethod not yet implemented!" << endl;
         exit (EXIT_FAILURE);
@@ -201,3 +294,65 @@ unsigned int ExternalSoftware::GetOutBufferLength () const {
 }
 
 
+/*!
+     Return the output buffer, whose first GetOutBufferLength () bytes are valid.  Unlike
+     RetrieveChar (), no copy is made, so the pointer is only valid until the next call to
+     Process () or UnProcess ().
+
+     \return The output buffer
+*/
+const char* ExternalSoftware::GetOutBuffer () const {
+  return m_OutBuffer;
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Make room for at least size bytes of output after m_OutBufferPtr, doubling m_OutBuffer
+     as needed so that enlarging it repeatedly costs linear time.
+
+     \param[in] size Number of bytes needed
+*/
+void ExternalSoftware::ReserveOutBuffer (unsigned long long size) {
+  unsigned long long required = static_cast<unsigned long long> (m_OutBufferPtr) + size;
+
+  if (required <= m_OutBufferSize) {
+    return;
+  }
+
+  if (required >= UINT_MAX) {
+    cerr << "EE\tOutBuffer size exhausted while executing ExternalSoftware::ReserveOutBuffer ()!" << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  unsigned long long new_size = m_OutBufferSize;
+  while (new_size < required) {
+    new_size = new_size * 2;
+  }
+  if (new_size >= UINT_MAX) {
+    new_size = required;
+  }
+
+  m_OutBufferSize = static_cast<unsigned int> (new_size);
+  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
+
+  return;
+}
+
+
+/*!
+     Make room for decompressing the m_InBufferPtr bytes of m_InBuffer, assuming that they
+     expand by g_EXPECTED_COMPRESSION_RATIO.  The guess is capped at what m_OutBuffer can
+     hold; the decompressor enlarges it further if it is too small.
+*/
+void ExternalSoftware::ReserveDecompressedBuffer () {
+  unsigned long long size = static_cast<unsigned long long> (m_InBufferPtr) * g_EXPECTED_COMPRESSION_RATIO;
+  unsigned long long available = UINT_MAX - 1ULL - m_OutBufferPtr;
+
+  ReserveOutBuffer ((size < available) ? size : available);
+
+  return;
+}
@@ -61,10 +61,9 @@ namespace bfs = boost::filesystem;
 */
 void ExternalSoftware::ProcessRePair () {
   unsigned int return_value = 0;
-  string orig_fn = g_TEMP_IN_FILENAME;
-  string seq_fn = g_TEMP_IN_FILENAME + ".seq";
-  string prel_fn = g_TEMP_IN_FILENAME + ".prel";
-  string shuff_fn = g_TEMP_IN_FILENAME + ".shuff";
+  string orig_fn = GetTempDirectory () + "/" + g_TEMP_IN_FILENAME;
+  string seq_fn = orig_fn + ".seq";
+  string prel_fn = orig_fn + ".prel";
 
   if (!GetInitializePaths ()) {
     InitializePaths ();
@@ -87,40 +86,26 @@ void ExternalSoftware::ProcessRePair () {
   }
   fclose (fp);
 
-  //  Run Re-Pair
-  string cmd = GetRepairCommandPath () + " -i " + orig_fn;
+  //  Run Re-Pair, which writes the sequence and the dictionary next to its input
+  vector<string> args = {GetRepairCommandPath (), "-i", orig_fn};
+  m_OutBufferPtr = 0;
+  RunCommand (args, NULL, 0);
 
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
-  }
-
-  //  Run Shuff
-  cmd = GetShuffCommandPath () + " -e -Z " + seq_fn + " >" + shuff_fn;
-  
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
-  }
+  //  Run Shuff, whose output is the compressed sequence
+  args = {GetShuffCommandPath (), "-e", "-Z", seq_fn};
+  m_OutBufferPtr = 0;
+  RunCommand (args, NULL, 0);
   
-  //  Determine the size of the two binary representations
+  //  Determine the size of the dictionary
   bfs::path dictionary_path (prel_fn);
   m_DictionaryBufferSize = file_size (dictionary_path);
-  bfs::path output_path (shuff_fn);
-  m_OutBufferSize = file_size (output_path);
 
-  //  Read in the two binary representations
+  //  Read in the dictionary
   m_DictionaryBuffer = (char*) realloc (m_DictionaryBuffer, sizeof (char) * m_DictionaryBufferSize);
   ifstream fp_in (prel_fn.c_str (), ios::in|ios::binary);
   fp_in.read (&(m_DictionaryBuffer[0]), sizeof (char) * m_DictionaryBufferSize);
   fp_in.close ();
   m_DictionaryBufferPtr = m_DictionaryBufferSize;
-  
-  m_OutBuffer = (char*) realloc (m_OutBuffer, sizeof (char) * m_OutBufferSize);
-  fp_in.open (shuff_fn.c_str (), ios::in|ios::binary);
-  fp_in.read (&(m_OutBuffer[0]), sizeof (char) * m_OutBufferSize);
-  fp_in.close ();
-  m_OutBufferPtr = m_OutBufferSize;
 
   //  Remove temporary files
   bfs::path input_path (orig_fn);
@@ -128,7 +113,6 @@ void ExternalSoftware::ProcessRePair () {
   remove (input_path);
   remove (seq_path);
   remove (dictionary_path);
-  remove (output_path);
   
   return;
 }
@@ -142,11 +126,11 @@ void ExternalSoftware::ProcessRePair () {
 */
 void ExternalSoftware::UnProcessRePair () {
   unsigned int return_value = 0;
-  string orig_fn = g_TEMP_IN_FILENAME;
-  string seq_fn = g_TEMP_IN_FILENAME + ".seq";
-  string prel_fn = g_TEMP_IN_FILENAME + ".prel";
-  string shuff_fn = g_TEMP_IN_FILENAME + ".shuff";
-  string uncompressed_fn = g_TEMP_IN_FILENAME + ".u";
+  string orig_fn = GetTempDirectory () + "/" + g_TEMP_IN_FILENAME;
+  string seq_fn = orig_fn + ".seq";
+  string prel_fn = orig_fn + ".prel";
+  string shuff_fn = orig_fn + ".shuff";
+  string uncompressed_fn = orig_fn + ".u";
 
   if (!GetInitializePaths ()) {
     InitializePaths ();
@@ -184,21 +168,28 @@ void ExternalSoftware::UnProcessRePair () {
   }
   fclose (fp);
 
-  //  Execute shuff
-  string cmd = GetShuffCommandPath () + " -d " + shuff_fn + " >" + seq_fn;
+  //  Execute shuff and write the sequence it decodes for Des-Pair
+  vector<string> args = {GetShuffCommandPath (), "-d", shuff_fn};
+  m_OutBufferPtr = 0;
+  RunCommand (args, NULL, 0);
 
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
+  fp = fopen (seq_fn.c_str (), "wb");
+  if (!fp) {
+    cerr << "EE\tError in initializing Des-Pair for decompression." << endl;
+    exit (EXIT_FAILURE);
   }
 
-  //  Execute Des-Pair
-  cmd = GetDespairCommandPath () + " -i " + orig_fn;
-
-  return_value = system (cmd.c_str ());
-  if (return_value != g_COMMAND_SUCCESS) {
-    throw External_Software_Exception ();
+  return_value = fwrite (m_OutBuffer, sizeof (unsigned char), m_OutBufferPtr, fp);
+  if (return_value != m_OutBufferPtr) {
+    cerr << "EE\tProblem writing to temporary file " << seq_fn << " while executing Des-Pair!" << endl;
+    exit (EXIT_FAILURE);
   }
+  fclose (fp);
+
+  //  Execute Des-Pair
+  args = {GetDespairCommandPath (), "-i", orig_fn};
+  m_OutBufferPtr = 0;
+  RunCommand (args, NULL, 0);
 
   //  Determine the size of the binary representation
   bfs::path uncompressed_path (uncompressed_fn);
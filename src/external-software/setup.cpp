@@ -60,6 +60,29 @@ void ExternalSoftware::Initialize (enum e_EXTERNAL_METHOD method, bool compress)
 
 
 void ExternalSoftware::UnInitialize () {
+#if ZLIB_FOUND
+  //  Abandon a deflate stream that was never given its last buffer
+  if (m_ZStreamActive) {
+    (void) deflateEnd (m_ZStream);
+    m_ZStreamActive = false;
+  }
+#endif
+#if ZSTD_FOUND
+  if (m_ZstdStreamActive) {
+    ZSTD_CCtx_reset (m_ZstdCCtx, ZSTD_reset_session_only);
+    m_ZstdStreamActive = false;
+  }
+#endif
+#if LZMA_FOUND
+  m_LzmaStreamActive = false;
+#endif
+#if BROTLI_FOUND
+  if (m_BrotliEncoder != NULL) {
+    BrotliEncoderDestroyInstance (m_BrotliEncoder);
+    m_BrotliEncoder = NULL;
+  }
+#endif
+
   m_DictionaryBufferPtr = 0;
   m_InBufferPtr = 0;
   m_InBufferRetrieval = 0;
@@ -36,6 +36,7 @@
 #include <cstdio>  //  fopen
 #include <climits>
 #include <fstream>
+#include <algorithm>  //  min, max
 
 #include "boost/filesystem.hpp"   // includes all needed Boost.Filesystem declarations
 
@@ -112,3 +113,32 @@ char* ReadFile (string fn, unsigned int& size) {
   return (str);
 }
 
+
+/*!
+     Generate lines of quality scores which fall along each read, with a few falling to the
+     lowest score, as in a FASTQ file.  The same lines are generated every time.
+
+     \param[in] num_reads Number of lines
+     \param[in] read_length Number of quality scores in each line
+     \param[out] size Number of bytes generated, including the newlines
+     \return The lines, which the caller frees
+*/
+char* GenerateQualityScores (unsigned int num_reads, unsigned int read_length, unsigned int& size) {
+  size = num_reads * (read_length + 1);
+  char* str = (char*) calloc (size, sizeof (char));
+
+  srand (1);
+  unsigned int pos = 0;
+  for (unsigned int i = 0; i < num_reads; i++) {
+    int score = 40 + (rand () % 3);
+    unsigned int drop = read_length / 2 + (rand () % (read_length * 2));
+    for (unsigned int j = 0; j < read_length; j++) {
+      score = score + (rand () % 3) - 1 - ((rand () % 8 == 0) ? 1 : 0);
+      score = max (min (score, 41), 2);
+      str[pos++] = static_cast<char> ('!' + ((j >= drop) ? 2 + (rand () % 3) : score));
+    }
+    str[pos++] = '\n';
+  }
+
+  return (str);
+}
@@ -36,6 +36,7 @@ const unsigned int g_BLOCK_SIZE = 1024;
 void DisplayChar (char *str, unsigned int len);
 bool CompareChar (char *x, char *y, unsigned int len);
 char* ReadFile (string fn, unsigned int& size);
+char* GenerateQualityScores (unsigned int num_reads, unsigned int read_length, unsigned int& size);
 
 
 #endif
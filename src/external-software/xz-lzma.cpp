@@ -0,0 +1,150 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file xz-lzma.cpp
+    Main processing functions for xz/liblzma.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <climits>
+
+using namespace std;
+
+#include "external-software-local.hpp"
+#include "external-software-exception.hpp"
+#include "external-software.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+#if LZMA_FOUND
+/*!
+     Compress a buffer of input with the liblzma library, without copying it into m_InBuffer.
+     Like ProcessZlib (), the .xz stream is started by the first buffer of a block and
+     finished by the last one.  The highest preset is used, unless m_CompressionLevel says
+     otherwise, but if the whole block is given at once, the dictionary is made no larger
+     than the block; a larger one would only cost memory and time.  In the end, the
+     compressed data is in m_OutBuffer, occupying m_OutBufferPtr bytes.
+
+     \param[in] buffer The buffer of data to compress
+     \param[in] buffer_size Size of the buffer to process
+     \param[in] last Indicate if this is the last buffer
+*/
+void ExternalSoftware::ProcessLzma (const char* buffer, unsigned int buffer_size, bool last) {
+  lzma_ret return_value = LZMA_OK;
+
+  if (!m_LzmaStreamActive) {
+    uint32_t preset = (m_CompressionLevel == 0) ? (g_LZMA_PRESET | LZMA_PRESET_EXTREME) : static_cast<uint32_t> (m_CompressionLevel);
+    lzma_options_lzma options;
+    if (lzma_lzma_preset (&options, preset)) {
+      cerr << "EE\tError in initializing liblzma for compression -- unsupported preset " << preset << "." << endl;
+      exit (EXIT_FAILURE);
+    }
+    if ((last) && (options.dict_size > buffer_size)) {
+      options.dict_size = (buffer_size < LZMA_DICT_SIZE_MIN) ? LZMA_DICT_SIZE_MIN : buffer_size;
+    }
+
+    lzma_filter filters[] = {
+      { LZMA_FILTER_LZMA2, &options },
+      { LZMA_VLI_UNKNOWN, NULL }
+    };
+    return_value = lzma_stream_encoder (&m_LzmaStream, filters, LZMA_CHECK_CRC32);
+    if (return_value != LZMA_OK) {
+      cerr << "EE\tError in initializing liblzma for compression." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_LzmaStreamActive = true;
+  }
+
+  ReserveOutBuffer (lzma_stream_buffer_bound (buffer_size));
+
+  m_LzmaStream.next_in = reinterpret_cast<const uint8_t*> (buffer);
+  m_LzmaStream.avail_in = buffer_size;
+  lzma_action action = last ? LZMA_FINISH : LZMA_RUN;
+
+  do {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (g_INIT_BUFFER_SIZE);
+    }
+    m_LzmaStream.next_out = reinterpret_cast<uint8_t*> (&m_OutBuffer[m_OutBufferPtr]);
+    m_LzmaStream.avail_out = (m_OutBufferSize - m_OutBufferPtr);
+
+    return_value = lzma_code (&m_LzmaStream, action);
+    if ((return_value != LZMA_OK) && (return_value != LZMA_STREAM_END)) {
+      cerr << "EE\tliblzma compressor error -- " << return_value << "." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_OutBufferPtr = (m_OutBufferSize - static_cast<unsigned int> (m_LzmaStream.avail_out));
+  } while ((m_LzmaStream.avail_in != 0) || ((last) && (return_value != LZMA_STREAM_END)));
+
+  if (last) {
+    m_LzmaStreamActive = false;
+  }
+
+  return;
+}
+
+
+/*!
+     Unprocess a buffer of input using the liblzma library.  The data is decompressed from
+     m_InBuffer straight into m_OutBuffer.  In the end, the decompressed data is in
+     m_OutBuffer, occupying m_OutBufferPtr bytes.
+*/
+void ExternalSoftware::UnProcessLzma () {
+  lzma_ret return_value = lzma_stream_decoder (&m_LzmaStream, UINT64_MAX, 0);
+  if (return_value != LZMA_OK) {
+    cerr << "EE\tError in initializing liblzma for decompression." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  m_LzmaStream.next_in = reinterpret_cast<const uint8_t*> (m_InBuffer);
+  m_LzmaStream.avail_in = m_InBufferPtr;
+
+  ReserveDecompressedBuffer ();
+
+  do {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (m_OutBufferSize);
+    }
+    m_LzmaStream.next_out = reinterpret_cast<uint8_t*> (&m_OutBuffer[m_OutBufferPtr]);
+    m_LzmaStream.avail_out = (m_OutBufferSize - m_OutBufferPtr);
+
+    return_value = lzma_code (&m_LzmaStream, LZMA_FINISH);
+    m_OutBufferPtr = (m_OutBufferSize - static_cast<unsigned int> (m_LzmaStream.avail_out));
+  } while ((return_value == LZMA_OK) || ((return_value == LZMA_BUF_ERROR) && (m_LzmaStream.avail_out == 0)));
+
+  if (return_value != LZMA_STREAM_END) {
+    cerr << "EE\tliblzma decompressor error -- " << return_value << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  return;
+}
+#endif
@@ -0,0 +1,302 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file zstd.cpp
+    Main processing functions for zstd.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <climits>
+
+using namespace std;
+
+#include "external-software-local.hpp"
+#include "external-software-exception.hpp"
+#include "external-software.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+/*!
+     Train a zstd dictionary on a set of samples and use it for every block from now on.  Only
+     the first samples, up to about GetZstdTrainingSize () bytes, are used, since more rarely
+     improves it.  No dictionary is trained from less than g_ZSTD_TRAINING_MINIMUM times the
+     size of the dictionary, since a dictionary trained on so little costs more than it saves.
+     Training also fails if there are too few samples.  The dictionary is then only kept if it
+     pays for itself on the blocks that the samples came from; see ZstdDictionarySaves ().
+
+     \param[in] samples The samples, one after another
+     \param[in] sample_sizes The size of each sample
+     \param[in] block_sizes The size of each block that the samples make up, in order
+     \return true if a dictionary was trained and kept; false otherwise
+*/
+bool ExternalSoftware::TrainZstdDictionary (const char *samples, const vector<size_t> &sample_sizes, const vector<size_t> &block_sizes) {
+#if ZSTD_FOUND
+  unsigned long long total = 0;
+  unsigned int num_samples = 0;
+  while ((num_samples < sample_sizes.size ()) && (total < GetZstdTrainingSize ())) {
+    total += sample_sizes[num_samples];
+    num_samples++;
+  }
+  if (total < static_cast<unsigned long long> (g_ZSTD_DICTIONARY_SIZE) * g_ZSTD_TRAINING_MINIMUM) {
+    if (GetDebug ()) {
+      cerr << "DD\tNo zstd dictionary trained -- only " << total << " bytes of samples." << endl;
+    }
+    return (false);
+  }
+
+  vector<char> dictionary (g_ZSTD_DICTIONARY_SIZE);
+  size_t size = ZDICT_trainFromBuffer (dictionary.data (), dictionary.size (), samples, sample_sizes.data (), num_samples);
+  if (ZDICT_isError (size)) {
+    if (GetDebug ()) {
+      cerr << "DD\tNo zstd dictionary trained -- " << ZDICT_getErrorName (size) << "." << endl;
+    }
+    return (false);
+  }
+
+  if (!ZstdDictionarySaves (dictionary.data (), size, samples, block_sizes)) {
+    return (false);
+  }
+
+  SetZstdDictionary (dictionary.data (), static_cast<unsigned int> (size));
+
+  return (true);
+#else
+  return (false);
+#endif
+}
+
+
+/*!
+     Set the dictionary used by zstd for every block, replacing any previous one.  A size of 0
+     removes the dictionary.
+
+     \param[in] dictionary The dictionary
+     \param[in] size Size of the dictionary in bytes
+*/
+void ExternalSoftware::SetZstdDictionary (const char *dictionary, unsigned int size) {
+  m_ZstdDictionary.assign (dictionary, dictionary + size);
+
+#if ZSTD_FOUND
+  //  The digested forms of the previous dictionary are made again when needed
+  ZSTD_freeCDict (m_ZstdCDict);
+  m_ZstdCDict = NULL;
+  ZSTD_freeDDict (m_ZstdDDict);
+  m_ZstdDDict = NULL;
+#endif
+
+  return;
+}
+
+
+/*!
+     Return the dictionary used by zstd, whose length is given by GetZstdDictionaryLength ().
+
+     \return The dictionary
+*/
+const char* ExternalSoftware::GetZstdDictionary () const {
+  return m_ZstdDictionary.data ();
+}
+
+
+/*!
+     Return the length of the dictionary used by zstd; 0 if there is none.
+
+     \return Length of the dictionary in bytes
+*/
+unsigned int ExternalSoftware::GetZstdDictionaryLength () const {
+  return static_cast<unsigned int> (m_ZstdDictionary.size ());
+}
+
+
+/*!
+     Return the most data, in bytes, that TrainZstdDictionary () uses from its samples.  There
+     is no need to collect more samples than this.
+
+     \return Size of the samples in bytes
+*/
+unsigned long long ExternalSoftware::GetZstdTrainingSize () const {
+  return (static_cast<unsigned long long> (g_ZSTD_DICTIONARY_SIZE) * g_ZSTD_TRAINING_RATIO);
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+#if ZSTD_FOUND
+/*!
+     Compress a buffer of input with the zstd library, without copying it into m_InBuffer.
+     Like ProcessZlib (), the frame is started by the first buffer of a block and finished by
+     the last one.  If the whole block is given at once, its size is recorded in the frame so
+     that UnProcessZstd () can allocate the output in one go.  In the end, the compressed data
+     is in m_OutBuffer, occupying m_OutBufferPtr bytes.
+
+     \param[in] buffer The buffer of data to compress
+     \param[in] buffer_size Size of the buffer to process
+     \param[in] last Indicate if this is the last buffer
+*/
+void ExternalSoftware::ProcessZstd (const char* buffer, unsigned int buffer_size, bool last) {
+  if (!m_ZstdStreamActive) {
+    ZSTD_CCtx_reset (m_ZstdCCtx, ZSTD_reset_session_and_parameters);
+    if (!m_ZstdDictionary.empty ()) {
+      if (m_ZstdCDict == NULL) {
+        m_ZstdCDict = ZSTD_createCDict (m_ZstdDictionary.data (), m_ZstdDictionary.size (), m_CompressionLevel);
+      }
+      ZSTD_CCtx_refCDict (m_ZstdCCtx, m_ZstdCDict);
+      //  The archive holds the dictionary, so its ID is not repeated in every frame
+      ZSTD_CCtx_setParameter (m_ZstdCCtx, ZSTD_c_dictIDFlag, 0);
+    }
+    ZSTD_CCtx_setParameter (m_ZstdCCtx, ZSTD_c_compressionLevel, m_CompressionLevel);
+    if (last) {
+      ZSTD_CCtx_setPledgedSrcSize (m_ZstdCCtx, buffer_size);
+    }
+    m_ZstdStreamActive = true;
+  }
+
+  ReserveOutBuffer (ZSTD_compressBound (buffer_size));
+
+  ZSTD_inBuffer input = { buffer, buffer_size, 0 };
+  ZSTD_EndDirective mode = last ? ZSTD_e_end : ZSTD_e_continue;
+  size_t remaining = 0;
+  do {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (ZSTD_CStreamOutSize ());
+    }
+    ZSTD_outBuffer output = { m_OutBuffer, m_OutBufferSize, m_OutBufferPtr };
+
+    remaining = ZSTD_compressStream2 (m_ZstdCCtx, &output, &input, mode);
+    if (ZSTD_isError (remaining)) {
+      cerr << "EE\tZstd compressor error -- " << ZSTD_getErrorName (remaining) << "." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_OutBufferPtr = static_cast<unsigned int> (output.pos);
+  } while ((input.pos != input.size) || ((last) && (remaining != 0)));
+
+  if (last) {
+    m_ZstdStreamActive = false;
+  }
+
+  return;
+}
+
+
+/*!
+     Unprocess a buffer of input using the zstd library.  The data is decompressed from
+     m_InBuffer straight into m_OutBuffer.  In the end, the decompressed data is in
+     m_OutBuffer, occupying m_OutBufferPtr bytes.
+*/
+void ExternalSoftware::UnProcessZstd () {
+  ZSTD_DCtx_reset (m_ZstdDCtx, ZSTD_reset_session_and_parameters);
+  if (!m_ZstdDictionary.empty ()) {
+    if (m_ZstdDDict == NULL) {
+      m_ZstdDDict = ZSTD_createDDict (m_ZstdDictionary.data (), m_ZstdDictionary.size ());
+    }
+    ZSTD_DCtx_refDDict (m_ZstdDCtx, m_ZstdDDict);
+  }
+
+  unsigned long long content_size = ZSTD_getFrameContentSize (m_InBuffer, m_InBufferPtr);
+  if ((content_size != ZSTD_CONTENTSIZE_UNKNOWN) && (content_size != ZSTD_CONTENTSIZE_ERROR)) {
+    ReserveOutBuffer (content_size);
+  }
+
+  ZSTD_inBuffer input = { m_InBuffer, m_InBufferPtr, 0 };
+  size_t remaining = 0;
+  bool output_full = false;
+  do {
+    if (m_OutBufferPtr == m_OutBufferSize) {
+      ReserveOutBuffer (m_OutBufferSize);
+    }
+    ZSTD_outBuffer output = { m_OutBuffer, m_OutBufferSize, m_OutBufferPtr };
+
+    remaining = ZSTD_decompressStream (m_ZstdDCtx, &output, &input);
+    if (ZSTD_isError (remaining)) {
+      cerr << "EE\tZstd decompressor error -- " << ZSTD_getErrorName (remaining) << "." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_OutBufferPtr = static_cast<unsigned int> (output.pos);
+    output_full = (output.pos == output.size);
+  } while ((input.pos != input.size) || (output_full));
+
+  if (remaining != 0) {
+    cerr << "EE\tZstd decompressor error -- the data is truncated." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  return;
+}
+
+
+/*!
+     Check whether a dictionary makes a set of blocks smaller, including the cost of storing
+     it once.  Each block is compressed on its own at the current level, both with and
+     without the dictionary, with the same frame parameters as ProcessZstd ().
+
+     \param[in] dictionary The dictionary
+     \param[in] dictionary_size Size of the dictionary in bytes
+     \param[in] blocks The blocks, one after another
+     \param[in] block_sizes The size of each block
+     \return true if the dictionary and the blocks compressed with it are smaller than the blocks compressed without it
+*/
+bool ExternalSoftware::ZstdDictionarySaves (const char *dictionary, size_t dictionary_size, const char *blocks, const vector<size_t> &block_sizes) const {
+  ZSTD_CCtx *cctx = ZSTD_createCCtx ();
+  ZSTD_CDict *cdict = ZSTD_createCDict (dictionary, dictionary_size, m_CompressionLevel);
+  unsigned long long with_dictionary = dictionary_size;
+  unsigned long long without_dictionary = 0;
+  vector<char> out;
+
+  const char *block = blocks;
+  for (size_t i = 0; i < block_sizes.size (); i++) {
+    out.resize (ZSTD_compressBound (block_sizes[i]));
+    ZSTD_CCtx_reset (cctx, ZSTD_reset_session_and_parameters);
+    ZSTD_CCtx_setParameter (cctx, ZSTD_c_compressionLevel, m_CompressionLevel);
+    size_t plain = ZSTD_compress2 (cctx, out.data (), out.size (), block, block_sizes[i]);
+    ZSTD_CCtx_refCDict (cctx, cdict);
+    ZSTD_CCtx_setParameter (cctx, ZSTD_c_dictIDFlag, 0);
+    size_t with = ZSTD_compress2 (cctx, out.data (), out.size (), block, block_sizes[i]);
+    if ((ZSTD_isError (plain)) || (ZSTD_isError (with))) {
+      cerr << "EE\tZstd compressor error -- " << ZSTD_getErrorName (ZSTD_isError (plain) ? plain : with) << "." << endl;
+      exit (EXIT_FAILURE);
+    }
+    without_dictionary += plain;
+    with_dictionary += with;
+    block += block_sizes[i];
+  }
+
+  ZSTD_freeCDict (cdict);
+  ZSTD_freeCCtx (cctx);
+
+  if (GetDebug ()) {
+    cerr << "DD\tThe first blocks compress to " << with_dictionary << " bytes with a zstd dictionary of " << dictionary_size << " bytes, and " << without_dictionary << " bytes without." << endl;
+  }
+
+  return (with_dictionary < without_dictionary);
+}
+#endif
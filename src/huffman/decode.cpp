@@ -30,9 +30,11 @@
 #include <fstream>  //  ostream
 #include <vector>
 #include <climits>  //  UINT_MAX
+#include <limits>  //  numeric_limits
 #include <algorithm>  //  sort
 #include <iostream>
 #include <cassert>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
 
 using namespace std;
 
@@ -88,6 +90,8 @@ void Huffman::DecodeBegin (BitBuffer &bitbuffer) {
     cerr << endl << endl;
   }
 
+  BuildDecodeTable ();
+
   return;
 }
 
@@ -100,45 +104,215 @@ void Huffman::DecodeBegin (BitBuffer &bitbuffer) {
      \return message as a vector
 */
 vector<unsigned int> Huffman::DecodeMessage (BitBuffer &bitbuffer, unsigned int len) {
-  vector<unsigned int> tmp;
-
   //  Ensure we aren't decoding too much
   if (m_MessageLengthDecoded + len > m_MessageLength) {
     len = m_MessageLength - m_MessageLengthDecoded;
   }
   
-  for (unsigned int i = 0; i < len; i++) {
-    unsigned int x = DecodeSymbol (bitbuffer);
-    tmp.push_back (x);
+  vector<unsigned int> tmp (len);
+  DecodeSymbols (bitbuffer, tmp.data (), len);
+
+  return (tmp);
+}
+
+
+/*!
+     Decode part or all of the message into an array of bytes
+     
+     \param[in] bitbuffer The bitbuffer to read the bits from.
+     \param[out] x Where to write the symbols; must have room for len of them
+     \param[in] len Length of the message to decode; can be less than m_MessageLength if we want to decode a piece at a time
+     \return The number of symbols decoded
+*/
+unsigned int Huffman::DecodeMessage (BitBuffer &bitbuffer, unsigned char *x, unsigned int len) {
+  //  Ensure we aren't decoding too much
+  if (m_MessageLengthDecoded + len > m_MessageLength) {
+    len = m_MessageLength - m_MessageLengthDecoded;
   }
   
-  m_MessageLengthDecoded += len;
+  DecodeSymbols (bitbuffer, x, len);
 
-  return (tmp);
+  return (len);
 }
 
 
 /*!
-     Finish decoding, read in the extra unsigned integer that was written out by EncodeFinish ()
-     and make sure it has a value of 0.  See the documentation EncodeFinish () for an explanation.
+     Finish decoding, read in the m_MaximumCodewordLen bits of 0's that were written out by
+     EncodeFinish ().  See the documentation EncodeFinish () for an explanation.  Since
+     DecodeSymbol () only looks ahead in the BitBuffer, none of them have been read yet.
      
-     \param[in] bitbuffer The bitbuffer to write the bits to.
+     \param[in] bitbuffer The bitbuffer to read the bits from.
 */
 void Huffman::DecodeFinish (BitBuffer &bitbuffer) {
-  unsigned int bits_to_read = m_MaximumCodewordLen - m_VBits;
-  
-  m_V = (m_V << bits_to_read) + bitbuffer.ReadBits (bits_to_read);
-  m_VBits += bits_to_read;
+  bitbuffer.ReadBits (m_MaximumCodewordLen);
   
   return;
 }
 
 
+/*!
+     Decode the whole message from the interleaved bitstreams written by EncodeStreams (), in
+     place of DecodeMessage () and DecodeFinish ().  Each stream is read by its own BitBuffer,
+     which shares the file with bitbuffer and starts at the stream's byte; nothing is copied
+     when the file is memory-mapped.  The streams are then decoded in turn, one table look-up
+     each, so that the look-ups of different streams do not depend on each other.  Afterwards,
+     bitbuffer is moved past the last stream.
+
+     \param[in] bitbuffer The bitbuffer to read the bits from.
+     \param[in] streams The number of streams, as given to EncodeStreams ()
+     \return message as a vector
+*/
+vector<unsigned int> Huffman::DecodeStreams (BitBuffer &bitbuffer, unsigned int streams) {
+  vector<unsigned int> tmp (m_MessageLength - m_MessageLengthDecoded);
+  DecodeStreamSymbols (bitbuffer, tmp.data (), streams);
+
+  return (tmp);
+}
+
+
+/*!
+     Decode the whole message from the interleaved bitstreams written by EncodeStreams ()
+     into an array of bytes, as DecodeStreams () above.
+
+     \param[in] bitbuffer The bitbuffer to read the bits from.
+     \param[out] x Where to write the symbols; must have room for the rest of the message
+     \param[in] streams The number of streams, as given to EncodeStreams ()
+*/
+void Huffman::DecodeStreams (BitBuffer &bitbuffer, unsigned char *x, unsigned int streams) {
+  DecodeStreamSymbols (bitbuffer, x, streams);
+
+  return;
+}
+
+
 //  -----------------------------------------------------------------
 //  Private functions
 //  -----------------------------------------------------------------
 
 
+/*!
+     Decode len symbols of the message, which is shared by the DecodeMessage () functions
+
+     \param[in] bitbuffer The bitbuffer to read the bits from.
+     \param[out] x Where to write the symbols
+     \param[in] len The number of symbols, which are all left in the message
+*/
+template <typename T>
+void Huffman::DecodeSymbols (BitBuffer &bitbuffer, T *x, unsigned int len) {
+  if (m_MaximumSymbol > numeric_limits<T>::max ()) {
+    cerr << "EE\tThe Huffman coded symbol " << m_MaximumSymbol << " is too large to decode." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  //  Take as many symbols from each look-up as the table gives, as long as no more than
+  //  len symbols are decoded; otherwise, decode one symbol at a time
+  unsigned int i = 0;
+  while (i < len) {
+    const HuffmanTableEntry &entry = m_DecodeTable[bitbuffer.Peek (m_TableBits)];
+    if ((entry.count > 1) && (!GetDebug ())) {
+      unsigned int count = min (entry.count, len - i);
+      for (unsigned int j = 0; j < count; j++) {
+        x[i + j] = static_cast<T> (entry.symbols[j]);
+      }
+      bitbuffer.Consume (entry.ends[count - 1]);
+      i += count;
+    }
+    else {
+      x[i] = static_cast<T> (DecodeSymbol (bitbuffer));
+      i++;
+    }
+  }
+  
+  m_MessageLengthDecoded += len;
+
+  return;
+}
+
+
+/*!
+     Decode the rest of the message from the interleaved bitstreams, which is shared by the
+     DecodeStreams () functions
+
+     \param[in] bitbuffer The bitbuffer to read the bits from.
+     \param[out] x Where to write the symbols
+     \param[in] streams The number of streams, as given to EncodeStreams ()
+*/
+template <typename T>
+void Huffman::DecodeStreamSymbols (BitBuffer &bitbuffer, T *x, unsigned int streams) {
+  assert ((streams > 0) && (streams <= g_HUFFMAN_STREAMS_MAX));
+  if (m_MaximumSymbol > numeric_limits<T>::max ()) {
+    cerr << "EE\tThe Huffman coded symbol " << m_MaximumSymbol << " is too large to decode." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  unsigned int stream_bytes[g_HUFFMAN_STREAMS_MAX];
+  BitBuffer stream_buffer[g_HUFFMAN_STREAMS_MAX];
+  //  Position in the message of the next symbol of each stream
+  unsigned int next[g_HUFFMAN_STREAMS_MAX];
+
+  for (unsigned int s = 0; s < streams; s++) {
+    stream_bytes[s] = Delta_Decode (bitbuffer) - 1;
+  }
+
+  bitbuffer.AlignRead (g_CHAR_SIZE_BITS);
+  unsigned long long byte_offset = bitbuffer.GetPosition () / g_CHAR_SIZE_BITS;
+  for (unsigned int s = 0; s < streams; s++) {
+    stream_buffer[s].Initialize (bitbuffer);
+    stream_buffer[s].SeekRead (byte_offset);
+    byte_offset += stream_bytes[s];
+    next[s] = s;
+  }
+
+  unsigned int length = m_MessageLength - m_MessageLengthDecoded;
+  const HuffmanTableEntry *table = m_DecodeTable.data ();
+
+  //  While every stream has room for a whole entry of the table, take all of its symbols;
+  //  a stream's symbols are streams apart in the message.  The streams are decoded in
+  //  rounds of one look-up each, and enough rounds are run at once that none of them
+  //  can pass limit, so that the streams need not be checked in between.
+  unsigned int limit = 0;
+  if (length > streams * (g_HUFFMAN_TABLE_SYMBOLS - 1)) {
+    limit = length - streams * (g_HUFFMAN_TABLE_SYMBOLS - 1);
+  }
+  unsigned int furthest = *max_element (next, next + streams);
+  while ((furthest < limit) && (!GetDebug ())) {
+    unsigned int rounds = (limit - furthest + streams * g_HUFFMAN_TABLE_SYMBOLS - 1) / (streams * g_HUFFMAN_TABLE_SYMBOLS);
+    for (unsigned int r = 0; r < rounds; r++) {
+      for (unsigned int s = 0; s < streams; s++) {
+        const HuffmanTableEntry &entry = table[stream_buffer[s].Peek (m_TableBits)];
+        if (entry.count != 0) {
+          //  All of the entry's symbols are stored, so that the loop does not depend on count;
+          //  the ones past count are overwritten later by the stream's next symbols
+          for (unsigned int i = 0; i < g_HUFFMAN_TABLE_SYMBOLS; i++) {
+            x[next[s] + i * streams] = static_cast<T> (entry.symbols[i]);
+          }
+          next[s] += entry.count * streams;
+          stream_buffer[s].Consume (entry.ends[entry.count - 1]);
+        }
+        else {
+          x[next[s]] = static_cast<T> (DecodeSymbol (stream_buffer[s]));
+          next[s] += streams;
+        }
+      }
+    }
+    furthest = *max_element (next, next + streams);
+  }
+
+  //  Then finish each stream one symbol at a time
+  for (unsigned int s = 0; s < streams; s++) {
+    while (next[s] < length) {
+      x[next[s]] = static_cast<T> (DecodeSymbol (stream_buffer[s]));
+      next[s] += streams;
+    }
+  }
+
+  m_MessageLengthDecoded = m_MessageLength;
+  bitbuffer.SeekRead (byte_offset);
+
+  return;
+}
+
+
 /*!
      Modify the m_Table data structure in preparation for message decoding.
      
@@ -210,37 +384,79 @@ void Huffman::DecodePrelude (BitBuffer &bitbuffer) {
 
 
 /*!
-     Decode a single symbol using the calculated Huffman codes.
+     Build the decoding table from the canonical code.  Every entry whose index starts with
+     a codeword of at most m_TableBits bits holds its symbol and length; the other entries
+     are left with a count of 0.  Then, each entry is extended with the codewords that
+     follow the first one within the index, up to g_HUFFMAN_TABLE_SYMBOLS of them.
+*/
+void Huffman::BuildDecodeTable () {
+  m_TableBits = min (m_MaximumCodewordLen, g_HUFFMAN_TABLE_BITS);
+  m_DecodeTable.assign (1 << m_TableBits, HuffmanTableEntry {});
+
+  unsigned int mask = (1u << m_TableBits) - 1;
+  for (unsigned int l = 1; l <= m_TableBits; l++) {
+    //  The codewords of length l are m_Base[l] onwards and belong to the symbols at m_Offset[l] onwards
+    for (unsigned int x = m_Offset[l]; x < m_Offset[l + 1]; x++) {
+      unsigned int c = m_Base[l] + (x - m_Offset[l]);
+      unsigned int first = c << (m_TableBits - l);
+      for (unsigned int i = 0; i < (1u << (m_TableBits - l)); i++) {
+        m_DecodeTable[first + i].symbols[0] = m_SymsUsed[x];
+        m_DecodeTable[first + i].ends[0] = static_cast<unsigned char> (l);
+        m_DecodeTable[first + i].count = 1;
+      }
+    }
+  }
+
+  //  The codeword after the first j bits of index i is the one at the start of index
+  //  (i << j), provided that it is no longer than the m_TableBits - j bits that remain
+  for (unsigned int i = 0; i < m_DecodeTable.size (); i++) {
+    HuffmanTableEntry &entry = m_DecodeTable[i];
+    while ((entry.count != 0) && (entry.count < g_HUFFMAN_TABLE_SYMBOLS)) {
+      unsigned int used = entry.ends[entry.count - 1];
+      const HuffmanTableEntry &next = m_DecodeTable[(i << used) & mask];
+      if ((next.count == 0) || (used + next.ends[0] > m_TableBits)) {
+        break;
+      }
+      entry.symbols[entry.count] = next.symbols[0];
+      entry.ends[entry.count] = static_cast<unsigned char> (used + next.ends[0]);
+      entry.count++;
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Decode a single symbol using the calculated Huffman codes.  The next m_TableBits bits
+     are looked up in the decoding table; only a longer codeword needs the search through
+     m_LJLimit over the next m_MaximumCodewordLen bits.
      
      \param[in] bitbuffer The bitbuffer to read the bits from.
      \return The symbol.
 */
 unsigned int Huffman::DecodeSymbol (BitBuffer &bitbuffer) {
-  unsigned int l = 1;
+  const HuffmanTableEntry &entry = m_DecodeTable[bitbuffer.Peek (m_TableBits)];
   
-  //  Fill up the bit buffer so that the number of bits is at
-  //    least the maximum codeword length
-  if (m_VBits < m_MaximumCodewordLen) {
-    unsigned int bits_to_read = m_MaximumCodewordLen - m_VBits;
-    try {
-      m_V = (m_V << bits_to_read) + bitbuffer.ReadBits (bits_to_read);
-      m_VBits += bits_to_read;
-    }
-    catch (exception &BitBuffer_Input_Exception) {
-      cerr << "EE\tOpps -- unexpected end to the input stream of bits!" << endl;
+  if (entry.count != 0) {
+    bitbuffer.Consume (entry.ends[0]);
+
+    if (GetDebug ()) {
+      cerr << "\t[*]\t" << entry.symbols[0] << "\t(length " << static_cast<unsigned int> (entry.ends[0]) << ")" << endl;
     }
+
+    return (entry.symbols[0]);
   }
-  
-  while (m_V >= m_LJLimit[l]) {
+
+  unsigned int v = static_cast<unsigned int> (bitbuffer.Peek (m_MaximumCodewordLen));
+  unsigned int l = m_TableBits + 1;
+  while (v >= m_LJLimit[l]) {
     l++;
   }
   
-  unsigned int c = (m_V >> (m_MaximumCodewordLen - l));
-  m_V = m_V - (c << (m_MaximumCodewordLen - l));
+  unsigned int c = (v >> (m_MaximumCodewordLen - l));
   unsigned int x = (c - m_Base[l]) + m_Offset[l];
-  
-  //  Update the number of bits in the bit buffer
-  m_VBits -= l;
+  bitbuffer.Consume (l);
 
   if (GetDebug ()) {
     cerr << "\t[*]\t" << c << "\t" << x << "\t" << m_SymsUsed[x] << "\t" << m_Offset[l] << "\t" << m_Base[l] << "\t(length " << l << ")" << endl;
@@ -248,4 +464,3 @@ unsigned int Huffman::DecodeSymbol (BitBuffer &bitbuffer) {
 
   return (m_SymsUsed[x]);
 }
-
@@ -84,6 +84,14 @@ void Huffman::EncodeBegin (BitBuffer &bitbuffer) {
 
   CalculateHuffmanCode ();
 
+  if (GetCodewordLimit () != 0) {
+    if (GetDebug ()) {
+      cerr << "II\tLimitCodewordLengths ()" << endl;
+    }
+
+    LimitCodewordLengths ();
+  }
+
   if (GetDebug ()) {
     for (unsigned int i = 0; i < m_SymsUsed.size (); i++) {
       cerr << "\t[2]\t" << i << "\t" << m_SymsUsed[i] << "\t" << m_Table[m_SymsUsed[i]] << endl;
@@ -166,7 +174,7 @@ void Huffman::EncodeBegin (BitBuffer &bitbuffer) {
      \param[in] bitbuffer The bitbuffer to write the bits to.
      \param[in] x The vector to encode.
 */
-void Huffman::EncodeMessage (BitBuffer &bitbuffer, vector<unsigned int> x) {
+void Huffman::EncodeMessage (BitBuffer &bitbuffer, const vector<unsigned int> &x) {
 //   cerr << "[Huffman::EncodeMessage**] size --\t" << x.size () << endl;
 //   cerr << "[Huffman::EncodeMessage*]\t10\t" << m_Table[10] << endl;
 //   cerr << "[Huffman::EncodeMessage*]\t70\t" << m_Table[70] << endl;
@@ -180,6 +188,23 @@ void Huffman::EncodeMessage (BitBuffer &bitbuffer, vector<unsigned int> x) {
 }
 
 
+/*!
+     Encode an array of byte values x using the calculated Huffman codes, such as a read
+     of a QScoresBlock, without copying it into a vector first.
+
+     \param[in] bitbuffer The bitbuffer to write the bits to.
+     \param[in] x The values to encode.
+     \param[in] len The number of values.
+*/
+void Huffman::EncodeMessage (BitBuffer &bitbuffer, const unsigned char *x, unsigned int len) {
+  for (unsigned int i = 0; i < len; i++) {
+    EncodeSymbol (bitbuffer, m_Table[x[i]]);
+  }
+
+  return;
+}
+
+
 /*!
      Finish encoding, so write out a 0 of length m_MaximumCodewordLen.  The reason is that 
      the decoder is reading in bits into a buffer and if it reads too much, then somehow,
@@ -200,10 +225,86 @@ void Huffman::EncodeFinish (BitBuffer &bitbuffer) {
 }
 
 
+/*!
+     Encode the whole message across interleaved bitstreams, in place of EncodeMessage () and
+     EncodeFinish ().  Symbol i of the message goes to stream (i % streams).  Each stream is
+     staged in memory and padded to a whole byte.  The lengths of the streams in bytes, plus
+     1 since a stream can be empty, are then Delta coded, followed by the streams themselves, starting at a whole byte.  Since
+     each stream is read by its own BitBuffer, none of them needs the 0 of EncodeFinish ().
+
+     So that DecodeStreams () can read the streams where they are, the position of bitbuffer
+     must be a whole number of bytes from the start of the file that will be decoded.  That
+     is, bitbuffer must not be appended to another BitBuffer part way through a byte.
+
+     \param[in] bitbuffer The bitbuffer to write the bits to.
+     \param[in] x The message; its length must be the one given to UpdateFrequencies ().
+     \param[in] streams The number of streams, from 1 to g_HUFFMAN_STREAMS_MAX
+*/
+void Huffman::EncodeStreams (BitBuffer &bitbuffer, const vector<unsigned int> &x, unsigned int streams) {
+  EncodeStreamSymbols (bitbuffer, x.data (), x.size (), streams);
+
+  return;
+}
+
+
+/*!
+     Encode the whole message across interleaved bitstreams, like the other version of
+     EncodeStreams (), but from an array of byte values, such as the quality scores of a
+     QScoresBlock, without copying it into a vector first.
+
+     \param[in] bitbuffer The bitbuffer to write the bits to.
+     \param[in] x The values; their number must be the one given to UpdateFrequencies ().
+     \param[in] len The number of values
+     \param[in] streams The number of streams, from 1 to g_HUFFMAN_STREAMS_MAX
+*/
+void Huffman::EncodeStreams (BitBuffer &bitbuffer, const unsigned char *x, unsigned int len, unsigned int streams) {
+  EncodeStreamSymbols (bitbuffer, x, len, streams);
+
+  return;
+}
+
+
 //  -----------------------------------------------------------------
 //  Private functions
 //  -----------------------------------------------------------------
 
+/*!
+     Encode the whole message across interleaved bitstreams for EncodeStreams (), whatever
+     the type of its symbols.
+
+     \param[in] bitbuffer The bitbuffer to write the bits to.
+     \param[in] x The message
+     \param[in] len The number of symbols
+     \param[in] streams The number of streams, from 1 to g_HUFFMAN_STREAMS_MAX
+*/
+template <typename T>
+void Huffman::EncodeStreamSymbols (BitBuffer &bitbuffer, const T *x, size_t len, unsigned int streams) {
+  assert ((streams > 0) && (streams <= g_HUFFMAN_STREAMS_MAX));
+  assert (len == m_MessageLength);
+
+  BitBuffer stream_buffer[g_HUFFMAN_STREAMS_MAX];
+  for (unsigned int s = 0; s < streams; s++) {
+    stream_buffer[s].Initialize (e_MODE_MEMORY_WRITE);
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    EncodeSymbol (stream_buffer[i % streams], m_Table[x[i]]);
+  }
+
+  for (unsigned int s = 0; s < streams; s++) {
+    stream_buffer[s].AlignWrite (g_CHAR_SIZE_BITS);
+    Delta_Encode (bitbuffer, static_cast<unsigned int> (stream_buffer[s].GetPosition () / g_CHAR_SIZE_BITS) + 1);
+  }
+
+  bitbuffer.AlignWrite (g_CHAR_SIZE_BITS);
+  for (unsigned int s = 0; s < streams; s++) {
+    bitbuffer.WriteBitBuffer (stream_buffer[s]);
+  }
+
+  return;
+}
+
+
 /*!
      Modify the m_Table data structure in preparation for message encoding.
      
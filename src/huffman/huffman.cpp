@@ -79,14 +79,15 @@ Huffman::Huffman (bool debug)
     m_MaximumSymbol (0),
     m_DistinctSymbols (0),
     m_MaximumCodewordLen (0),
+    m_CodewordLimit (0),
     m_SymsUsed (),
     m_Table (),
     m_W (),
     m_Base (),
     m_Offset (),
     m_LJLimit (),
-    m_V (0),
-    m_VBits (0)
+    m_DecodeTable (),
+    m_TableBits (0)
 {
   //  Add symbol 0 with 0 frequency as a sentinel value.  Only positions from 1 are used.
   m_Table.push_back (0);
@@ -142,3 +143,35 @@ unsigned int Huffman::GetTableValue (unsigned int pos) const {
   return m_Table[pos];
 }
 
+
+/*!
+     Return m_MaximumCodewordLen
+
+     \return Length of the longest codeword
+*/
+unsigned int Huffman::GetMaximumCodewordLen () const {
+  return m_MaximumCodewordLen;
+}
+
+
+/*!
+     Return m_CodewordLimit
+
+     \return Longest codeword allowed when encoding; 0 if there is no limit
+*/
+unsigned int Huffman::GetCodewordLimit () const {
+  return m_CodewordLimit;
+}
+
+
+/*!
+     Limit the length of the codewords, at a small cost in compression.  With a limit of at
+     most g_HUFFMAN_TABLE_BITS, every codeword is decoded with the table.  Must be set before
+     EncodeBegin (); it is not needed for decoding.
+
+     \param[in] x Longest codeword allowed; 0 for no limit
+*/
+void Huffman::SetCodewordLimit (unsigned int x) {
+  m_CodewordLimit = x;
+}
+
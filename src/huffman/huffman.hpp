@@ -31,6 +31,40 @@
 #define HUFFMAN_HPP
 
 
+/*!
+     Largest number of bits used to index the decoding table.  Codewords up to this long
+     are decoded with a single look-up; longer ones are decoded with m_LJLimit.
+*/
+const unsigned int g_HUFFMAN_TABLE_BITS = 11;
+
+
+/*!
+     Largest number of symbols that one entry of the decoding table can hold
+*/
+const unsigned int g_HUFFMAN_TABLE_SYMBOLS = 4;
+
+
+/*!
+     Largest number of interleaved streams that a message can be split across by
+     EncodeStreams ()
+*/
+const unsigned int g_HUFFMAN_STREAMS_MAX = 8;
+
+
+/*!
+     Entry of the decoding table.  When the codewords are short, several of them fit in
+     the index and are all decoded with one look-up.
+*/
+struct HuffmanTableEntry {
+  //!  Symbols whose codewords start the index, in order
+  unsigned int symbols[g_HUFFMAN_TABLE_SYMBOLS];
+  //!  Number of bits taken by the first i + 1 codewords, for each i < count
+  unsigned char ends[g_HUFFMAN_TABLE_SYMBOLS];
+  //!  Number of symbols; 0 if the first codeword is longer than the index
+  unsigned int count;
+};
+
+
 /*!
     \class Huffman
 
@@ -66,6 +100,11 @@
     4)  Decode a block of symbols using DecodeMessage ().  Setting the block size to the message length just reads it all in one go.
     5)  Finalize using DecodeFinish ()
     
+    Instead of steps 5) and 6), the whole message can be given to EncodeStreams (), which splits
+    it across 4 or 8 interleaved bitstreams that share the prelude.  Such a message must be
+    decoded with DecodeStreams () instead of steps 4) and 5).  The decoder then has several
+    independent chains of table look-ups to work on, instead of one.
+
     Additional functions such as SetDebug () and DebugCumulativeSum () are useful for debugging.
     
 */
@@ -81,35 +120,53 @@ class Huffman {
     void SetDebug ();
     unsigned int GetMessageLength () const;
     unsigned int GetTableValue (unsigned int pos) const;
+    unsigned int GetMaximumCodewordLen () const;
+    unsigned int GetCodewordLimit () const;
+    void SetCodewordLimit (unsigned int x);
 
     //  Encoding functions  [encode.cpp]    
     void EncodeBegin (BitBuffer &bitbuffer);
-    void EncodeMessage (BitBuffer &bitbuffer, vector<unsigned int> x);
+    void EncodeMessage (BitBuffer &bitbuffer, const vector<unsigned int> &x);
+    void EncodeMessage (BitBuffer &bitbuffer, const unsigned char *x, unsigned int len);
     void EncodeFinish (BitBuffer &bitbuffer);
+    void EncodeStreams (BitBuffer &bitbuffer, const vector<unsigned int> &x, unsigned int streams);
+    void EncodeStreams (BitBuffer &bitbuffer, const unsigned char *x, unsigned int len, unsigned int streams);
 
     //  Decoding functions  [decode.cpp]
     void DecodeBegin (BitBuffer &bitbuffer);
     vector<unsigned int> DecodeMessage (BitBuffer &bitbuffer, unsigned int len);
+    unsigned int DecodeMessage (BitBuffer &bitbuffer, unsigned char *x, unsigned int len);
     void DecodeFinish (BitBuffer &bitbuffer);
+    vector<unsigned int> DecodeStreams (BitBuffer &bitbuffer, unsigned int streams);
+    void DecodeStreams (BitBuffer &bitbuffer, unsigned char *x, unsigned int streams);
 
     //  Main processing functions  [process.cpp]
-    void UpdateFrequencies (vector<unsigned int> x);
+    void UpdateFrequencies (const vector<unsigned int> &x);
+    void UpdateFrequencies (const unsigned char *x, unsigned int len);
 
     //  Debugging functions  [debug.cpp]
     void DebugCumulativeSum ();
   private:
     //  Encoding functions  [encode.cpp]
+    template <typename T>
+    void EncodeStreamSymbols (BitBuffer &bitbuffer, const T *x, size_t len, unsigned int streams);
     void PreEncodeMessage ();
     void EncodePrelude (BitBuffer &bitbuffer);
     void EncodeSymbol (BitBuffer &bitbuffer, unsigned int x);
   
     //  Decoding functions  [decode.cpp]
+    template <typename T>
+    void DecodeSymbols (BitBuffer &bitbuffer, T *x, unsigned int len);
+    template <typename T>
+    void DecodeStreamSymbols (BitBuffer &bitbuffer, T *x, unsigned int streams);
     void PreDecodeMessage ();
     void DecodePrelude (BitBuffer &bitbuffer);
+    void BuildDecodeTable ();
     unsigned int DecodeSymbol (BitBuffer &bitbuffer);
     
     //  Main processing functions  [process.cpp]
     void CalculateHuffmanCode ();
+    void LimitCodewordLengths ();
     void SetWBaseOffset ();
 
     //  Sorting functions  [sort.cpp]
@@ -131,6 +188,8 @@ class Huffman {
     unsigned int m_DistinctSymbols;
     //!  Maximum length of any codeword
     unsigned int m_MaximumCodewordLen;
+    //!  Longest codeword allowed when encoding; 0 if there is no limit
+    unsigned int m_CodewordLimit;
 
     //!  Vector of symbols used
     vector<unsigned int> m_SymsUsed;
@@ -146,10 +205,10 @@ class Huffman {
     //!  ...
     vector<unsigned int> m_LJLimit;
 
-    //!  The input buffer of bits
-    unsigned int m_V;
-    //!  Number of usable bits in V (i.e., less than or equal to m_MaximumCodewordLen)
-    unsigned int m_VBits;
+    //!  Decoding table indexed by the next m_TableBits bits
+    vector<HuffmanTableEntry> m_DecodeTable;
+    //!  Number of bits used to index m_DecodeTable (i.e., at most g_HUFFMAN_TABLE_BITS)
+    unsigned int m_TableBits;
 };
 
 #endif
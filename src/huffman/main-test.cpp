@@ -76,6 +76,15 @@ int main(int argc, char **argv) {
   else if (strcmp (argv[1], "6") == 0) {
     result = HuffmanRandom ();
   }
+  else if (strcmp (argv[1], "7") == 0) {
+    result = HuffmanSkewed ();
+  }
+  else if (strcmp (argv[1], "8") == 0) {
+    result = HuffmanStreams ();
+  }
+  else if (strcmp (argv[1], "9") == 0) {
+    result = HuffmanLimited ();
+  }
 
   if (!result) {
     return (EXIT_FAILURE);
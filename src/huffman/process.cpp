@@ -33,6 +33,7 @@
 #include <algorithm>  //  sort
 #include <iostream>
 #include <cassert>
+#include <bit>  //  bit_width
 
 using namespace std;
 
@@ -50,7 +51,7 @@ using namespace std;
 
      \param[in] x The vector of integers to update the table with
 */
-void Huffman::UpdateFrequencies (vector<unsigned int> x) {
+void Huffman::UpdateFrequencies (const vector<unsigned int> &x) {
   for (unsigned int i = 0; i < x.size (); i++) {
     unsigned int pos = x[i];
     if (pos >= m_Table.size ()) {
@@ -69,6 +70,32 @@ void Huffman::UpdateFrequencies (vector<unsigned int> x) {
 }
 
 
+/*!
+     Update the frequency table using an array of byte values, such as a read of a
+     QScoresBlock
+
+     \param[in] x The values to update the table with
+     \param[in] len The number of values
+*/
+void Huffman::UpdateFrequencies (const unsigned char *x, unsigned int len) {
+  for (unsigned int i = 0; i < len; i++) {
+    unsigned int pos = x[i];
+    if (pos >= m_Table.size ()) {
+      m_Table.resize (pos + 1, 0);
+    }
+    if (m_Table[pos] == 0) {
+      m_DistinctSymbols++;
+      m_SymsUsed.push_back (pos);
+    }
+    m_Table[pos]++;
+  }
+
+  m_MessageLength += len;
+
+  return;
+}
+
+
 //  -----------------------------------------------------------------
 //  Private functions
 //  -----------------------------------------------------------------
@@ -147,6 +174,72 @@ void Huffman::CalculateHuffmanCode () {
 }
 
 
+/*!
+     Limit the codeword lengths calculated by CalculateHuffmanCode () to m_CodewordLimit bits,
+     or to the fewest bits that can hold m_DistinctSymbols codewords if that is more.  This is
+     a heuristic rather than an optimal (e.g., package-merge) construction:
+
+       1)  Codewords longer than the limit are cut to it, which leaves the code over-full.
+       2)  The codewords of the least frequent symbols are made longer until it is not.
+       3)  The codewords of the most frequent symbols are made shorter while there is room.
+
+     The lengths are then sorted again so that they do not decrease as the frequencies do.
+     Since the codeword lengths are all that the prelude records, the decoder is unchanged.
+
+     The Kraft sum of the code is kept in units of 2^-limit, minus 2^limit; so it is positive
+     when the code is over-full.
+*/
+void Huffman::LimitCodewordLengths () {
+  unsigned int distinct = m_DistinctSymbols;
+  if ((m_CodewordLimit == 0) || (distinct < 2)) {
+    return;
+  }
+
+  unsigned int limit = max (m_CodewordLimit, static_cast<unsigned int> (bit_width (distinct - 1)));
+  if (m_Table[m_SymsUsed[distinct]] <= limit) {
+    return;
+  }
+
+  long long excess = -(1LL << limit);
+  for (unsigned int i = 1; i <= distinct; i++) {
+    unsigned int &len = m_Table[m_SymsUsed[i]];
+    if (len > limit) {
+      len = limit;
+    }
+    excess += (1LL << (limit - len));
+  }
+
+  //  Lengthen codewords, starting from the least frequent symbol
+  for (unsigned int i = distinct; (i >= 1) && (excess > 0); i--) {
+    unsigned int &len = m_Table[m_SymsUsed[i]];
+    while ((len < limit) && (excess > 0)) {
+      len++;
+      excess -= (1LL << (limit - len));
+    }
+  }
+
+  //  Shorten codewords, starting from the most frequent symbol
+  for (unsigned int i = 1; i <= distinct; i++) {
+    unsigned int &len = m_Table[m_SymsUsed[i]];
+    while ((len > 1) && (excess + (1LL << (limit - len)) <= 0)) {
+      excess += (1LL << (limit - len));
+      len--;
+    }
+  }
+
+  vector<unsigned int> lengths;
+  for (unsigned int i = 1; i <= distinct; i++) {
+    lengths.push_back (m_Table[m_SymsUsed[i]]);
+  }
+  sort (lengths.begin (), lengths.end ());
+  for (unsigned int i = 1; i <= distinct; i++) {
+    m_Table[m_SymsUsed[i]] = lengths[i - 1];
+  }
+
+  return;
+}
+
+
 /*!
      Set the m_W, m_Base, and m_Offset arrays for efficient encoding/decoding.
 */
@@ -31,6 +31,7 @@
 #include <vector>
 #include <iostream>
 #include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+#include <algorithm>  //  max
 
 using namespace std;
 
@@ -391,3 +392,225 @@ bool HuffmanRandom () {
   return (true);
 }
   
+
+
+/*!
+     Huffman code a set of random numbers whose frequencies halve from one symbol to
+     the next, so that some codewords are too long for the decoding table.  A marker is
+     written after the message to check that the decoder stops at the right bit.
+
+     \return true if the test was successful; false otherwise
+*/
+bool HuffmanSkewed () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> tmp;
+  vector<unsigned int> tmp2;
+  unsigned int marker = 0xA5A5A5A5;
+  
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data; symbol i appears with probability 2^-i
+  for (unsigned int i = 0; i < g_TEST_SIZE * 100; i++) {
+    unsigned int pos = 1;
+    while ((pos < g_MAX_ASCII) && (rand () % 2 == 0)) {
+      pos++;
+    }
+    tmp.push_back (pos);
+  }
+
+  //  Test encoding
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  Huffman hm_out;
+  hm_out.UpdateFrequencies (tmp);
+  hm_out.EncodeBegin (bitbuff_out);
+  hm_out.EncodeMessage (bitbuff_out, tmp);
+  hm_out.EncodeFinish (bitbuff_out);
+  bitbuff_out.WriteBits (marker, g_UINT_SIZE_BITS);
+  bitbuff_out.Finish ();
+  
+  //  Test decoding, in two pieces
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  Huffman hm_in;
+  hm_in.DecodeBegin (bitbuff_in);
+  tmp2 = hm_in.DecodeMessage (bitbuff_in, hm_in.GetMessageLength () / 2);
+  vector<unsigned int> rest = hm_in.DecodeMessage (bitbuff_in, hm_in.GetMessageLength ());
+  tmp2.insert (tmp2.end (), rest.begin (), rest.end ());
+  hm_in.DecodeFinish (bitbuff_in);
+  unsigned int marker_in = bitbuff_in.ReadBits (g_UINT_SIZE_BITS);
+  bitbuff_in.Finish ();
+
+  if ((!VectorSame (tmp, tmp2)) || (marker_in != marker)) {
+    cerr << "EE\tHuffman coding of skewed random numbers unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tHuffman coding of skewed random numbers successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Huffman code the skewed random numbers of HuffmanSkewed () across 4 and then 8
+     interleaved streams.  The message length is not a multiple of either, so that the
+     streams end with different numbers of symbols.  Its first 3 symbols are then coded
+     on their own, so that some streams are empty.  A marker is written after the streams
+     to check that the decoder stops at the right bit.  The streams made from the message
+     as an array of bytes must be the same as those made from the vector.
+
+     \return true if the test was successful; false otherwise
+*/
+bool HuffmanStreams () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> tmp;
+  vector<unsigned int> tmp2;
+  unsigned int marker = 0xA5A5A5A5;
+  
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data; symbol i appears with probability 2^-i
+  for (unsigned int i = 0; i < g_TEST_SIZE * 100 + 5; i++) {
+    unsigned int pos = 1;
+    while ((pos < g_MAX_ASCII) && (rand () % 2 == 0)) {
+      pos++;
+    }
+    tmp.push_back (pos);
+  }
+
+  vector<unsigned int> short_tmp (tmp.begin (), tmp.begin () + 3);
+  for (const vector<unsigned int> &message : {tmp, short_tmp}) {
+    for (unsigned int streams = 4; streams <= g_HUFFMAN_STREAMS_MAX; streams *= 2) {
+      //  Test encoding
+      BitBuffer bitbuff_out;
+      bitbuff_out.Initialize (str, e_MODE_WRITE);
+      Huffman hm_out;
+      hm_out.UpdateFrequencies (message);
+      hm_out.EncodeBegin (bitbuff_out);
+      hm_out.EncodeStreams (bitbuff_out, message, streams);
+      bitbuff_out.WriteBits (marker, g_UINT_SIZE_BITS);
+      bitbuff_out.Finish ();
+
+      vector<char> bytes_vector;
+      vector<char> bytes;
+      vector<unsigned char> message_bytes (message.begin (), message.end ());
+      for (unsigned int k = 0; k < 2; k++) {
+        BitBuffer bitbuff_memory;
+        bitbuff_memory.Initialize (e_MODE_MEMORY_WRITE);
+        Huffman hm_memory;
+        if (k == 0) {
+          hm_memory.UpdateFrequencies (message);
+          hm_memory.EncodeBegin (bitbuff_memory);
+          hm_memory.EncodeStreams (bitbuff_memory, message, streams);
+          bitbuff_memory.GetBytes (bytes_vector);
+        }
+        else {
+          hm_memory.UpdateFrequencies (message_bytes.data (), message_bytes.size ());
+          hm_memory.EncodeBegin (bitbuff_memory);
+          hm_memory.EncodeStreams (bitbuff_memory, message_bytes.data (), message_bytes.size (), streams);
+          bitbuff_memory.GetBytes (bytes);
+        }
+      }
+      if (bytes != bytes_vector) {
+        cerr << "EE\tHuffman coding of " << message.size () << " bytes across " << streams << " streams differs from coding them as a vector!" << endl;
+        return (false);
+      }
+  
+      //  Test decoding
+      BitBuffer bitbuff_in;
+      bitbuff_in.Initialize (str, e_MODE_READ);
+      Huffman hm_in;
+      hm_in.DecodeBegin (bitbuff_in);
+      tmp2 = hm_in.DecodeStreams (bitbuff_in, streams);
+      unsigned int marker_in = bitbuff_in.ReadBits (g_UINT_SIZE_BITS);
+      bitbuff_in.Finish ();
+
+      BitBuffer bitbuff_bytes_in;
+      bitbuff_bytes_in.Initialize (bytes.data (), bytes.size ());
+      Huffman hm_bytes_in;
+      hm_bytes_in.DecodeBegin (bitbuff_bytes_in);
+      vector<unsigned char> tmp2_bytes (message_bytes.size ());
+      hm_bytes_in.DecodeStreams (bitbuff_bytes_in, tmp2_bytes.data (), streams);
+
+      if ((!VectorSame (message, tmp2)) || (marker_in != marker) || (tmp2_bytes != message_bytes)) {
+        cerr << "EE\tHuffman coding of " << message.size () << " symbols across " << streams << " streams unsuccessful!" << endl;
+        return (false);
+      }
+    }
+  }
+
+  cerr << "II\tHuffman coding across interleaved streams successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Huffman code the skewed random numbers of HuffmanSkewed () with the codewords limited
+     to g_HUFFMAN_TABLE_BITS bits and then to the fewest bits possible.  Without a limit, the
+     longest codewords are longer than this.
+
+     \return true if the test was successful; false otherwise
+*/
+bool HuffmanLimited () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> tmp;
+  vector<unsigned int> tmp2;
+  
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data; symbol i appears with probability 2^-i
+  for (unsigned int i = 0; i < g_TEST_SIZE * 100; i++) {
+    unsigned int pos = 1;
+    while ((pos < g_MAX_ASCII) && (rand () % 2 == 0)) {
+      pos++;
+    }
+    tmp.push_back (pos);
+  }
+
+  for (unsigned int limit : {g_HUFFMAN_TABLE_BITS, 1u}) {
+    //  Test encoding
+    BitBuffer bitbuff_out;
+    bitbuff_out.Initialize (str, e_MODE_WRITE);
+    Huffman hm_out;
+    hm_out.SetCodewordLimit (limit);
+    hm_out.UpdateFrequencies (tmp);
+    hm_out.EncodeBegin (bitbuff_out);
+    hm_out.EncodeMessage (bitbuff_out, tmp);
+    hm_out.EncodeFinish (bitbuff_out);
+    bitbuff_out.Finish ();
+
+    //  A limit that is too small is raised to the fewest bits that can hold every symbol
+    unsigned int distinct = *max_element (tmp.begin (), tmp.end ());
+    unsigned int fewest = 0;
+    while ((1u << fewest) < distinct) {
+      fewest++;
+    }
+    if (hm_out.GetMaximumCodewordLen () > max (limit, fewest)) {
+      cerr << "EE\tLongest codeword has " << hm_out.GetMaximumCodewordLen () << " bits, more than the limit of " << limit << "!" << endl;
+      return (false);
+    }
+  
+    //  Test decoding
+    BitBuffer bitbuff_in;
+    bitbuff_in.Initialize (str, e_MODE_READ);
+    Huffman hm_in;
+    hm_in.DecodeBegin (bitbuff_in);
+    tmp2 = hm_in.DecodeMessage (bitbuff_in, hm_in.GetMessageLength ());
+    hm_in.DecodeFinish (bitbuff_in);
+    bitbuff_in.Finish ();
+
+    if (!VectorSame (tmp, tmp2)) {
+      cerr << "EE\tHuffman coding with codewords of at most " << limit << " bits unsuccessful!" << endl;
+      return (false);
+    }
+  }
+
+  cerr << "II\tHuffman coding with limited codeword lengths successful!" << endl;
+  return (true);
+}
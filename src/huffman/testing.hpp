@@ -40,5 +40,8 @@ bool HuffmanSimple2Example ();
 bool HuffmanSimple3Example ();
 bool HuffmanCACAExample ();
 bool HuffmanRandom ();
+bool HuffmanSkewed ();
+bool HuffmanStreams ();
+bool HuffmanLimited ();
 
 #endif
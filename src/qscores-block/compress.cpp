@@ -0,0 +1,377 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file compress.cpp
+    Compression functions for QScoresBlock class.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <fstream>  //  ostream
+#include <iostream>
+#include <climits>  //  UINT_MAX
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "bitio-defn.hpp"
+#include "interpolative.hpp"
+#include "qscores-block.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Compression functions
+//  -----------------------------------------------------------------
+
+/*!
+     Apply binary coding to every read and output to the binary file
+
+     \param[in] bitbuffer BitBuffer object to output to
+     \param[in] param Parameter to Binary coding (largest possible value)
+     \param[in] len Length of each read (if 0, then explicitly encode it)
+*/
+void QScoresBlock::ApplyCompressionBinary (BitBuffer &bitbuffer, unsigned int param, unsigned int len) const {
+  for (unsigned int i = 0; i < GetNumReads (); i++) {
+    const unsigned char *values = GetRead (i);
+    unsigned int read_length = GetReadLength (i);
+
+    //  Delta encode the length of the read if explicitly asked to
+    if (len == 0) {
+      Delta_Encode (bitbuffer, read_length);
+    }
+
+    for (unsigned int j = 0; j < read_length; j++) {
+      BinaryHigh_Encode (bitbuffer, values[j], param);
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Apply gamma coding to every read and output to the binary file
+
+     \param[in] bitbuffer BitBuffer object to output to
+     \param[in] len Length of each read (if 0, then explicitly encode it)
+*/
+void QScoresBlock::ApplyCompressionGamma (BitBuffer &bitbuffer, unsigned int len) const {
+  for (unsigned int i = 0; i < GetNumReads (); i++) {
+    const unsigned char *values = GetRead (i);
+    unsigned int read_length = GetReadLength (i);
+
+    //  Delta encode the length of the read if explicitly asked to
+    if (len == 0) {
+      Delta_Encode (bitbuffer, read_length);
+    }
+
+    for (unsigned int j = 0; j < read_length; j++) {
+      Gamma_Encode (bitbuffer, values[j]);
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Apply delta coding to every read and output to the binary file
+
+     \param[in] bitbuffer BitBuffer object to output to
+     \param[in] len Length of each read (if 0, then explicitly encode it)
+*/
+void QScoresBlock::ApplyCompressionDelta (BitBuffer &bitbuffer, unsigned int len) const {
+  for (unsigned int i = 0; i < GetNumReads (); i++) {
+    const unsigned char *values = GetRead (i);
+    unsigned int read_length = GetReadLength (i);
+
+    //  Delta encode the length of the read if explicitly asked to
+    if (len == 0) {
+      Delta_Encode (bitbuffer, read_length);
+    }
+
+    for (unsigned int j = 0; j < read_length; j++) {
+      Delta_Encode (bitbuffer, values[j]);
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Apply Golomb coding to every read and output to the binary file
+
+     \param[in] bitbuffer BitBuffer object to output to
+     \param[in] param Parameter to Golomb coding
+     \param[in] len Length of each read (if 0, then explicitly encode it)
+*/
+void QScoresBlock::ApplyCompressionGolomb (BitBuffer &bitbuffer, unsigned int param, unsigned int len) const {
+  for (unsigned int i = 0; i < GetNumReads (); i++) {
+    const unsigned char *values = GetRead (i);
+    unsigned int read_length = GetReadLength (i);
+
+    //  Delta encode the length of the read if explicitly asked to
+    if (len == 0) {
+      Delta_Encode (bitbuffer, read_length);
+    }
+
+    for (unsigned int j = 0; j < read_length; j++) {
+      Golomb_Encode (bitbuffer, values[j], param);
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Apply Rice coding to every read and output to the binary file
+
+     \param[in] bitbuffer BitBuffer object to output to
+     \param[in] param Parameter to Rice coding
+     \param[in] len Length of each read (if 0, then explicitly encode it)
+*/
+void QScoresBlock::ApplyCompressionRice (BitBuffer &bitbuffer, unsigned int param, unsigned int len) const {
+  for (unsigned int i = 0; i < GetNumReads (); i++) {
+    const unsigned char *values = GetRead (i);
+    unsigned int read_length = GetReadLength (i);
+
+    //  Delta encode the length of the read if explicitly asked to
+    if (len == 0) {
+      Delta_Encode (bitbuffer, read_length);
+    }
+
+    for (unsigned int j = 0; j < read_length; j++) {
+      Rice_Encode (bitbuffer, values[j], param);
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Apply interpolative coding to every read and output to the binary file
+
+     \param[in] bitbuffer BitBuffer object to output to
+     \param[in] len Length of each read (if 0, then explicitly encode it)
+*/
+void QScoresBlock::ApplyCompressionInterP (BitBuffer &bitbuffer, unsigned int len) const {
+  vector<unsigned int> tmp;
+
+  for (unsigned int i = 0; i < GetNumReads (); i++) {
+    const unsigned char *values = GetRead (i);
+    unsigned int read_length = GetReadLength (i);
+
+    //  Delta encode the length of the read if explicitly asked to
+    if (len == 0) {
+      Delta_Encode (bitbuffer, read_length);
+    }
+
+    tmp.assign (values, values + read_length);
+    Interpolative_Encode (bitbuffer, tmp);
+  }
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Uncompression functions
+//  -----------------------------------------------------------------
+
+/*!
+     Unapply binary coding from a binary file and add the reads
+
+     \param[in] bitbuffer BitBuffer object to input from
+     \param[in] param Parameter to Binary coding (largest possible value)
+     \param[in] len Length of each read (if 0, then explicitly decode it)
+     \param[in] reads Number of reads to decode
+*/
+void QScoresBlock::UnapplyCompressionBinary (BitBuffer &bitbuffer, unsigned int param, unsigned int len, unsigned int reads) {
+  vector<unsigned int> tmp;
+
+  for (unsigned int i = 0; i < reads; i++) {
+    unsigned int read_length = len;
+
+    //  Delta decode the length of the read if explicitly asked to
+    if (len == 0) {
+      read_length = Delta_Decode (bitbuffer);
+    }
+
+    tmp.resize (read_length);
+    for (unsigned int j = 0; j < read_length; j++) {
+      tmp[j] = BinaryHigh_Decode (bitbuffer, param);
+    }
+    AddRead (tmp.data (), read_length);
+  }
+
+  return;
+}
+
+
+/*!
+     Unapply gamma coding from a binary file and add the reads
+
+     \param[in] bitbuffer BitBuffer object to input from
+     \param[in] len Length of each read (if 0, then explicitly decode it)
+     \param[in] reads Number of reads to decode
+*/
+void QScoresBlock::UnapplyCompressionGamma (BitBuffer &bitbuffer, unsigned int len, unsigned int reads) {
+  vector<unsigned int> tmp;
+
+  for (unsigned int i = 0; i < reads; i++) {
+    unsigned int read_length = len;
+
+    //  Delta decode the length of the read if explicitly asked to
+    if (len == 0) {
+      read_length = Delta_Decode (bitbuffer);
+    }
+
+    tmp.resize (read_length);
+    for (unsigned int j = 0; j < read_length; j++) {
+      tmp[j] = Gamma_Decode (bitbuffer);
+    }
+    AddRead (tmp.data (), read_length);
+  }
+
+  return;
+}
+
+
+/*!
+     Unapply delta coding from a binary file and add the reads
+
+     \param[in] bitbuffer BitBuffer object to input from
+     \param[in] len Length of each read (if 0, then explicitly decode it)
+     \param[in] reads Number of reads to decode
+*/
+void QScoresBlock::UnapplyCompressionDelta (BitBuffer &bitbuffer, unsigned int len, unsigned int reads) {
+  vector<unsigned int> tmp;
+
+  for (unsigned int i = 0; i < reads; i++) {
+    unsigned int read_length = len;
+
+    //  Delta decode the length of the read if explicitly asked to
+    if (len == 0) {
+      read_length = Delta_Decode (bitbuffer);
+    }
+
+    tmp.resize (read_length);
+    for (unsigned int j = 0; j < read_length; j++) {
+      tmp[j] = Delta_Decode (bitbuffer);
+    }
+    AddRead (tmp.data (), read_length);
+  }
+
+  return;
+}
+
+
+/*!
+     Unapply Golomb coding from a binary file and add the reads
+
+     \param[in] bitbuffer BitBuffer object to input from
+     \param[in] param Parameter to Golomb coding
+     \param[in] len Length of each read (if 0, then explicitly decode it)
+     \param[in] reads Number of reads to decode
+*/
+void QScoresBlock::UnapplyCompressionGolomb (BitBuffer &bitbuffer, unsigned int param, unsigned int len, unsigned int reads) {
+  vector<unsigned int> tmp;
+
+  for (unsigned int i = 0; i < reads; i++) {
+    unsigned int read_length = len;
+
+    //  Delta decode the length of the read if explicitly asked to
+    if (len == 0) {
+      read_length = Delta_Decode (bitbuffer);
+    }
+
+    tmp.resize (read_length);
+    for (unsigned int j = 0; j < read_length; j++) {
+      tmp[j] = Golomb_Decode (bitbuffer, param);
+    }
+    AddRead (tmp.data (), read_length);
+  }
+
+  return;
+}
+
+
+/*!
+     Unapply Rice coding from a binary file and add the reads
+
+     \param[in] bitbuffer BitBuffer object to input from
+     \param[in] param Parameter to Rice coding
+     \param[in] len Length of each read (if 0, then explicitly decode it)
+     \param[in] reads Number of reads to decode
+*/
+void QScoresBlock::UnapplyCompressionRice (BitBuffer &bitbuffer, unsigned int param, unsigned int len, unsigned int reads) {
+  vector<unsigned int> tmp;
+
+  for (unsigned int i = 0; i < reads; i++) {
+    unsigned int read_length = len;
+
+    //  Delta decode the length of the read if explicitly asked to
+    if (len == 0) {
+      read_length = Delta_Decode (bitbuffer);
+    }
+
+    tmp.resize (read_length);
+    for (unsigned int j = 0; j < read_length; j++) {
+      tmp[j] = Rice_Decode (bitbuffer, param);
+    }
+    AddRead (tmp.data (), read_length);
+  }
+
+  return;
+}
+
+
+/*!
+     Unapply interpolative coding from a binary file and add the reads
+
+     \param[in] bitbuffer BitBuffer object to input from
+     \param[in] len Length of each read (if 0, then explicitly decode it)
+     \param[in] reads Number of reads to decode
+*/
+void QScoresBlock::UnapplyCompressionInterP (BitBuffer &bitbuffer, unsigned int len, unsigned int reads) {
+  vector<unsigned int> tmp;
+
+  for (unsigned int i = 0; i < reads; i++) {
+    unsigned int read_length = len;
+
+    //  Delta decode the length of the read if explicitly asked to
+    if (len == 0) {
+      read_length = Delta_Decode (bitbuffer);
+    }
+
+    Interpolative_Decode (bitbuffer, tmp, read_length);
+    AddRead (tmp.data (), read_length);
+  }
+
+  return;
+}
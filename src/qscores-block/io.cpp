@@ -0,0 +1,143 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file io.cpp
+    Functions for adding and writing out the reads of a QScoresBlock.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <fstream>  //  ostream
+#include <iostream>
+#include <cstdlib>  //  exit, EXIT_FAILURE
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "qscores-block.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Friends
+//  -----------------------------------------------------------------
+
+
+/*!
+     Overloaded << operator defined as a friend of QScoresBlock to print the reads as
+     strings, each followed by a newline.
+
+     \param[in] os Output stream
+     \param[in] qb QScoresBlock passed as reference
+     \return Output stream
+*/
+ostream &operator<< (ostream &os, const QScoresBlock& qb) {
+  if (qb.GetNumReads () != 0) {
+    qb.WriteReads (os, 0, qb.GetNumReads () - 1);
+  }
+
+  return os;
+}
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+
+/*!
+     Add a read of quality scores as characters
+
+     \param[in] x The quality scores
+     \param[in] len The number of quality scores
+*/
+void QScoresBlock::AddRead (const char *x, unsigned int len) {
+  m_Values.insert (m_Values.end (), reinterpret_cast<const unsigned char *> (x), reinterpret_cast<const unsigned char *> (x) + len);
+  m_Offsets.push_back (m_Values.size ());
+
+  return;
+}
+
+
+/*!
+     Add a read of values which have been decoded
+
+     \param[in] x The values
+     \param[in] len The number of values
+*/
+void QScoresBlock::AddRead (const unsigned int *x, unsigned int len) {
+  unsigned long long start = m_Values.size ();
+
+  m_Values.resize (start + len);
+  for (unsigned int i = 0; i < len; i++) {
+    if (x[i] > g_QSCORES_BLOCK_VALUE_MAX) {
+      cerr << "EE\tThe decoded value " << x[i] << " is too large for a quality score." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_Values[start + i] = static_cast<unsigned char> (x[i]);
+  }
+  m_Offsets.push_back (m_Values.size ());
+
+  return;
+}
+
+
+/*!
+     Add reads of the same length whose values a decoder then fills in, sizing the
+     block once.  The last read is shorter if len is not a multiple of read_length.
+
+     \param[in] len The number of values
+     \param[in] read_length The length of each read
+     \return Pointer to the first of the len new values
+*/
+unsigned char *QScoresBlock::AddEmptyReads (unsigned long long len, unsigned int read_length) {
+  unsigned long long start = m_Values.size ();
+
+  m_Values.resize (start + len);
+  for (unsigned long long i = read_length; (read_length != 0) && (i < len); i += read_length) {
+    m_Offsets.push_back (start + i);
+  }
+  if (len != 0) {
+    m_Offsets.push_back (start + len);
+  }
+
+  return (m_Values.data () + start);
+}
+
+
+/*!
+     Write out a range of reads as strings, each followed by a newline.
+
+     \param[in] os Output stream
+     \param[in] first The first read to write (from 0)
+     \param[in] last The last read to write
+*/
+void QScoresBlock::WriteReads (ostream &os, unsigned int first, unsigned int last) const {
+  for (unsigned int i = first; i <= last; i++) {
+    os.write (reinterpret_cast<const char *> (GetRead (i)), GetReadLength (i));
+    os.put ('\n');
+  }
+
+  return;
+}
@@ -0,0 +1,196 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file qscores-block.cpp
+    Constructor and destructor for QScoresBlock class definition .
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <fstream>  //  ostream
+#include <iostream>
+#include <climits>  //  UINT_MAX
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "qscores-block.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Constructors and destructors
+//  -----------------------------------------------------------------
+
+
+/*!
+     Default constructor that takes one optional argument.
+
+     \param[in] debug Set to true if in debug mode; false by default
+*/
+QScoresBlock::QScoresBlock (bool debug)
+  : m_Debug (debug),
+    m_Values (),
+    m_Offsets (1, 0)
+{
+}
+
+
+/*!
+     Destructor that takes no arguments
+*/
+QScoresBlock::~QScoresBlock () {
+}
+
+
+/*!
+     Remove all of the reads.  The memory is kept for the next block.
+*/
+void QScoresBlock::Clear () {
+  m_Values.clear ();
+  m_Offsets.assign (1, 0);
+
+  return;
+}
+
+
+/*!
+     Exchange the reads with another block, without copying them.
+
+     \param[in,out] x The other block
+*/
+void QScoresBlock::Swap (QScoresBlock &x) {
+  m_Values.swap (x.m_Values);
+  m_Offsets.swap (x.m_Offsets);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Accessors
+//  -----------------------------------------------------------------
+
+/*!
+     Return m_Debug
+
+     \return Debug mode or not
+*/
+bool QScoresBlock::GetDebug () const {
+  return m_Debug;
+}
+
+
+/*!
+     Return the number of reads
+
+     \return Number of reads
+*/
+unsigned int QScoresBlock::GetNumReads () const {
+  return (m_Offsets.size () - 1);
+}
+
+
+/*!
+     Return the number of values in all of the reads
+
+     \return Number of values
+*/
+unsigned long long QScoresBlock::GetNumValues () const {
+  return (m_Values.size ());
+}
+
+
+/*!
+     Return the length of a read
+
+     \param[in] read The read (from 0)
+     \return Number of values in the read
+*/
+unsigned int QScoresBlock::GetReadLength (unsigned int read) const {
+  return (static_cast<unsigned int> (m_Offsets[read + 1] - m_Offsets[read]));
+}
+
+
+/*!
+     Return the values of a read
+
+     \param[in] read The read (from 0)
+     \return Pointer to the first value of the read
+*/
+const unsigned char *QScoresBlock::GetRead (unsigned int read) const {
+  return (m_Values.data () + m_Offsets[read]);
+}
+
+
+/*!
+     Return the smallest value of all of the reads
+
+     \return Minimum value; UINT_MAX if there are no values
+*/
+unsigned int QScoresBlock::GetMin () const {
+  unsigned int min = UINT_MAX;
+
+  for (unsigned long long i = 0; i < m_Values.size (); i++) {
+    if (m_Values[i] < min) {
+      min = m_Values[i];
+    }
+  }
+
+  return (min);
+}
+
+
+/*!
+     Return the largest value of all of the reads
+
+     \return Maximum value; 0 if there are no values
+*/
+unsigned int QScoresBlock::GetMax () const {
+  unsigned int max = 0;
+
+  for (unsigned long long i = 0; i < m_Values.size (); i++) {
+    if (m_Values[i] > max) {
+      max = m_Values[i];
+    }
+  }
+
+  return (max);
+}
+
+
+/*!
+     Return the sum of the values of all of the reads
+
+     \return Sum of the values
+*/
+unsigned long long QScoresBlock::GetSum () const {
+  unsigned long long sum = 0;
+
+  for (unsigned long long i = 0; i < m_Values.size (); i++) {
+    sum += m_Values[i];
+  }
+
+  return (sum);
+}
@@ -0,0 +1,132 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file qscores-block.hpp
+    Header file for QScoresBlock class.
+*/
+/*******************************************************************/
+
+#ifndef QSCORES_BLOCK_HPP
+#define QSCORES_BLOCK_HPP
+
+
+/*!
+     Largest value that can be stored.  The quality scores and the values produced by
+     every transformation of them must fit in a byte.
+*/
+const unsigned int g_QSCORES_BLOCK_VALUE_MAX = 0xFF;
+
+
+/*!
+    \class QScoresBlock
+
+    \details Class used to represent the quality scores of a block of reads.  All of the
+    values of the block are stored one after another in a single buffer of bytes, with
+    the offset of the start of each read in a second array.  Unlike a vector of
+    QScoresSingle objects, there is no string or vector for each read, so each value
+    takes one byte instead of five or more and a block is read, transformed, and coded
+    in passes over contiguous memory.
+
+    The same buffer holds the quality scores as characters before PreprocessBlock ()
+    and the transformed values afterwards; the values are checked to fit in a byte as
+    they are transformed.  The transformations which are applied across read boundaries
+    (such as difference coding) are done in a single pass over the whole buffer.
+
+    Each transformation can be applied on its own, but the encoder applies them all in
+    two passes:  ApplyMappingAndDifferenceCoding () for the lossy mapping and difference
+    coding, which also counts the values for the rescaling and remapping, and then
+    ApplyRescalingAndRemapping ().
+*/
+class QScoresBlock {
+  //  Friend function to print out the reads, one per line  [io.cpp]
+  friend ostream &operator<< (ostream &os, const QScoresBlock& qb);
+
+  public:
+    //  Constructors/destructors  [qscores-block.cpp]
+    QScoresBlock (bool debug=false);
+    ~QScoresBlock ();
+    void Clear ();
+    void Swap (QScoresBlock &x);
+
+    //  Accessors  [qscores-block.cpp]
+    bool GetDebug () const;
+    unsigned int GetNumReads () const;
+    unsigned long long GetNumValues () const;
+    unsigned int GetReadLength (unsigned int read) const;
+    const unsigned char *GetRead (unsigned int read) const;
+    unsigned int GetMin () const;
+    unsigned int GetMax () const;
+    unsigned long long GetSum () const;
+
+    //  Adding reads  [io.cpp]
+    void AddRead (const char *x, unsigned int len);
+    void AddRead (const unsigned int *x, unsigned int len);
+    unsigned char *AddEmptyReads (unsigned long long len, unsigned int read_length);
+    void WriteReads (ostream &os, unsigned int first, unsigned int last) const;
+
+    //  Lossy transformations  [transform.cpp]
+    void ApplyLossyMinTruncation (unsigned int param);
+    void ApplyLossyMaxTruncation (unsigned int param);
+    void ApplyLossyRemapping (const vector<unsigned int> &lookup);
+    void UnapplyLossyRemapping (const vector<unsigned int> &lookup);
+
+    //  Lossless transformations  [transform.cpp]
+    void ApplyDifferenceCoding ();
+    void ApplyRescaling (unsigned int k);
+    void ApplyLosslessRemapping (const vector<unsigned int> &lookup);
+    void UnapplyDifferenceCoding ();
+    void UnapplyRescaling (unsigned int k);
+    void UnapplyLosslessRemapping (const vector<unsigned int> &lookup);
+
+    //  Transformations fused into two passes over the block  [transform.cpp]
+    void ApplyMappingAndDifferenceCoding (const vector<unsigned int> &lookup, bool difference_coding, vector<unsigned long long> &counts);
+    void ApplyRescalingAndRemapping (unsigned int k, const vector<unsigned int> &lookup);
+
+    //  Compression functions  [compress.cpp]
+    void ApplyCompressionBinary (BitBuffer &bitbuffer, unsigned int param, unsigned int len) const;
+    void ApplyCompressionGamma (BitBuffer &bitbuffer, unsigned int len) const;
+    void ApplyCompressionDelta (BitBuffer &bitbuffer, unsigned int len) const;
+    void ApplyCompressionGolomb (BitBuffer &bitbuffer, unsigned int param, unsigned int len) const;
+    void ApplyCompressionRice (BitBuffer &bitbuffer, unsigned int param, unsigned int len) const;
+    void ApplyCompressionInterP (BitBuffer &bitbuffer, unsigned int len) const;
+    void UnapplyCompressionBinary (BitBuffer &bitbuffer, unsigned int param, unsigned int len, unsigned int reads);
+    void UnapplyCompressionGamma (BitBuffer &bitbuffer, unsigned int len, unsigned int reads);
+    void UnapplyCompressionDelta (BitBuffer &bitbuffer, unsigned int len, unsigned int reads);
+    void UnapplyCompressionGolomb (BitBuffer &bitbuffer, unsigned int param, unsigned int len, unsigned int reads);
+    void UnapplyCompressionRice (BitBuffer &bitbuffer, unsigned int param, unsigned int len, unsigned int reads);
+    void UnapplyCompressionInterP (BitBuffer &bitbuffer, unsigned int len, unsigned int reads);
+  private:
+    //  Lossless transformations  [transform.cpp]
+    void ApplyLookup (const vector<unsigned int> &lookup, unsigned int shift);
+
+    //!  Debug mode?
+    bool m_Debug;
+
+    //!  Values of all of the reads, one after another
+    vector<unsigned char> m_Values;
+    //!  Offset of the start of each read in m_Values, followed by the number of values
+    vector<unsigned long long> m_Offsets;
+};
+
+#endif
@@ -0,0 +1,273 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file testing.cpp
+    Testing functions of main-test.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <string>
+#include <fstream>  //  ostream
+#include <sstream>  //  ostringstream
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+#include <climits>  //  UINT_MAX
+
+using namespace std;
+
+#include "QScoresBlock_Config.hpp"
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "qscores-block.hpp"
+#include "testing.hpp"
+
+
+/*!
+     Generate a block of random reads of printable quality scores
+
+     \param[out] block The block to add the reads to
+     \param[out] text The reads, each followed by a newline
+*/
+void RandomBlock (QScoresBlock &block, string &text) {
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  for (unsigned int i = 0; i < g_TEST_SIZE; i++) {
+    string read;
+    for (unsigned int j = 0; j < g_TEST_READ_LENGTH; j++) {
+      read += static_cast<char> ('!' + (rand () % 94));
+    }
+    block.AddRead (read.data (), read.length ());
+    text += read + '\n';
+  }
+
+  return;
+}
+
+
+/*!
+     Show basic information about the program
+
+     \return Always returns true
+*/
+bool ShowInfo () {
+  cout << "QScoresBlock version " << QSCORESBLOCK_PROGRAM_VERSION << " compiled on:  " << __DATE__ <<  " (" << __TIME__ << ")" << endl;
+  cout << "Git hash:  " << QSCORESBLOCK_GIT_HASH << endl;
+
+  cout << "II\tShowInfo successful!" << endl;
+
+  return (true);
+}
+
+
+/*!
+     Add reads of different lengths, including an empty one, and check that they are
+     written out the same.  Then add reads for a decoder to fill in.
+
+     \return true if the test was successful; false otherwise
+*/
+bool QScoresBlockAddReads () {
+  QScoresBlock block;
+  vector<unsigned int> values = {73, 73, 36, 73};
+  ostringstream out;
+
+  block.AddRead ("!!!~n(~", 7);
+  block.AddRead ("", 0);
+  block.AddRead (values.data (), values.size ());
+  out << block;
+
+  if ((out.str () != "!!!~n(~\n\nII$I\n") || (block.GetNumReads () != 3) || (block.GetNumValues () != 11) ||
+      (block.GetReadLength (1) != 0) || (block.GetMin () != '!') || (block.GetMax () != '~')) {
+    cerr << "EE\tAdding reads unsuccessful!" << endl;
+    return (false);
+  }
+
+  unsigned char *empty = block.AddEmptyReads (5, 2);
+  for (unsigned int i = 0; i < 5; i++) {
+    empty[i] = 'A' + i;
+  }
+  out.str ("");
+  block.WriteReads (out, 3, block.GetNumReads () - 1);
+  if ((out.str () != "AB\nCD\nE\n") || (block.GetNumReads () != 6) || (block.GetNumValues () != 16)) {
+    cerr << "EE\tAdding empty reads unsuccessful!" << endl;
+    return (false);
+  }
+
+  QScoresBlock other;
+  other.Swap (block);
+  block.Clear ();
+  if ((other.GetNumReads () != 6) || (block.GetNumReads () != 0)) {
+    cerr << "EE\tSwapping blocks unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tAdding reads successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Apply the gap transformation and rescaling to two copies of a read and then undo
+     them.
+
+     \param[in] str Input quality score
+     \return true if the test was successful; false otherwise
+*/
+bool QScoresBlockTransforms (string str) {
+  QScoresBlock block;
+  ostringstream out;
+
+  block.AddRead (str.data (), str.length ());
+  block.AddRead (str.data (), str.length ());
+
+  block.ApplyDifferenceCoding ();
+  unsigned int min = block.GetMin ();
+  block.ApplyRescaling (min);
+  if (block.GetMin () != 1) {
+    cerr << "EE\tRescaling did not make the values 1-based!" << endl;
+    return (false);
+  }
+
+  block.UnapplyRescaling (min);
+  block.UnapplyDifferenceCoding ();
+  out << block;
+
+  if (out.str () != str + '\n' + str + '\n') {
+    cerr << "EE\tTransformations of " << str << " unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tTransformations of " << str << " successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Encode a block of random reads with each static code, decode them, and compare.
+     The reads of the last code have their lengths encoded.
+
+     \return true if the test was successful; false otherwise
+*/
+bool QScoresBlockStaticCodes () {
+  string str = "tmp.data";  //  Input/output filename
+  QScoresBlock block;
+  string text;
+  unsigned int max = 0;
+
+  RandomBlock (block, text);
+  max = block.GetMax ();
+
+  //  Test encoding
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  block.ApplyCompressionBinary (bitbuff_out, max, g_TEST_READ_LENGTH);
+  block.ApplyCompressionGamma (bitbuff_out, g_TEST_READ_LENGTH);
+  block.ApplyCompressionDelta (bitbuff_out, g_TEST_READ_LENGTH);
+  block.ApplyCompressionGolomb (bitbuff_out, 50, g_TEST_READ_LENGTH);
+  block.ApplyCompressionRice (bitbuff_out, 5, g_TEST_READ_LENGTH);
+  block.ApplyCompressionInterP (bitbuff_out, 0);
+  bitbuff_out.Finish ();
+
+  //  Test decoding
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  vector<QScoresBlock> decoded (6);
+  decoded[0].UnapplyCompressionBinary (bitbuff_in, max, g_TEST_READ_LENGTH, g_TEST_SIZE);
+  decoded[1].UnapplyCompressionGamma (bitbuff_in, g_TEST_READ_LENGTH, g_TEST_SIZE);
+  decoded[2].UnapplyCompressionDelta (bitbuff_in, g_TEST_READ_LENGTH, g_TEST_SIZE);
+  decoded[3].UnapplyCompressionGolomb (bitbuff_in, 50, g_TEST_READ_LENGTH, g_TEST_SIZE);
+  decoded[4].UnapplyCompressionRice (bitbuff_in, 5, g_TEST_READ_LENGTH, g_TEST_SIZE);
+  decoded[5].UnapplyCompressionInterP (bitbuff_in, 0, g_TEST_SIZE);
+  bitbuff_in.Finish ();
+
+  for (unsigned int i = 0; i < decoded.size (); i++) {
+    ostringstream out;
+    out << decoded[i];
+    if (out.str () != text) {
+      cerr << "EE\tStatic code " << i << " of the block unsuccessful!" << endl;
+      return (false);
+    }
+  }
+
+  cerr << "II\tStatic codes of the block successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Apply a lossy mapping, difference coding, rescaling, and remapping to a block of random
+     reads, once with the fused transformations and once with each transformation on its
+     own, and compare.
+
+     \return true if the test was successful; false otherwise
+*/
+bool QScoresBlockFused () {
+  QScoresBlock fused;
+  string text;
+  vector<unsigned int> lossy (g_QSCORES_BLOCK_VALUE_MAX + 1);
+  vector<unsigned int> lossless (g_QSCORES_BLOCK_VALUE_MAX + 1);
+  vector<unsigned long long> counts;
+
+  RandomBlock (fused, text);
+  QScoresBlock separate;
+  for (unsigned int i = 0; i < fused.GetNumReads (); i++) {
+    separate.AddRead (reinterpret_cast<const char *> (fused.GetRead (i)), fused.GetReadLength (i));
+  }
+
+  //  Round down to a multiple of 4 and reverse the order of the values
+  for (unsigned int i = 0; i <= g_QSCORES_BLOCK_VALUE_MAX; i++) {
+    lossy[i] = i - (i % 4);
+    lossless[i] = g_QSCORES_BLOCK_VALUE_MAX - i;
+  }
+
+  fused.ApplyMappingAndDifferenceCoding (lossy, true, counts);
+  unsigned int min = 0;
+  while (counts[min] == 0) {
+    min++;
+  }
+  fused.ApplyRescalingAndRemapping (min, lossless);
+
+  separate.ApplyLossyRemapping (lossy);
+  separate.ApplyDifferenceCoding ();
+  if (separate.GetMin () != min) {
+    cerr << "EE\tThe minimum of the fused transformations is " << min << " instead of " << separate.GetMin () << "!" << endl;
+    return (false);
+  }
+  separate.ApplyRescaling (min);
+  separate.ApplyLosslessRemapping (lossless);
+
+  ostringstream out_fused;
+  ostringstream out_separate;
+  out_fused << fused;
+  out_separate << separate;
+  if (out_fused.str () != out_separate.str ()) {
+    cerr << "EE\tFused transformations unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\tFused transformations successful!" << endl;
+  return (true);
+}
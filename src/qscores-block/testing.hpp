@@ -0,0 +1,46 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file testing.hpp
+    Header file for testing functions of main-test.
+*/
+/*******************************************************************/
+
+
+#ifndef TESTING_HPP
+#define TESTING_HPP
+
+//!  The number of reads to generate for the random tests
+const unsigned int g_TEST_SIZE = 1000;
+
+//!  The length of the reads of the random tests
+const unsigned int g_TEST_READ_LENGTH = 100;
+
+bool ShowInfo ();
+bool QScoresBlockAddReads ();
+bool QScoresBlockTransforms (string str);
+bool QScoresBlockStaticCodes ();
+bool QScoresBlockFused ();
+
+#endif
@@ -0,0 +1,399 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file transform.cpp
+    Lossy and lossless transformation functions for QScoresBlock class.
+*/
+/*******************************************************************/
+
+#include <vector>
+#include <fstream>  //  ostream
+#include <iostream>
+#include <cstdlib>  //  exit, EXIT_FAILURE
+#include <climits>  //  UINT_MAX
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "qscores-block.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Lossy transformation functions
+//  -----------------------------------------------------------------
+
+/*!
+     Change all low quality score values to the given value.
+
+     \param[in] param The value that low values are to be changed to (where "low values" refers to values below this threshold).
+*/
+void QScoresBlock::ApplyLossyMinTruncation (unsigned int param) {
+  if (param > g_QSCORES_BLOCK_VALUE_MAX) {
+    cerr << "EE\tThe minimum truncation value (" << param << ") is too large for a quality score." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  for (unsigned long long i = 0; i < m_Values.size (); i++) {
+    if (m_Values[i] < param) {
+      m_Values[i] = static_cast<unsigned char> (param);
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Change all high quality score values to the given value.
+
+     \param[in] param The value that high values are to be changed to (where "high values" refers to values above this threshold).
+*/
+void QScoresBlock::ApplyLossyMaxTruncation (unsigned int param) {
+  for (unsigned long long i = 0; i < m_Values.size (); i++) {
+    if (m_Values[i] > param) {
+      m_Values[i] = static_cast<unsigned char> (param);
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Remap quality scores using the given lookup table.
+
+     \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
+*/
+void QScoresBlock::ApplyLossyRemapping (const vector<unsigned int> &lookup) {
+  ApplyLookup (lookup, 0);
+
+  return;
+}
+
+
+/*!
+     Remap the quality scores back using the given lookup table.
+
+     \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
+*/
+void QScoresBlock::UnapplyLossyRemapping (const vector<unsigned int> &lookup) {
+  ApplyLookup (lookup, 0);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Lossless transformation functions
+//  -----------------------------------------------------------------
+
+/*!
+     Apply difference coding to all of the reads, as one sequence.  The first value is
+     kept as it is; every other value is replaced by its difference from the value before
+     it (which is the last value of the previous read at the start of a read).  Positive
+     differences are mapped to odd numbers and negative ones to even numbers.  Finally, 1
+     is added to every value to prevent 0's.
+*/
+void QScoresBlock::ApplyDifferenceCoding () {
+  if (m_Values.empty ()) {
+    return;
+  }
+
+  unsigned int largest = m_Values[0] + 1;
+  int previous = m_Values[0];
+  m_Values[0] = static_cast<unsigned char> (m_Values[0] + 1);
+  for (unsigned long long i = 1; i < m_Values.size (); i++) {
+    int value = static_cast<int> (m_Values[i]) - previous;
+    previous = m_Values[i];
+
+    //  positive values are in odd positions and negative values are in even positions
+    unsigned int mapped = (value > 0) ? (2 * static_cast<unsigned int> (value) - 1) : (2 * static_cast<unsigned int> (-value));
+    mapped++;
+    largest = (mapped > largest) ? mapped : largest;
+    m_Values[i] = static_cast<unsigned char> (mapped);
+  }
+
+  if (largest > g_QSCORES_BLOCK_VALUE_MAX) {
+    cerr << "EE\tThe differences between the quality scores are too large for the gap transformation." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  return;
+}
+
+
+/*!
+     Subtract a constant from every value to make them 1-based.
+
+     \param[in] k The value to subtract off
+*/
+void QScoresBlock::ApplyRescaling (unsigned int k) {
+  for (unsigned long long i = 0; i < m_Values.size (); i++) {
+    if (m_Values[i] < k) {
+      cerr << "EE\tThe value (" << k << ") being subtracted from (" << static_cast<unsigned int> (m_Values[i]) << ") is too large." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_Values[i] = static_cast<unsigned char> (m_Values[i] - k + 1);
+  }
+
+  return;
+}
+
+
+/*!
+     Remap quality scores using the given lookup table.  (Function is identical to ApplyLossyRemapping ().)
+
+     \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
+*/
+void QScoresBlock::ApplyLosslessRemapping (const vector<unsigned int> &lookup) {
+  ApplyLookup (lookup, 0);
+
+  return;
+}
+
+
+/*!
+     Reverse the steps performed by ApplyDifferenceCoding ().
+*/
+void QScoresBlock::UnapplyDifferenceCoding () {
+  if (m_Values.empty ()) {
+    return;
+  }
+
+  bool valid = (m_Values[0] != 0);
+  int previous = m_Values[0] - 1;
+  m_Values[0] = static_cast<unsigned char> (previous);
+  for (unsigned long long i = 1; i < m_Values.size (); i++) {
+    int value = static_cast<int> (m_Values[i]) - 1;
+
+    //  odd positions are positive values and even positions are negative values
+    int difference = (value % 2 != 0) ? ((value + 1) / 2) : (-value / 2);
+    previous += difference;
+    valid = valid && (value >= 0) && (previous >= 0) && (previous <= static_cast<int> (g_QSCORES_BLOCK_VALUE_MAX));
+    m_Values[i] = static_cast<unsigned char> (previous);
+  }
+
+  if (!valid) {
+    cerr << "EE\tThe gap transformation could not be reversed." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  return;
+}
+
+
+/*!
+     Reverse the steps performed by ApplyRescaling ().
+
+     \param[in] k The value to subtract off
+*/
+void QScoresBlock::UnapplyRescaling (unsigned int k) {
+  for (unsigned long long i = 0; i < m_Values.size (); i++) {
+    if (m_Values[i] + k - 1 > g_QSCORES_BLOCK_VALUE_MAX) {
+      cerr << "EE\tThe value (" << k << ") being added back is too large." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_Values[i] = static_cast<unsigned char> (m_Values[i] + k - 1);
+  }
+
+  return;
+}
+
+
+/*!
+     Reverse the steps performed by ApplyLosslessRemapping ().
+
+     \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
+*/
+void QScoresBlock::UnapplyLosslessRemapping (const vector<unsigned int> &lookup) {
+  //  Since the prelude was encoded with 1 added to each value, we need to subtract 1 here
+  ApplyLookup (lookup, 1);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Fused transformation functions
+//  -----------------------------------------------------------------
+
+/*!
+     Apply a lossy mapping and then difference coding in one pass, counting how many
+     times each of the resulting values occurs.  The counts give both the minimum for
+     ApplyRescalingAndRemapping () and the statistics for lossless remapping, so no other
+     pass is needed to find them.  The result is the same as ApplyLossyRemapping ()
+     followed by ApplyDifferenceCoding ().
+
+     \param[in] lookup The lossy lookup table; if empty, the values are not mapped
+     \param[in] difference_coding Whether to apply difference coding
+     \param[out] counts The number of times each value occurs afterwards, indexed by value
+*/
+void QScoresBlock::ApplyMappingAndDifferenceCoding (const vector<unsigned int> &lookup, bool difference_coding, vector<unsigned long long> &counts) {
+  unsigned char table[g_QSCORES_BLOCK_VALUE_MAX + 1];
+  unsigned char valid[g_QSCORES_BLOCK_VALUE_MAX + 1];
+
+  for (unsigned int v = 0; v <= g_QSCORES_BLOCK_VALUE_MAX; v++) {
+    table[v] = static_cast<unsigned char> (v);
+    valid[v] = 1;
+    if (!lookup.empty ()) {
+      table[v] = 0;
+      valid[v] = 0;
+      if ((v < lookup.size ()) && (lookup[v] <= g_QSCORES_BLOCK_VALUE_MAX)) {
+        table[v] = static_cast<unsigned char> (lookup[v]);
+        valid[v] = 1;
+      }
+    }
+  }
+
+  //  Values are counted in 4 tables in turn, so that repeated values do not wait for each other
+  unsigned char *values = m_Values.data ();
+  unsigned long long num_values = m_Values.size ();
+  unsigned long long partial[4][g_QSCORES_BLOCK_VALUE_MAX + 1] = {};
+  unsigned char all_valid = 1;
+  unsigned long long i = 0;
+  if (!difference_coding) {
+    for (; i < num_values; i++) {
+      all_valid &= valid[values[i]];
+      values[i] = table[values[i]];
+      partial[i % 4][values[i]]++;
+    }
+  }
+  else if (num_values != 0) {
+    //  As in ApplyDifferenceCoding (), the first value is kept as it is
+    all_valid &= valid[values[0]];
+    int previous = table[values[0]];
+    unsigned int largest = previous + 1;
+    values[0] = static_cast<unsigned char> (previous + 1);
+    partial[0][values[0]]++;
+    for (i = 1; i < num_values; i++) {
+      all_valid &= valid[values[i]];
+      int current = table[values[i]];
+      int value = previous - current;
+      previous = current;
+
+      //  positive differences are in odd positions and negative ones are in even positions
+      unsigned int mapped = ((static_cast<unsigned int> (value) << 1) ^ static_cast<unsigned int> (value >> 31)) + 1;
+      largest = (mapped > largest) ? mapped : largest;
+      values[i] = static_cast<unsigned char> (mapped);
+      partial[i % 4][values[i]]++;
+    }
+
+    if (largest > g_QSCORES_BLOCK_VALUE_MAX) {
+      cerr << "EE\tThe differences between the quality scores are too large for the gap transformation." << endl;
+      exit (EXIT_FAILURE);
+    }
+  }
+
+  counts.assign (g_QSCORES_BLOCK_VALUE_MAX + 1, 0);
+  for (unsigned int v = 0; v <= g_QSCORES_BLOCK_VALUE_MAX; v++) {
+    counts[v] = partial[0][v] + partial[1][v] + partial[2][v] + partial[3][v];
+  }
+
+  if (!all_valid) {
+    cerr << "EE\tA quality score could not be remapped." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  return;
+}
+
+
+/*!
+     Apply rescaling and then lossless remapping in one pass, by looking up each value in
+     a single table that does both.  The result is the same as ApplyRescaling () followed
+     by ApplyLosslessRemapping ().
+
+     \param[in] k The value to subtract off; if 0, the values are not rescaled
+     \param[in] lookup The lossless lookup table; if empty, the values are not remapped
+*/
+void QScoresBlock::ApplyRescalingAndRemapping (unsigned int k, const vector<unsigned int> &lookup) {
+  if ((k == 0) && (lookup.empty ())) {
+    return;
+  }
+
+  //  Values which cannot be rescaled or remapped are left out of the table
+  vector<unsigned int> table (g_QSCORES_BLOCK_VALUE_MAX + 1, UINT_MAX);
+  for (unsigned int v = 0; v <= g_QSCORES_BLOCK_VALUE_MAX; v++) {
+    unsigned int rescaled = v;
+    if (k != 0) {
+      if (v < k) {
+        continue;
+      }
+      rescaled = v - k + 1;
+    }
+
+    if (lookup.empty ()) {
+      table[v] = rescaled;
+    }
+    else if (rescaled < lookup.size ()) {
+      table[v] = lookup[rescaled];
+    }
+  }
+  ApplyLookup (table, 0);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Replace every value v with lookup[v - shift].  The lookup table is first copied into
+     a table of bytes indexed by v, so that checking that every value can be remapped
+     does not need a branch per value.
+
+     \param[in] lookup The lookup table
+     \param[in] shift The amount to subtract from a value to find its entry
+*/
+void QScoresBlock::ApplyLookup (const vector<unsigned int> &lookup, unsigned int shift) {
+  unsigned char table[g_QSCORES_BLOCK_VALUE_MAX + 1];
+  unsigned char valid[g_QSCORES_BLOCK_VALUE_MAX + 1];
+
+  for (unsigned int v = 0; v <= g_QSCORES_BLOCK_VALUE_MAX; v++) {
+    table[v] = 0;
+    valid[v] = 0;
+    if ((v >= shift) && (v - shift < lookup.size ()) && (lookup[v - shift] <= g_QSCORES_BLOCK_VALUE_MAX)) {
+      table[v] = static_cast<unsigned char> (lookup[v - shift]);
+      valid[v] = 1;
+    }
+  }
+
+  unsigned char *values = m_Values.data ();
+  unsigned long long num_values = m_Values.size ();
+  unsigned char all_valid = 1;
+  for (unsigned long long i = 0; i < num_values; i++) {
+    all_valid &= valid[values[i]];
+    values[i] = table[values[i]];
+  }
+
+  if (!all_valid) {
+    cerr << "EE\tA quality score could not be remapped." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  return;
+}
@@ -410,6 +410,36 @@ bool QScoresSettings::GetCompressionRepair () const {
 }
 
 
+/*!
+     Get the zstd compression setting.
+
+     \return Boolean value representing the setting.
+*/
+bool QScoresSettings::GetCompressionZstd () const {
+  return (m_CompressionZstd);
+}
+
+
+/*!
+     Get the xz/LZMA compression setting.
+
+     \return Boolean value representing the setting.
+*/
+bool QScoresSettings::GetCompressionLzma () const {
+  return (m_CompressionLzma);
+}
+
+
+/*!
+     Get the Brotli compression setting.
+
+     \return Boolean value representing the setting.
+*/
+bool QScoresSettings::GetCompressionBrotli () const {
+  return (m_CompressionBrotli);
+}
+
+
 /*!
      Get the PPM compression setting.
 
@@ -440,3 +470,83 @@ unsigned int QScoresSettings::GetCompressionGlobalParameter () const {
 }
 
 
+/*!
+     Get the number of interleaved streams for Huffman coding
+
+     \return Number of streams
+*/
+unsigned int QScoresSettings::GetCompressionStreams () const {
+  return (m_CompressionStreams);
+}
+
+
+/*!
+     Get the longest Huffman codeword allowed
+
+     \return Length in bits; 0 if there is no limit
+*/
+unsigned int QScoresSettings::GetCompressionCodewordLimit () const {
+  return (m_CompressionCodewordLimit);
+}
+
+
+/*!
+     Get whether arithmetic coding uses a context model.
+
+     eturn Boolean value representing the setting.
+*/
+bool QScoresSettings::GetCompressionContext () const {
+  return (m_CompressionContext);
+}
+
+
+/*!
+     Get the level for zstd
+
+     \return Level
+*/
+int QScoresSettings::GetCompressionZstdLevel () const {
+  return (m_CompressionZstdLevel);
+}
+
+
+/*!
+     Get whether zstd uses a dictionary trained on the first block.
+
+     \return Boolean value representing the setting.
+*/
+bool QScoresSettings::GetCompressionDictionary () const {
+  return (m_CompressionDictionary);
+}
+
+
+/*!
+     Get whether gzip or bzip2 split each block into chunks which are compressed independently.
+
+     \return Boolean value representing the setting.
+*/
+bool QScoresSettings::GetCompressionChunked () const {
+  return (m_CompressionChunked);
+}
+
+
+
+
+/*!
+     Get the block index setting.
+
+     \return Boolean value representing the setting.
+*/
+bool QScoresSettings::GetBlockIndex () const {
+  return (m_BlockIndex);
+}
+
+
+/*!
+     Get the byte-aligned blocks setting.
+
+     \return Boolean value representing the setting.
+*/
+bool QScoresSettings::GetAlignBlocks () const {
+  return (m_AlignBlocks);
+}
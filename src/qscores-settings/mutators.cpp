@@ -317,6 +317,33 @@ void QScoresSettings::SetCompressionRepair () {
 }
 
 
+/*!
+     Indicate that zstd is used.
+*/
+void QScoresSettings::SetCompressionZstd () {
+  m_CompressionZstd = true;
+  return;
+}
+
+
+/*!
+     Indicate that xz/LZMA is used.
+*/
+void QScoresSettings::SetCompressionLzma () {
+  m_CompressionLzma = true;
+  return;
+}
+
+
+/*!
+     Indicate that Brotli is used.
+*/
+void QScoresSettings::SetCompressionBrotli () {
+  m_CompressionBrotli = true;
+  return;
+}
+
+
 /*!
      Indicate that PPM is used.
 */
@@ -346,3 +373,81 @@ void QScoresSettings::SetCompressionGlobalParameter (unsigned int x) {
 }
 
 
+/*!
+     Set the number of interleaved streams for Huffman coding
+
+     \param[in] x Number of streams
+*/
+void QScoresSettings::SetCompressionStreams (unsigned int x) {
+  m_CompressionStreams = x;
+  return;
+}
+
+
+/*!
+     Set the longest Huffman codeword allowed
+
+     \param[in] x Length in bits; 0 for no limit
+*/
+void QScoresSettings::SetCompressionCodewordLimit (unsigned int x) {
+  m_CompressionCodewordLimit = x;
+  return;
+}
+
+
+/*!
+     Indicate that arithmetic coding uses a context model.
+*/
+void QScoresSettings::SetCompressionContext () {
+  m_CompressionContext = true;
+  return;
+}
+
+
+/*!
+     Set the level for zstd
+
+     \param[in] x Level
+*/
+void QScoresSettings::SetCompressionZstdLevel (int x) {
+  m_CompressionZstdLevel = x;
+  return;
+}
+
+
+/*!
+     Indicate that zstd uses a dictionary trained on the first block.
+*/
+void QScoresSettings::SetCompressionDictionary () {
+  m_CompressionDictionary = true;
+  return;
+}
+
+
+/*!
+     Indicate that gzip or bzip2 split each block into chunks which are compressed independently.
+*/
+void QScoresSettings::SetCompressionChunked () {
+  m_CompressionChunked = true;
+  return;
+}
+
+
+
+
+/*!
+     Indicate that a block index is added to the end of the archive.
+*/
+void QScoresSettings::SetBlockIndex () {
+  m_BlockIndex = true;
+  return;
+}
+
+
+/*!
+     Indicate that each block starts at a whole byte and is preceded by its length.
+*/
+void QScoresSettings::SetAlignBlocks () {
+  m_AlignBlocks = true;
+  return;
+}
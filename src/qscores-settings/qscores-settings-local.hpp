@@ -36,7 +36,7 @@ const int g_ERRPROB_BINNING_MAX = 10000000;
 //!  Compression method bitmask:  1111 1111 0000 0000
 const unsigned int g_COMPRESSION_METHOD_BITMASK = 65280;  
 
-//!  Lossless transformation bitmask:  1111 0000
+//!  Lossless transformation bitmask:  1111 0000 (including the block index)
 const unsigned int g_LOSSLESS_TRANSFORM_BITMASK = 240;
 
 //!  Lossy transformation bitmask:  1100
@@ -51,9 +51,11 @@ const unsigned int g_MAPPING_BITMASK = 3;
      Position of QScores settings when output in binary format.
      
      Currently takes 16 bits:
-       AAAAAAAA BBBB CC DD
+       AAAAAAAA EBBB CC DD
        
      A:  Compression method
+     E:  Byte-aligned blocks, each preceded by its length; if set, one more bit follows
+         the 16 bits to indicate a block index (see QScores::EncodeBlockIndex ())
      B:  Lossless transformation
      C:  Lossy transformations (at most one)
      D:  Quality scores mapping (at most one)
@@ -69,6 +71,7 @@ enum e_QSCORES_BINARY_SETTINGS {
   e_QSCORES_BINARY_SETTINGS_LOSSLESS_DIFF = 16,  /*!< Difference coding transformation */
   e_QSCORES_BINARY_SETTINGS_LOSSLESS_RESCALING = 32,  /*!< Re-scaling transformation */
   e_QSCORES_BINARY_SETTINGS_LOSSLESS_REMAPPING = 64,  /*!< Frequency-based remapping transformation */
+  e_QSCORES_BINARY_SETTINGS_ALIGN_BLOCKS = 128,  /*!< Byte-aligned blocks */
   e_QSCORES_BINARY_SETTINGS_COMP_BINARY = 256,  /*!< Binary compression - 0000 0001 */  
   e_QSCORES_BINARY_SETTINGS_COMP_GAMMA = 512,  /*!< Gamma compression - 0000 0010 */
   e_QSCORES_BINARY_SETTINGS_COMP_DELTA = 768,  /*!< Delta compression - 0000 0011 */
@@ -77,9 +80,19 @@ enum e_QSCORES_BINARY_SETTINGS {
   e_QSCORES_BINARY_SETTINGS_COMP_INTERP = 2048,  /*!< Interpolative coding - 0000 1000 */
   e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN = 8192,  /*!< Huffman coding - 0010 0000 */
   e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC = 8448,  /*!< Arithmetic coding - 0010 0001 */  
+  e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN_4 = 8704,  /*!< Huffman coding, 4 interleaved streams - 0010 0010 */
+  e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN_8 = 8960,  /*!< Huffman coding, 8 interleaved streams - 0010 0011 */
+  e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC_32 = 9216,  /*!< Arithmetic coding, 32 interleaved states - 0010 0100 */
+  e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC_CONTEXT = 9472,  /*!< Arithmetic coding, context-modelled - 0010 0101 */
   e_QSCORES_BINARY_SETTINGS_COMP_GZIP = 16384,  /*!< gzip - 0100 0000 */
   e_QSCORES_BINARY_SETTINGS_COMP_BZIP = 16640,  /*!< bzip2 - 0100 0001 */
   e_QSCORES_BINARY_SETTINGS_COMP_REPAIR = 16896,  /*!< Re-Pair - 0100 0010 */
+  e_QSCORES_BINARY_SETTINGS_COMP_ZSTD = 17152,  /*!< zstd - 0100 0011 */
+  e_QSCORES_BINARY_SETTINGS_COMP_ZSTD_DICTIONARY = 17408,  /*!< zstd with a trained dictionary - 0100 0100 */
+  e_QSCORES_BINARY_SETTINGS_COMP_LZMA = 17664,  /*!< xz/LZMA - 0100 0101 */
+  e_QSCORES_BINARY_SETTINGS_COMP_BROTLI = 17920,  /*!< Brotli - 0100 0110 */
+  e_QSCORES_BINARY_SETTINGS_COMP_GZIP_CHUNKED = 18176,  /*!< gzip, in chunks compressed independently - 0100 0111 */
+  e_QSCORES_BINARY_SETTINGS_COMP_BZIP_CHUNKED = 18432,  /*!< bzip2, in chunks compressed independently - 0100 1000 */
   e_QSCORES_BINARY_SETTINGS_COMP_NONE = 65024,  /*!< No compression - 1111 1110 */
   e_QSCORES_BINARY_SETTINGS_LAST = 65535  /*!< Upper boundary of enumerated type - 1111 1111 1111 1111 */
 };
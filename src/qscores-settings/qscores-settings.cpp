@@ -75,12 +75,23 @@ QScoresSettings::QScoresSettings ()
     m_CompressionInterP (false),
     m_CompressionGlobalParameter (g_DEFAULT_GOLOMB_RICE_PARAM),
     m_CompressionHuffman (false),
+    m_CompressionStreams (g_DEFAULT_HUFFMAN_STREAMS),
+    m_CompressionCodewordLimit (g_DEFAULT_HUFFMAN_CODEWORD_LIMIT),
     m_CompressionArithmetic (false),
+    m_CompressionContext (false),
     m_CompressionGzip (false),
     m_CompressionBzip (false),
     m_CompressionRepair (false),
+    m_CompressionZstd (false),
+    m_CompressionZstdLevel (g_DEFAULT_ZSTD_LEVEL),
+    m_CompressionDictionary (false),
+    m_CompressionChunked (false),
+    m_CompressionLzma (false),
+    m_CompressionBrotli (false),
     m_CompressionPPM (false),
-    m_CompressionNone (false)
+    m_CompressionNone (false),
+    m_AlignBlocks (false),
+    m_BlockIndex (false)
 {
 }
 
@@ -167,9 +178,15 @@ ostream &operator<< (ostream &os, const QScoresSettings& qs) {
   }
   if (qs.GetCompressionHuffman ()) {
     os << left << setw (g_VERBOSE_WIDTH) << "II\t  Huffman coding:" << (qs.GetCompressionHuffman () == true ? "Yes" : "No") << endl;
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Huffman streams:" << (qs.GetCompressionStreams ()) << endl;
+    if (qs.GetCompressionCodewordLimit () != g_DEFAULT_HUFFMAN_CODEWORD_LIMIT) {
+      os << left << setw (g_VERBOSE_WIDTH) << "II\t  Longest codeword:" << (qs.GetCompressionCodewordLimit ()) << endl;
+    }
   }
   if (qs.GetCompressionArithmetic ()) {
     os << left << setw (g_VERBOSE_WIDTH) << "II\t  Arithmetic coding:" << (qs.GetCompressionArithmetic () == true ? "Yes" : "No") << endl;
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Arithmetic streams:" << (qs.GetCompressionStreams ()) << endl;
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Context modelling:" << (qs.GetCompressionContext () == true ? "Yes" : "No") << endl;
   }
   if (qs.GetCompressionGzip ()) {
     os << left << setw (g_VERBOSE_WIDTH) << "II\t  Gzip:" << (qs.GetCompressionGzip () == true ? "Yes" : "No") << endl;
@@ -177,9 +194,23 @@ ostream &operator<< (ostream &os, const QScoresSettings& qs) {
   if (qs.GetCompressionBzip ()) {
     os << left << setw (g_VERBOSE_WIDTH) << "II\t  Bzip:" << (qs.GetCompressionBzip () == true ? "Yes" : "No") << endl;
   }
+  if (qs.GetCompressionChunked ()) {
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Chunked:" << (qs.GetCompressionChunked () == true ? "Yes" : "No") << endl;
+  }
   if (qs.GetCompressionRepair ()) {
     os << left << setw (g_VERBOSE_WIDTH) << "II\t  Re-Pair:" << (qs.GetCompressionRepair () == true ? "Yes" : "No") << endl;
   }
+  if (qs.GetCompressionZstd ()) {
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Zstd:" << (qs.GetCompressionZstd () == true ? "Yes" : "No") << endl;
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Zstd level:" << (qs.GetCompressionZstdLevel ()) << endl;
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Dictionary:" << (qs.GetCompressionDictionary () == true ? "Yes" : "No") << endl;
+  }
+  if (qs.GetCompressionLzma ()) {
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  xz/LZMA:" << (qs.GetCompressionLzma () == true ? "Yes" : "No") << endl;
+  }
+  if (qs.GetCompressionBrotli ()) {
+    os << left << setw (g_VERBOSE_WIDTH) << "II\t  Brotli:" << (qs.GetCompressionBrotli () == true ? "Yes" : "No") << endl;
+  }
   if (qs.GetCompressionPPM ()) {
     os << left << setw (g_VERBOSE_WIDTH) << "II\t  PPM:" << (qs.GetCompressionPPM () == true ? "Yes" : "No") << endl;
   }
@@ -190,6 +221,10 @@ ostream &operator<< (ostream &os, const QScoresSettings& qs) {
   if (qs.GetCompressionGlobalParameter () != g_DEFAULT_GOLOMB_RICE_PARAM) {
     os << left << setw (g_VERBOSE_WIDTH) << "II\t  Global parameter:" << (qs.GetCompressionGlobalParameter ()) << endl;
   }
+
+  os << left << "II\tArchive layout" << endl;
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  Byte-aligned blocks:" << (qs.GetAlignBlocks () == true ? "Yes" : "No") << endl;
+  os << left << setw (g_VERBOSE_WIDTH) << "II\t  Block index:" << (qs.GetBlockIndex () == true ? "Yes" : "No") << endl;
   
   return os;
 }
@@ -342,6 +377,15 @@ bool QScoresSettings::CheckCompressionSettings () const {
   if (GetCompressionRepair ()) {
     compression_count++;
   }
+  if (GetCompressionZstd ()) {
+    compression_count++;
+  }
+  if (GetCompressionLzma ()) {
+    compression_count++;
+  }
+  if (GetCompressionBrotli ()) {
+    compression_count++;
+  }
   if (GetCompressionPPM ()) {
     compression_count++;
   }
@@ -353,6 +397,58 @@ bool QScoresSettings::CheckCompressionSettings () const {
     return false;
   }
 
+  if (GetCompressionStreams () != g_DEFAULT_HUFFMAN_STREAMS) {
+    if ((!GetCompressionHuffman ()) && (!GetCompressionArithmetic ())) {
+      cerr << "EE\tInterleaved streams can only be used with Huffman or arithmetic coding." << endl;
+      return false;
+    }
+    if ((GetCompressionHuffman ()) && (GetCompressionStreams () != 4) && (GetCompressionStreams () != 8)) {
+      cerr << "EE\tThe number of interleaved streams must be 1, 4, or 8 for Huffman coding." << endl;
+      return false;
+    }
+    if ((GetCompressionArithmetic ()) && (GetCompressionStreams () != 32)) {
+      cerr << "EE\tThe number of interleaved streams must be 1 or 32 for arithmetic coding." << endl;
+      return false;
+    }
+  }
+
+  if (GetCompressionContext ()) {
+    if (!GetCompressionArithmetic ()) {
+      cerr << "EE\tContext modelling can only be used with arithmetic coding." << endl;
+      return false;
+    }
+    if (GetCompressionStreams () != g_DEFAULT_HUFFMAN_STREAMS) {
+      cerr << "EE\tContext modelling cannot be used with interleaved streams." << endl;
+      return false;
+    }
+  }
+
+  if (GetCompressionCodewordLimit () != g_DEFAULT_HUFFMAN_CODEWORD_LIMIT) {
+    if (!GetCompressionHuffman ()) {
+      cerr << "EE\tThe length of codewords can only be limited with Huffman coding." << endl;
+      return false;
+    }
+    if (GetCompressionCodewordLimit () > g_UINT_SIZE_BITS) {
+      cerr << "EE\tThe longest codeword cannot be more than " << g_UINT_SIZE_BITS << " bits." << endl;
+      return false;
+    }
+  }
+
+  if ((GetCompressionZstd ()) && ((GetCompressionZstdLevel () < 1) || (GetCompressionZstdLevel () > g_MAX_ZSTD_LEVEL))) {
+    cerr << "EE\tThe level for zstd must be from 1 to " << g_MAX_ZSTD_LEVEL << "." << endl;
+    return false;
+  }
+
+  if ((GetCompressionDictionary ()) && (!GetCompressionZstd ())) {
+    cerr << "EE\tA dictionary can only be used with zstd." << endl;
+    return false;
+  }
+
+  if ((GetCompressionChunked ()) && (!GetCompressionGzip ()) && (!GetCompressionBzip ())) {
+    cerr << "EE\tBlocks can only be split into chunks with gzip or bzip2." << endl;
+    return false;
+  }
+
   if ((GetCompressionRice ()) && (GetCompressionGlobalParameter () != g_DEFAULT_GOLOMB_RICE_PARAM)) {
     if (GetCompressionGlobalParameter () >= g_UINT_SIZE_BITS) {
       cerr << "EE\tThe parameter for Rice coding cannot be greater than or equal to " << g_UINT_SIZE_BITS << "." << endl;
@@ -431,6 +527,12 @@ bool QScoresSettings::ReadBinarySettings (BitBuffer &bitbuffer) {
   if ((setting & e_QSCORES_BINARY_SETTINGS_LOSSLESS_REMAPPING) != 0) {
     SetTransformFreqOrder ();
   }
+  if ((setting & e_QSCORES_BINARY_SETTINGS_ALIGN_BLOCKS) != 0) {
+    SetAlignBlocks ();
+    if (bitbuffer.ReadBits (1) == 1) {
+      SetBlockIndex ();
+    }
+  }
   
   if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_BINARY) {
     SetCompressionBinary ();
@@ -453,18 +555,55 @@ bool QScoresSettings::ReadBinarySettings (BitBuffer &bitbuffer) {
   if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN) {
     SetCompressionHuffman ();
   }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN_4) {
+    SetCompressionHuffman ();
+    SetCompressionStreams (4);
+  }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN_8) {
+    SetCompressionHuffman ();
+    SetCompressionStreams (8);
+  }
   if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC) {
     SetCompressionArithmetic ();
   }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC_32) {
+    SetCompressionArithmetic ();
+    SetCompressionStreams (32);
+  }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC_CONTEXT) {
+    SetCompressionArithmetic ();
+    SetCompressionContext ();
+  }
   if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_GZIP) {
     SetCompressionGzip ();
   }
   if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_BZIP) {
     SetCompressionBzip ();
   }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_GZIP_CHUNKED) {
+    SetCompressionGzip ();
+    SetCompressionChunked ();
+  }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_BZIP_CHUNKED) {
+    SetCompressionBzip ();
+    SetCompressionChunked ();
+  }
   if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_REPAIR) {
     SetCompressionRepair ();
   }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_ZSTD) {
+    SetCompressionZstd ();
+  }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_ZSTD_DICTIONARY) {
+    SetCompressionZstd ();
+    SetCompressionDictionary ();
+  }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_LZMA) {
+    SetCompressionLzma ();
+  }
+  if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_BROTLI) {
+    SetCompressionBrotli ();
+  }
 //   if ((setting & g_COMPRESSION_METHOD_BITMASK) == e_QSCORES_BINARY_SETTINGS_COMP_PPM) {
 //     SetCompressionPPM ();
 //   }
@@ -508,6 +647,9 @@ bool QScoresSettings::WriteBinarySettings (BitBuffer &bitbuffer) {
   if (GetTransformFreqOrder ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_LOSSLESS_REMAPPING & g_LOSSLESS_TRANSFORM_BITMASK);
   }
+  if (GetAlignBlocks ()) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_ALIGN_BLOCKS & g_LOSSLESS_TRANSFORM_BITMASK);
+  }
 
   if (GetLossyMaxTruncation ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_LOSSY_MAXTRUNC & g_LOSSY_TRANSFORM_BITMASK);
@@ -537,21 +679,51 @@ bool QScoresSettings::WriteBinarySettings (BitBuffer &bitbuffer) {
   else if (GetCompressionInterP ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_INTERP & g_COMPRESSION_METHOD_BITMASK);
   }
+  else if ((GetCompressionHuffman ()) && (GetCompressionStreams () == 4)) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN_4 & g_COMPRESSION_METHOD_BITMASK);
+  }
+  else if ((GetCompressionHuffman ()) && (GetCompressionStreams () == 8)) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN_8 & g_COMPRESSION_METHOD_BITMASK);
+  }
   else if (GetCompressionHuffman ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_HUFFMAN & g_COMPRESSION_METHOD_BITMASK);
   }
+  else if ((GetCompressionArithmetic ()) && (GetCompressionStreams () == 32)) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC_32 & g_COMPRESSION_METHOD_BITMASK);
+  }
+  else if ((GetCompressionArithmetic ()) && (GetCompressionContext ())) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC_CONTEXT & g_COMPRESSION_METHOD_BITMASK);
+  }
   else if (GetCompressionArithmetic ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_ARITHMETIC & g_COMPRESSION_METHOD_BITMASK);
   }
+  else if ((GetCompressionGzip ()) && (GetCompressionChunked ())) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_GZIP_CHUNKED & g_COMPRESSION_METHOD_BITMASK);
+  }
   else if (GetCompressionGzip ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_GZIP & g_COMPRESSION_METHOD_BITMASK);
   }
+  else if ((GetCompressionBzip ()) && (GetCompressionChunked ())) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_BZIP_CHUNKED & g_COMPRESSION_METHOD_BITMASK);
+  }
   else if (GetCompressionBzip ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_BZIP & g_COMPRESSION_METHOD_BITMASK);
   }
   else if (GetCompressionRepair ()) {
     setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_REPAIR & g_COMPRESSION_METHOD_BITMASK);
   }
+  else if ((GetCompressionZstd ()) && (GetCompressionDictionary ())) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_ZSTD_DICTIONARY & g_COMPRESSION_METHOD_BITMASK);
+  }
+  else if (GetCompressionZstd ()) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_ZSTD & g_COMPRESSION_METHOD_BITMASK);
+  }
+  else if (GetCompressionLzma ()) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_LZMA & g_COMPRESSION_METHOD_BITMASK);
+  }
+  else if (GetCompressionBrotli ()) {
+    setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_BROTLI & g_COMPRESSION_METHOD_BITMASK);
+  }
 //   if (GetCompressionPPM ()) {
 //     setting = setting | (e_QSCORES_BINARY_SETTINGS_COMP_PPM & g_COMPRESSION_METHOD_BITMASK);
 //   }
@@ -560,6 +732,11 @@ bool QScoresSettings::WriteBinarySettings (BitBuffer &bitbuffer) {
   if (GetDebug ()) {
     cerr << "DD\t[QScoresSettings::WriteBinarySettings ()] Write out setting:  " << setting << endl;
   }
+
+  //  With byte-aligned blocks, a single bit follows to indicate whether there is a block index
+  if (GetAlignBlocks ()) {
+    bitbuffer.WriteBits ((GetBlockIndex () ? 1 : 0), 1);
+  }
   
   return (true);
 }
@@ -30,6 +30,26 @@
 #ifndef QSCORES_SETTINGS_HPP
 #define QSCORES_SETTINGS_HPP
 
+/*!
+     Default number of interleaved streams for Huffman coding; that is, a single one
+*/
+const unsigned int g_DEFAULT_HUFFMAN_STREAMS = 1;
+
+/*!
+     Default limit on the length of Huffman codewords; that is, none
+*/
+const unsigned int g_DEFAULT_HUFFMAN_CODEWORD_LIMIT = 0;
+
+/*!
+     Default zstd compression level
+*/
+const int g_DEFAULT_ZSTD_LEVEL = 19;
+
+/*!
+     Highest zstd compression level
+*/
+const int g_MAX_ZSTD_LEVEL = 22;
+
 /*!
     \class QScoresSettings
 
@@ -88,11 +108,24 @@ class QScoresSettings {
     bool GetCompressionGzip () const;
     bool GetCompressionBzip () const;
     bool GetCompressionRepair () const;
+    bool GetCompressionZstd () const;
+    bool GetCompressionLzma () const;
+    bool GetCompressionBrotli () const;
     bool GetCompressionPPM () const;
     bool GetCompressionNone () const;
 
     //  Compression parameters
     unsigned int GetCompressionGlobalParameter () const;
+    unsigned int GetCompressionStreams () const;
+    unsigned int GetCompressionCodewordLimit () const;
+    bool GetCompressionContext () const;
+    int GetCompressionZstdLevel () const;
+    bool GetCompressionDictionary () const;
+    bool GetCompressionChunked () const;
+
+    //  Archive layout
+    bool GetAlignBlocks () const;
+    bool GetBlockIndex () const;
 
     //  Mutators  [mutators.cpp]
     void SetInputFn (string x);
@@ -127,11 +160,24 @@ class QScoresSettings {
     void SetCompressionGzip ();
     void SetCompressionBzip ();
     void SetCompressionRepair ();
+    void SetCompressionZstd ();
+    void SetCompressionLzma ();
+    void SetCompressionBrotli ();
     void SetCompressionPPM ();
     void SetCompressionNone ();
     
     //  Compression parameters
     void SetCompressionGlobalParameter (unsigned int x);
+    void SetCompressionStreams (unsigned int x);
+    void SetCompressionCodewordLimit (unsigned int x);
+    void SetCompressionContext ();
+    void SetCompressionZstdLevel (int x);
+    void SetCompressionDictionary ();
+    void SetCompressionChunked ();
+
+    //  Archive layout
+    void SetAlignBlocks ();
+    void SetBlockIndex ();
   private:
     //!  Debug mode?
     bool m_Debug;
@@ -185,18 +231,41 @@ class QScoresSettings {
     
     //!  Compression -- Huffman coding?
     bool m_CompressionHuffman;
+    //!  Compression -- Number of interleaved streams for Huffman coding (1, 4, or 8)
+    unsigned int m_CompressionStreams;
+    //!  Compression -- Longest Huffman codeword allowed, or 0 for no limit; not encoded in the main header and unnecessary for decoding
+    unsigned int m_CompressionCodewordLimit;
     //!  Compression -- Arithmetic coding?
     bool m_CompressionArithmetic;
+    //!  Compression -- Context-modelled arithmetic coding, instead of static frequencies?
+    bool m_CompressionContext;
     //!  Compression -- gzip?
     bool m_CompressionGzip;
     //!  Compression -- bzip?
     bool m_CompressionBzip;
     //!  Compression -- Re-Pair?
     bool m_CompressionRepair;
+    //!  Compression -- zstd?
+    bool m_CompressionZstd;
+    //!  Compression -- Level for zstd; not encoded in the main header and unnecessary for decoding
+    int m_CompressionZstdLevel;
+    //!  Compression -- zstd with a dictionary trained on the first block and stored after the settings?
+    bool m_CompressionDictionary;
+    //!  Compression -- gzip or bzip2 with each block split into chunks compressed independently?
+    bool m_CompressionChunked;
+    //!  Compression -- xz/LZMA?
+    bool m_CompressionLzma;
+    //!  Compression -- Brotli?
+    bool m_CompressionBrotli;
     //!  Compression -- PPM?
     bool m_CompressionPPM;
     //!  Compression -- None?
     bool m_CompressionNone;
+
+    //!  Archive layout -- blocks are byte-aligned and preceded by their length?
+    bool m_AlignBlocks;
+    //!  Archive layout -- blocks are listed in an index at the end?  Requires m_AlignBlocks
+    bool m_BlockIndex;
 };
 
 #endif
@@ -33,6 +33,7 @@
 #include <cassert>
 #include <iostream>
 #include <climits>
+#include <utility>  //  move
 
 using namespace std;
 
@@ -356,7 +357,7 @@ void QScoresSingle::UnapplyCompressionInterP (BitBuffer &bitbuffer, unsigned int
   //  Interpolative decode each element
   Interpolative_Decode (bitbuffer, tmp, size);
 
-  m_QScoreInt = tmp;
+  m_QScoreInt = move (tmp);
 
   m_Status = e_QSCORES_SINGLE_STATUS_INT;
 
@@ -154,7 +154,7 @@ void QScoresSingle::ApplyFinalize () {
 
      \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
 */
-void QScoresSingle::ApplyLosslessRemapping (vector <unsigned int> lookup) {
+void QScoresSingle::ApplyLosslessRemapping (const vector<unsigned int> &lookup) {
   assert ((m_Status == e_QSCORES_SINGLE_STATUS_BOTH) || (m_Status == e_QSCORES_SINGLE_STATUS_INT));
 
   for (unsigned int i = 0; i < m_QScoreInt.size (); i++) {
@@ -276,7 +276,7 @@ void QScoresSingle::UnapplyFinalize () {
 
      \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
 */
-void QScoresSingle::UnapplyLosslessRemapping (vector <unsigned int> lookup) {
+void QScoresSingle::UnapplyLosslessRemapping (const vector<unsigned int> &lookup) {
   assert ((m_Status == e_QSCORES_SINGLE_STATUS_BOTH) || (m_Status == e_QSCORES_SINGLE_STATUS_INT));
 
   for (unsigned int i = 0; i < m_QScoreInt.size (); i++) {
@@ -91,7 +91,7 @@ void QScoresSingle::ApplyLossyMaxTruncation (unsigned int param) {
 
      \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
 */
-void QScoresSingle::ApplyLossyRemapping (vector <unsigned int> lookup) {
+void QScoresSingle::ApplyLossyRemapping (const vector<unsigned int> &lookup) {
   assert ((m_Status == e_QSCORES_SINGLE_STATUS_BOTH) || (m_Status == e_QSCORES_SINGLE_STATUS_INT));
 
   for (unsigned int i = 0; i < m_QScoreInt.size (); i++) {
@@ -109,7 +109,7 @@ void QScoresSingle::ApplyLossyRemapping (vector <unsigned int> lookup) {
 
      \param[in] lookup The lookup table to remap with.  The size of the table should be equal to the size of the ASCII alphabet.
 */
-void QScoresSingle::UnapplyLossyRemapping (vector <unsigned int> lookup) {
+void QScoresSingle::UnapplyLossyRemapping (const vector<unsigned int> &lookup) {
   assert ((m_Status == e_QSCORES_SINGLE_STATUS_BOTH) || (m_Status == e_QSCORES_SINGLE_STATUS_INT));
 
   for (unsigned int i = 0; i < m_QScoreInt.size (); i++) {
@@ -87,7 +87,7 @@ QScoresSingle::QScoresSingle (string x, bool debug)
      \param[in] x Initial quality scores as integers
      \param[in] debug Set to true if in debug mode; false by default
 */
-QScoresSingle::QScoresSingle (vector<unsigned int> x, bool debug)
+QScoresSingle::QScoresSingle (const vector<unsigned int> &x, bool debug)
   : m_Debug (debug),
     m_Status (e_QSCORES_SINGLE_STATUS_INT),
     m_Min (UINT_MAX),
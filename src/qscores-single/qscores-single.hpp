@@ -57,7 +57,7 @@ class QScoresSingle {
     //  Constructors/destructors  [qscores-single.cpp]
     QScoresSingle ();
     QScoresSingle (string x, bool debug=false);
-    QScoresSingle (vector<unsigned int> x, bool debug=false);
+    QScoresSingle (const vector<unsigned int> &x, bool debug=false);
     ~QScoresSingle ();
 
     //  Accessors  [qscores-single.cpp]
@@ -73,7 +73,7 @@ class QScoresSingle {
     
     //  I/O functions  [io.cpp]
     void PrintQScore ();
-    vector<unsigned int> GetQScoreInt () const;
+    const vector<unsigned int> &GetQScoreInt () const;
     unsigned int GetQScoreIntAsBinary (char* buffer, unsigned int buffer_size);
     
     //  Mapping to/from quality scores  [mapping.cpp]
@@ -85,18 +85,18 @@ class QScoresSingle {
     //  Lossy transformations  [lossy.cpp]
     void ApplyLossyMinTruncation (unsigned int param);
     void ApplyLossyMaxTruncation (unsigned int param);
-    void ApplyLossyRemapping (vector<unsigned int> lookup);
-    void UnapplyLossyRemapping (vector<unsigned int> lookup);
+    void ApplyLossyRemapping (const vector<unsigned int> &lookup);
+    void UnapplyLossyRemapping (const vector<unsigned int> &lookup);
     
     //  Lossless transformations  [lossless.cpp]
     unsigned int ApplyDifferenceCoding (unsigned int previous);
     void ApplyRescaling (unsigned int k);
 //     void ApplyFinalize ();
-    void ApplyLosslessRemapping (vector <unsigned int> lookup);
+    void ApplyLosslessRemapping (const vector<unsigned int> &lookup);
     unsigned int UnapplyDifferenceCoding (unsigned int previous);
     void UnapplyRescaling (unsigned int k);
 //     void UnapplyFinalize ();
-    void UnapplyLosslessRemapping (vector <unsigned int> lookup);
+    void UnapplyLosslessRemapping (const vector<unsigned int> &lookup);
 
     //  Compression functions  [compress.cpp]
     void ApplyCompressionBinary (BitBuffer &bitbuffer, unsigned int param, unsigned int len);
@@ -40,6 +40,7 @@ using namespace std;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-defn.hpp"
 #include "qscores.hpp"
@@ -127,3 +128,33 @@ bool QScores::GetUnbinningCheck () const {
 int QScores::GetBlocksize () const {
   return (m_Blocksize);
 }
+
+
+/*!
+     Get the number of threads.
+
+     \return Integer representing the setting.
+*/
+int QScores::GetThreads () const {
+  return (m_Threads);
+}
+
+
+/*!
+     Get the first read to decode.
+
+     \return Read number (from 1), or 0 if all of the reads are decoded.
+*/
+unsigned long long QScores::GetReadsFrom () const {
+  return (m_ReadsFrom);
+}
+
+
+/*!
+     Get the last read to decode.
+
+     \return Read number (from 1)
+*/
+unsigned long long QScores::GetReadsTo () const {
+  return (m_ReadsTo);
+}
@@ -40,6 +40,7 @@ using namespace std;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "binning.hpp"
 
 //  -----------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <climits>  //  UINT_MAX
+#include <algorithm>  //  min
 
 #include "boost/filesystem.hpp"   // includes all needed Boost.Filesystem declarations
 
@@ -40,6 +41,7 @@ using namespace std;
 namespace bfs = boost::filesystem;
 // namespace btk = boost::tokenizer;
 
+#include "common.hpp"
 #include "external-software.hpp"
 #include "block-statistics.hpp"
 #include "bitbuffer.hpp"
@@ -47,18 +49,17 @@ namespace bfs = boost::filesystem;
 #include "bitio-defn.hpp"
 #include "interpolative.hpp"
 #include "huffman.hpp"
+#include "rans.hpp"
+#include "context-coder.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-local.hpp"
 #include "qscores-defn.hpp"
 #include "qscores.hpp"
 
 
-//!  The number of symbols to decode with Huffman coding with each call of DecodeMessage ()
-const unsigned int g_HUFFMAN_DECODE_SYMBOLS = 1024;
-
-
 /*!
      Decode the header of the current block.
 
@@ -70,6 +71,28 @@ int QScores::DecodeHeaderBlock (int block_count) {
   vector<unsigned int> lossless_remap;
   int current_blocksize = g_NO_BLOCKSIZE;
 
+  //  Byte-aligned blocks start with their length in bytes; a length of 0 marks the end of the file
+  if (m_QScoresSettings.GetAlignBlocks ()) {
+    m_BitBuff_In.AlignRead (g_CHAR_SIZE_BITS);
+
+    //  Their positions are also known if there is a block index
+    if (m_QScoresSettings.GetBlockIndex ()) {
+      if (block_count == static_cast<int> (m_BlockIndex.size ())) {
+        return (g_EOF_REACHED);
+      }
+      if ((block_count > static_cast<int> (m_BlockIndex.size ())) ||
+          (m_BitBuff_In.GetPosition () != m_BlockIndex[block_count].offset * g_CHAR_SIZE_BITS)) {
+        cerr << "EE\tBlock " << block_count << " is not where the block index says it is." << endl;
+        exit (EXIT_FAILURE);
+      }
+    }
+
+    m_BitBuff_In.ReadUInts (&m_BlockLength, 1);
+    if (m_BlockLength == 0) {
+      return (g_EOF_REACHED);
+    }
+  }
+
   //  Length of the reads for the file
   if (block_count == 0) {
     m_FileReadLength = Delta_Decode (m_BitBuff_In);
@@ -105,6 +128,12 @@ int QScores::DecodeHeaderBlock (int block_count) {
     current_blocksize--;
   }
 
+  if ((m_QScoresSettings.GetBlockIndex ()) &&
+      (static_cast<unsigned int> (current_blocksize) != m_BlockIndex[block_count].num_reads)) {
+    cerr << "EE\tBlock " << block_count << " does not have the number of reads given by the block index." << endl;
+    exit (EXIT_FAILURE);
+  }
+
   //  Length of the reads; see EncodeHeaderBlock ()
   m_BlockReadLength = Delta_Decode (m_BitBuff_In);
   if (m_BlockReadLength == 1) {
@@ -185,29 +214,23 @@ int QScores::DecodeHeaderBlock (int block_count) {
      \param[in] blocksize Number of reads in this block
 */
 void QScores::DecodeStaticCodesBlock (int blocksize) {
-  for (int i = 0; i < blocksize; i++) {
-    QScoresSingle tmp = QScoresSingle ();
-
-    if (m_QScoresSettings.GetCompressionBinary ()) {
-      tmp.UnapplyCompressionBinary (m_BitBuff_In, m_CompressionParameter, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionGamma ()) {
-      tmp.UnapplyCompressionGamma (m_BitBuff_In, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionDelta ()) {
-      tmp.UnapplyCompressionDelta (m_BitBuff_In, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionGolomb () > 0) {
-      tmp.UnapplyCompressionGolomb (m_BitBuff_In, m_CompressionParameter, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionRice () > 0) {
-      tmp.UnapplyCompressionRice (m_BitBuff_In, m_CompressionParameter, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionInterP ()) {
-      tmp.UnapplyCompressionInterP (m_BitBuff_In, m_BlockReadLength);
-    }
-    
-    m_Qscores.push_back (tmp);
+  if (m_QScoresSettings.GetCompressionBinary ()) {
+    m_Qscores.UnapplyCompressionBinary (m_BitBuff_In, m_CompressionParameter, m_BlockReadLength, blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionGamma ()) {
+    m_Qscores.UnapplyCompressionGamma (m_BitBuff_In, m_BlockReadLength, blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionDelta ()) {
+    m_Qscores.UnapplyCompressionDelta (m_BitBuff_In, m_BlockReadLength, blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionGolomb () > 0) {
+    m_Qscores.UnapplyCompressionGolomb (m_BitBuff_In, m_CompressionParameter, m_BlockReadLength, blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionRice () > 0) {
+    m_Qscores.UnapplyCompressionRice (m_BitBuff_In, m_CompressionParameter, m_BlockReadLength, blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionInterP ()) {
+    m_Qscores.UnapplyCompressionInterP (m_BitBuff_In, m_BlockReadLength, blocksize);
   }
 
   return;
@@ -215,48 +238,64 @@ void QScores::DecodeStaticCodesBlock (int blocksize) {
 
 
 /*!
-     Decode the current block of quality scores using Huffman coding.
+     Decode the current block of quality scores using Huffman coding.  The block is sized
+     once for all of its values and the symbols are decoded straight into it.
 
      \param[in] blocksize Number of reads in this block
 */
 void QScores::DecodeHuffmanBlock (int blocksize) {
-  vector<unsigned int> buffer;  //  Temporary buffer of quality scores (not yet split)
-  vector<unsigned int> tmp;  //  Temporary quality scores' read
-  unsigned int block_length = 0;  //  Length of the block in # of symbols
-  unsigned int curr_read_length = 0;
-  
   Huffman hm_in;
 
   //  Start decoding
   hm_in.DecodeBegin (m_BitBuff_In);
-  block_length = hm_in.GetMessageLength ();
+  unsigned long long block_length = hm_in.GetMessageLength ();
+  if (block_length != static_cast<unsigned long long> (blocksize) * m_BlockReadLength) {
+    cerr << "EE\tExpected " << blocksize << " reads of length " << m_BlockReadLength << ", but the block has " << block_length << " quality scores." << endl;
+    exit (EXIT_FAILURE);
+  }
+  unsigned char *values = m_Qscores.AddEmptyReads (block_length, m_BlockReadLength);
 
-  //  Continue while there are still symbols left to decode
-  while (block_length != 0) {
-    if (block_length > g_HUFFMAN_DECODE_SYMBOLS) {
-      buffer = hm_in.DecodeMessage (m_BitBuff_In, g_HUFFMAN_DECODE_SYMBOLS);
-      block_length -= g_HUFFMAN_DECODE_SYMBOLS;
-    }
-    else {
-      buffer = hm_in.DecodeMessage (m_BitBuff_In, block_length);
-      block_length = 0;
-    }
-    
-    //  Process the decoded symbols; if the current length is equal to m_BlockReadLength, then we completed a read
-    for (unsigned int i = 0; i < buffer.size (); i++) {
-        tmp.push_back (buffer[i]);
-        curr_read_length++;
-        if (curr_read_length == m_BlockReadLength) {
-          QScoresSingle qscores_tmp (tmp);
-          m_Qscores.push_back (qscores_tmp);
-          tmp.clear ();
-          curr_read_length = 0;
-        }
-    }
+  //  Interleaved streams replace both DecodeMessage () and DecodeFinish ()
+  unsigned int streams = m_QScoresSettings.GetCompressionStreams ();
+  if (streams != g_DEFAULT_HUFFMAN_STREAMS) {
+    hm_in.DecodeStreams (m_BitBuff_In, values, streams);
+  }
+  else {
+    hm_in.DecodeMessage (m_BitBuff_In, values, static_cast<unsigned int> (block_length));
+    hm_in.DecodeFinish (m_BitBuff_In);
   }
 
-  //  Finish decoding
-  hm_in.DecodeFinish (m_BitBuff_In);
+  return;
+}
+
+
+/*!
+     Decode the current block of quality scores using arithmetic (rANS or context-modelled)
+     coding.  The block is sized once for the values it should have, and the coder checks
+     the length of the message before decoding straight into it.
+
+     \param[in] blocksize Number of reads in this block
+*/
+void QScores::DecodeArithmeticBlock (int blocksize) {
+  unsigned long long block_length = static_cast<unsigned long long> (blocksize) * m_BlockReadLength;
+  bool context = m_QScoresSettings.GetCompressionContext ();
+  if (block_length > (context ? g_CONTEXT_MESSAGE_MAX : g_RANS_MESSAGE_MAX)) {
+    cerr << "EE\tExpected " << blocksize << " reads of length " << m_BlockReadLength << ", which is too many quality scores for one message." << endl;
+    exit (EXIT_FAILURE);
+  }
+  unsigned char *values = m_Qscores.AddEmptyReads (block_length, m_BlockReadLength);
+
+  if (context) {
+    ContextCoder cc_in;
+    cc_in.DecodeMessage (m_BitBuff_In, values, block_length, m_BlockReadLength);
+  }
+  else {
+    RANS rc_in;
+    if (m_QScoresSettings.GetCompressionStreams () == g_RANS_STATES_MAX) {
+      rc_in.SetStates (g_RANS_STATES_MAX);
+    }
+    rc_in.DecodeMessage (m_BitBuff_In, values, block_length);
+  }
 
   return;
 }
@@ -268,6 +307,21 @@ void QScores::DecodeHuffmanBlock (int blocksize) {
      \param[in] blocksize Number of reads in this block
 */
 void QScores::DecodeExternalBlock (int blocksize) {
+  ReadExternalBlock (m_ExternalSoftware);
+  UnProcessExternalBlock (blocksize);
+
+  return;
+}
+
+
+/*!
+     Read in the compressed bytes of the current block and pass them to an ExternalSoftware
+     object, without decompressing them.  The object need not be m_ExternalSoftware, so that
+     another thread can decompress the block with UnProcessExternalBlock ().
+
+     \param[in] external_software The object which will decompress the block
+*/
+void QScores::ReadExternalBlock (ExternalSoftware &external_software) {
   char *buffer = NULL;
   
   //  Read in the size of the binary representation from the BitBuffer
@@ -278,25 +332,32 @@ void QScores::DecodeExternalBlock (int blocksize) {
   buffer = new char [compressed_filesize];
   m_BitBuff_In.ReadChars (buffer, compressed_filesize);
 
-  //  Decompress the buffer using an external program/library
-  m_ExternalSoftware.UnProcess (buffer, compressed_filesize, true);
+  external_software.UnProcess (buffer, compressed_filesize, false);
   delete [] buffer;
+
+  return;
+}
+
+
+/*!
+     Decompress the bytes given to m_ExternalSoftware by ReadExternalBlock () and split them
+     into reads.
+
+     \param[in] blocksize Number of reads in this block
+*/
+void QScores::UnProcessExternalBlock (int blocksize) {
+  //  Decompress the buffer using an external program/library
+  m_ExternalSoftware.UnProcess (NULL, 0, true);
   
   unsigned int uncompressed_filesize = m_ExternalSoftware.GetOutBufferLength ();
-  buffer = m_ExternalSoftware.RetrieveChar ();
-  buffer[uncompressed_filesize] = '\0';
-  
-  //  Convert the buffer to a string
-  string buffer_string (buffer);
-  for (unsigned int i = 0; i < buffer_string.length (); i += m_BlockReadLength) {
-    string tmp_str = buffer_string.substr (i, m_BlockReadLength);
-    QScoresSingle tmp (tmp_str);
-    tmp.StrToInt ();
-    m_Qscores.push_back (tmp);
+  const char *buffer = m_ExternalSoftware.GetOutBuffer ();
+
+  //  Split the buffer into reads of length m_BlockReadLength
+  for (unsigned int i = 0; i < uncompressed_filesize; i += m_BlockReadLength) {
+    unsigned int len = min (m_BlockReadLength, uncompressed_filesize - i);
+    m_Qscores.AddRead (buffer + i, len);
   }
-  
-  //  Free memory
-  free (buffer);
+
 
   //  Reset for next block
   m_ExternalSoftware.UnInitialize ();
@@ -305,3 +366,37 @@ void QScores::DecodeExternalBlock (int blocksize) {
 }
 
 
+/*!
+     Decode the current block, whose header has already been decoded by DecodeHeaderBlock (), and
+     undo the transformations applied to it.
+
+     \param[in] current_blocksize Number of reads in this block
+*/
+void QScores::DecodeBlock (int current_blocksize) {
+  if ((m_QScoresSettings.GetCompressionBinary ()) ||
+      (m_QScoresSettings.GetCompressionGamma ()) ||
+      (m_QScoresSettings.GetCompressionDelta ()) ||
+      (m_QScoresSettings.GetCompressionGolomb () > 0) ||
+      (m_QScoresSettings.GetCompressionRice () > 0) ||
+      (m_QScoresSettings.GetCompressionInterP ())) {
+    DecodeStaticCodesBlock (current_blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionHuffman ()) {
+    DecodeHuffmanBlock (current_blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionArithmetic ()) {
+    DecodeArithmeticBlock (current_blocksize);
+  }
+  else if ((m_QScoresSettings.GetCompressionGzip ()) ||
+           (m_QScoresSettings.GetCompressionBzip ()) ||
+           (m_QScoresSettings.GetCompressionRepair ()) ||
+           (m_QScoresSettings.GetCompressionZstd ()) ||
+           (m_QScoresSettings.GetCompressionLzma ()) ||
+           (m_QScoresSettings.GetCompressionBrotli ()) ||
+           (m_QScoresSettings.GetCompressionPPM ())) {
+    DecodeExternalBlock (current_blocksize);
+  }
+  UnPreprocessBlock (current_blocksize);
+
+  return;
+}
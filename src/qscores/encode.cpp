@@ -34,6 +34,7 @@
 #include <iostream>
 #include <climits>  //  UINT_MAX
 #include <cmath>
+#include <algorithm>  //  max
 
 #include "boost/filesystem.hpp"   // includes all needed Boost.Filesystem declarations
 
@@ -41,14 +42,18 @@ using namespace std;
 namespace bfs = boost::filesystem;
 
 #include "external-software-exception.hpp"
+#include "common.hpp"
 #include "external-software.hpp"
 #include "block-statistics.hpp"
 #include "bitbuffer.hpp"
 #include "bitio-defn.hpp"
 #include "huffman.hpp"
+#include "rans.hpp"
+#include "context-coder.hpp"
 #include "interpolative.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-local.hpp"
 #include "qscores-defn.hpp"
@@ -56,15 +61,70 @@ namespace bfs = boost::filesystem;
 
 
 /*!
-     Encode a value to mark the end of the file.
+     Encode a value to mark the end of the file.  With byte-aligned blocks, this is a block
+     length of 0.
 */
 void QScores::EncodeEOF () {
-  Delta_Encode (m_BitBuff_Out, g_EOF_REACHED);
+  if (m_QScoresSettings.GetAlignBlocks ()) {
+    unsigned int block_length = 0;
+    m_BitBuff_Out.WriteUInts (&block_length, 1);
+  }
+  else {
+    Delta_Encode (m_BitBuff_Out, g_EOF_REACHED);
+  }
+
+  if (m_QScoresSettings.GetBlockIndex ()) {
+    EncodeBlockIndex ();
+  }
   
   return;
 }
 
 
+/*!
+     Preprocess and encode the current block, including its header, with the compression
+     method selected.  The bits are written to m_BitBuff_Out.
+
+     \param[in] current_blocksize The size of the current block
+     \param[in] block_count Block ID (from 0)
+*/
+void QScores::EncodeBlock (int current_blocksize, int block_count) {
+  PreprocessBlock (current_blocksize);
+
+  EncodeHeaderBlock (current_blocksize, block_count);
+  if ((m_QScoresSettings.GetCompressionBinary ()) ||
+      (m_QScoresSettings.GetCompressionGamma ()) ||
+      (m_QScoresSettings.GetCompressionDelta ()) ||
+      (m_QScoresSettings.GetCompressionGolomb () > 0) ||
+      (m_QScoresSettings.GetCompressionRice () > 0) ||
+      (m_QScoresSettings.GetCompressionInterP ())) {
+    EncodeStaticCodesBlock (current_blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionHuffman ()) {
+    EncodeHuffmanBlock (current_blocksize);
+  }
+  else if (m_QScoresSettings.GetCompressionArithmetic ()) {
+    EncodeArithmeticBlock (current_blocksize);
+  }
+  else if ((m_QScoresSettings.GetCompressionGzip ()) ||
+           (m_QScoresSettings.GetCompressionBzip ()) ||
+           (m_QScoresSettings.GetCompressionRepair ()) ||
+           (m_QScoresSettings.GetCompressionZstd ()) ||
+           (m_QScoresSettings.GetCompressionLzma ()) ||
+           (m_QScoresSettings.GetCompressionBrotli ()) ||
+           (m_QScoresSettings.GetCompressionPPM ())) {
+    EncodeExternalBlock (current_blocksize);
+  }
+
+  //  The next block starts at a whole byte; see EncodeParallel ()
+  if (m_QScoresSettings.GetAlignBlocks ()) {
+    m_BitBuff_Out.AlignWrite (g_CHAR_SIZE_BITS);
+  }
+
+  return;
+}
+
+
 /*!
      Encode the header of the current block.  For Golomb, Rice, and Binary coding, also 
      determine the compression parameter for this block.
@@ -130,15 +190,7 @@ void QScores::EncodeHeaderBlock (int current_blocksize, int block_count) {
 
   //  Binary coding parameter
   if (m_QScoresSettings.GetCompressionBinary ()) {
-    unsigned int current_max = 0;
-    for (int i = 0; i < current_blocksize; i++) {
-      m_Qscores[i].SetMinMax ();
-      if (m_Qscores[i].GetMax () > current_max) {
-        current_max = m_Qscores[i].GetMax ();
-      }
-    }
-    
-    m_CompressionParameter = current_max;
+    m_CompressionParameter = m_Qscores.GetMax ();
     
     //  Encode the parameter
     Delta_Encode (m_BitBuff_Out, m_CompressionParameter);
@@ -153,12 +205,8 @@ void QScores::EncodeHeaderBlock (int current_blocksize, int block_count) {
     }
     else {
       //  Tabulate the average across all reads
-      unsigned int sum = 0;
-      unsigned int count = 0;
-      for (int i = 0; i < current_blocksize; i++) {
-        sum += m_Qscores[i].GetIntSum ();
-        count += m_Qscores[i].GetIntLength ();
-      }
+      unsigned long long sum = m_Qscores.GetSum ();
+      unsigned long long count = m_Qscores.GetNumValues ();
 
       double average = (static_cast<double> (sum)) / (static_cast<double> (count));
       m_CompressionParameter = static_cast<unsigned int> (ceil (g_GOLOMB_RICE_CONSTANT * (average)));
@@ -223,25 +271,23 @@ void QScores::EncodeHeaderBlock (int current_blocksize, int block_count) {
      \param[in] current_blocksize The size of the current block
 */
 void QScores::EncodeStaticCodesBlock (int current_blocksize) {
-  for (int i = 0; i < current_blocksize; i++) {
-    if (m_QScoresSettings.GetCompressionBinary ()) {
-      m_Qscores[i].ApplyCompressionBinary (m_BitBuff_Out, m_CompressionParameter, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionGamma ()) {
-      m_Qscores[i].ApplyCompressionGamma (m_BitBuff_Out, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionDelta ()) {
-      m_Qscores[i].ApplyCompressionDelta (m_BitBuff_Out, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionGolomb () > 0) {
-      m_Qscores[i].ApplyCompressionGolomb (m_BitBuff_Out, m_CompressionParameter, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionRice () > 0) {
-      m_Qscores[i].ApplyCompressionRice (m_BitBuff_Out, m_CompressionParameter, m_BlockReadLength);
-    }
-    else if (m_QScoresSettings.GetCompressionInterP ()) {
-      m_Qscores[i].ApplyCompressionInterP (m_BitBuff_Out, m_BlockReadLength);
-    }
+  if (m_QScoresSettings.GetCompressionBinary ()) {
+    m_Qscores.ApplyCompressionBinary (m_BitBuff_Out, m_CompressionParameter, m_BlockReadLength);
+  }
+  else if (m_QScoresSettings.GetCompressionGamma ()) {
+    m_Qscores.ApplyCompressionGamma (m_BitBuff_Out, m_BlockReadLength);
+  }
+  else if (m_QScoresSettings.GetCompressionDelta ()) {
+    m_Qscores.ApplyCompressionDelta (m_BitBuff_Out, m_BlockReadLength);
+  }
+  else if (m_QScoresSettings.GetCompressionGolomb () > 0) {
+    m_Qscores.ApplyCompressionGolomb (m_BitBuff_Out, m_CompressionParameter, m_BlockReadLength);
+  }
+  else if (m_QScoresSettings.GetCompressionRice () > 0) {
+    m_Qscores.ApplyCompressionRice (m_BitBuff_Out, m_CompressionParameter, m_BlockReadLength);
+  }
+  else if (m_QScoresSettings.GetCompressionInterP ()) {
+    m_Qscores.ApplyCompressionInterP (m_BitBuff_Out, m_BlockReadLength);
   }
   
   return;
@@ -255,18 +301,30 @@ void QScores::EncodeStaticCodesBlock (int current_blocksize) {
 */
 void QScores::EncodeHuffmanBlock (int current_blocksize) {
   Huffman hm_out;
+  hm_out.SetCodewordLimit (m_QScoresSettings.GetCompressionCodewordLimit ());
 
   //  Update frequencies with the quality scores in this block
-  for (int i = 0; i < current_blocksize; i++) {
-    hm_out.UpdateFrequencies (m_Qscores[i].GetQScoreInt ());
-  }
+  hm_out.UpdateFrequencies (m_Qscores.GetRead (0), m_Qscores.GetNumValues ());
   
   //  Start encoding
   hm_out.EncodeBegin (m_BitBuff_Out);
 
+  //  A limit too small for the symbols of the block is raised; see Huffman::LimitCodewordLengths ()
+  if ((hm_out.GetCodewordLimit () != 0) && (hm_out.GetMaximumCodewordLen () > hm_out.GetCodewordLimit ())) {
+    m_CodewordLimitRaised = max (m_CodewordLimitRaised, hm_out.GetMaximumCodewordLen ());
+  }
+
+  //  Interleaved streams take the block's quality scores all at once, straight from its buffer
+  unsigned int streams = m_QScoresSettings.GetCompressionStreams ();
+  if (streams != g_DEFAULT_HUFFMAN_STREAMS) {
+    hm_out.EncodeStreams (m_BitBuff_Out, m_Qscores.GetRead (0), m_Qscores.GetNumValues (), streams);
+
+    return;
+  }
+
   //  Encode each vector of quality score
   for (int i = 0; i < current_blocksize; i++) {
-    hm_out.EncodeMessage (m_BitBuff_Out, m_Qscores[i].GetQScoreInt ());
+    hm_out.EncodeMessage (m_BitBuff_Out, m_Qscores.GetRead (i), m_Qscores.GetReadLength (i));
   }
   
   //  Finish encoding
@@ -277,58 +335,52 @@ void QScores::EncodeHuffmanBlock (int current_blocksize) {
 
 
 /*!
-     Encode the current block using an external compression system.
+     Encode the current block using arithmetic coding; that is, rANS coding with the static
+     frequencies of the block, or adaptive coding in the context of the previous quality
+     scores and the position in the read if context modelling was selected.
 
      \param[in] current_blocksize The size of the current block
 */
-void QScores::EncodeExternalBlock (int current_blocksize) {
-  bool last = false;
+void QScores::EncodeArithmeticBlock (int current_blocksize) {
+  //  The values of the block are coded straight from its buffer
+  if (m_QScoresSettings.GetCompressionContext ()) {
+    ContextCoder cc_out;
+    cc_out.EncodeMessage (m_BitBuff_Out, m_Qscores.GetRead (0), m_Qscores.GetNumValues (), m_BlockReadLength);
 
-  //  Add a read at a time
-  unsigned int mini_buffer_size = 0;
-  //  This is the longest that a read can be; if it is too short, the program will exit
-  unsigned int max_buffer_size = 65536;  
-  char* mini_buffer = (char*) calloc (max_buffer_size, sizeof (char));
-  for (int i = 0; i < current_blocksize; i++) {
-    if (i == (current_blocksize - 1)) {
-      //  Last iteration, so notify m_ExternalSoftware
-      last = true;
-    }
+    return;
+  }
 
-    mini_buffer_size = m_Qscores[i].GetQScoreIntAsBinary (mini_buffer, max_buffer_size);
-    m_ExternalSoftware.Process (mini_buffer, mini_buffer_size, last);
+  RANS rc_out;
+  if (m_QScoresSettings.GetCompressionStreams () == g_RANS_STATES_MAX) {
+    rc_out.SetStates (g_RANS_STATES_MAX);
   }
-  free (mini_buffer);
+  rc_out.EncodeMessage (m_BitBuff_Out, m_Qscores.GetRead (0), m_Qscores.GetNumValues ());
+
+  return;
+}
+
+
+/*!
+     Encode the current block using an external compression system.
+
+     \param[in] current_blocksize The size of the current block
+*/
+void QScores::EncodeExternalBlock (int current_blocksize) {
+  //  The values of the block are already stored as bytes, one after another, so they are added all at once
+  const char *values = reinterpret_cast<const char *> (m_Qscores.GetRead (0));
+  m_ExternalSoftware.ProcessBlock (values, m_Qscores.GetNumValues ());
 
   unsigned int buffer_size = m_ExternalSoftware.GetOutBufferLength ();
-  char *buffer = m_ExternalSoftware.RetrieveChar ();
   
   //  Append size to bitbuffer
   m_BitBuff_Out.WriteUInts (&buffer_size, 1);
     
-  //  Append binary representation to bitbuffer
-  m_BitBuff_Out.WriteChars (buffer, buffer_size);
+  //  Append binary representation to bitbuffer straight from the output buffer
+  m_BitBuff_Out.WriteChars (m_ExternalSoftware.GetOutBuffer (), buffer_size);
 
-  //  Free memory
-  free (buffer);
-  
   //  Reset for next block
   m_ExternalSoftware.UnInitialize ();
   
   return;
 }
 
-
-/*!
-     Convert the integers to quality scores for printing (required for the --nocompress option).
-
-     \param[in] current_blocksize The size of the current block
-*/
-void QScores::EncodeIntToQScore (int current_blocksize) {
-  for (int i = 0; i < current_blocksize; i++) {
-//     m_Qscores[i].UnapplyFinalize ();
-    m_Qscores[i].IntToQScore ();
-  }
-  
-  return;
-}
@@ -52,8 +52,10 @@ using namespace std;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-local.hpp"
+#include "qscores-defn.hpp"
 #include "qscores.hpp"
 
 
@@ -66,3 +68,82 @@ void QScores::PerformExternalSoftwareCheck () {
   return;
 }
 
+
+/*!
+     Train a zstd dictionary on the first blocks, as they will be after PreprocessBlock (), and
+     write it out once, just after the settings.  Each read is a sample.  Blocks are read ahead
+     until there are GetZstdTrainingSize () bytes of samples, so small blocks are trained on as
+     much as large ones; the input file is then put back to just after the first block, which
+     is left as it was read in.  A dictionary only pays for itself if other blocks follow, so
+     none is trained if the first block is already short of m_Blocksize reads, and it is only
+     kept if it makes the blocks read ahead smaller, counting its own size.  Without a
+     dictionary, including when there are too few samples, its length is written as 0 and the
+     blocks are compressed without one.
+
+     \param[in] current_blocksize The size of the first block
+*/
+void QScores::EncodeDictionary (int current_blocksize) {
+  if ((current_blocksize == m_Blocksize) && (!m_Text_In.eof ())) {
+    QScoresBlock first = m_Qscores;
+    unsigned int first_read_length = m_BlockReadLength;
+    streampos second_block = m_Text_In.tellg ();
+    vector<char> samples;
+    vector<size_t> sample_sizes;
+    vector<size_t> block_sizes;
+    int blocksize = current_blocksize;
+
+    while (blocksize != g_EOF_REACHED) {
+      PreprocessBlock (blocksize);
+      const char *values = reinterpret_cast<const char *> (m_Qscores.GetRead (0));
+      samples.insert (samples.end (), values, values + m_Qscores.GetNumValues ());
+      for (unsigned int i = 0; i < m_Qscores.GetNumReads (); i++) {
+        sample_sizes.push_back (m_Qscores.GetReadLength (i));
+      }
+      block_sizes.push_back (m_Qscores.GetNumValues ());
+      if ((samples.size () >= m_ExternalSoftware.GetZstdTrainingSize ()) || (blocksize != m_Blocksize)) {
+        break;
+      }
+      blocksize = ReadInFileBlock (m_Blocksize);
+    }
+
+    m_ExternalSoftware.TrainZstdDictionary (samples.data (), sample_sizes, block_sizes);
+
+    m_Text_In.clear ();
+    m_Text_In.seekg (second_block);
+    m_Qscores.Swap (first);
+    m_BlockReadLength = first_read_length;
+  }
+
+  unsigned int dictionary_size = m_ExternalSoftware.GetZstdDictionaryLength ();
+  m_BitBuff_Out.WriteUInts (&dictionary_size, 1);
+  m_BitBuff_Out.WriteChars (m_ExternalSoftware.GetZstdDictionary (), dictionary_size);
+
+  if (GetVerbose ()) {
+    if (dictionary_size == 0) {
+      cerr << "II\tNo zstd dictionary is used." << endl;
+    }
+    else {
+      cerr << "II\tzstd dictionary of " << dictionary_size << " bytes trained on the first blocks." << endl;
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Read in the zstd dictionary written by EncodeDictionary () and give it to m_ExternalSoftware.
+*/
+void QScores::DecodeDictionary () {
+  unsigned int dictionary_size = 0;
+
+  if (m_QScoresSettings.GetAlignBlocks ()) {
+    m_BitBuff_In.AlignRead (g_CHAR_SIZE_BITS);
+  }
+  m_BitBuff_In.ReadUInts (&dictionary_size, 1);
+  vector<char> dictionary (dictionary_size);
+  m_BitBuff_In.ReadChars (dictionary.data (), dictionary_size);
+  m_ExternalSoftware.SetZstdDictionary (dictionary.data (), dictionary_size);
+
+  return;
+}
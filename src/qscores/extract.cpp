@@ -0,0 +1,144 @@
+//  ###########################################################################
+//  Copyright 2011-2015, 2024 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+
+/*******************************************************************/
+/*!
+    \file extract.cpp
+    Functions for decoding a range of reads.
+*/
+/*******************************************************************/
+
+#include <string>
+#include <vector>
+#include <climits>  //  UINT_MAX
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>  //  upper_bound
+
+using namespace std;
+
+#include "common.hpp"
+#include "external-software.hpp"
+#include "block-statistics.hpp"
+#include "bitbuffer.hpp"
+#include "qscores-single-defn.hpp"
+#include "qscores-single.hpp"
+#include "qscores-block.hpp"
+#include "qscores-settings.hpp"
+#include "qscores-local.hpp"
+#include "qscores-defn.hpp"
+#include "qscores.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+
+/*!
+     Decode the reads from first_read to last_read (inclusive) of the archive opened for
+     decoding and write them to out, one per line.  Reads are numbered from 1, as the lines of
+     the original file.
+
+     Only the blocks which contain these reads are decoded if the archive has a block index.
+     Otherwise, the blocks before them must be decoded to find where they are, but decoding
+     stops after the block containing last_read.
+
+     \param[in] first_read The first read to output
+     \param[in] last_read The last read to output
+     \param[in] out Output stream for the reads
+     \return The number of reads written
+*/
+unsigned long long QScores::DecodeReads (unsigned long long first_read, unsigned long long last_read, ostream &out) {
+  unsigned long long num_written = 0;
+  int block_count = 0;
+  unsigned long long block_first_read = 1;  //  Number of the first read in the current block
+
+  if (m_QScoresSettings.GetBlockIndex ()) {
+    block_count = SeekBlock (first_read);
+    if (block_count == g_EOF_REACHED) {
+      return (0);
+    }
+    block_first_read = m_BlockIndex[block_count].first_read + 1;
+  }
+
+  while (block_first_read <= last_read) {
+    m_Qscores.Clear ();
+
+    int current_blocksize = DecodeHeaderBlock (block_count);
+    if (current_blocksize == g_EOF_REACHED) {
+      break;
+    }
+
+    DecodeBlock (current_blocksize);
+
+    //  Output the reads of this block which are in the range
+    unsigned long long block_last_read = block_first_read + current_blocksize - 1;
+    if (block_last_read >= first_read) {
+      unsigned int start = static_cast<unsigned int> (max (first_read, block_first_read) - block_first_read);
+      unsigned int end = static_cast<unsigned int> (min (last_read, block_last_read) - block_first_read);
+      m_Qscores.WriteReads (out, start, end);
+      num_written += end - start + 1;
+    }
+
+    block_first_read = block_last_read + 1;
+    block_count++;
+  }
+
+  return (num_written);
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+
+/*!
+     Use the block index to move m_BitBuff_In to the block which contains a read, so that the
+     next call to DecodeHeaderBlock () decodes that block.  The file-level values are encoded
+     with the first block's header, so that header is decoded first.
+
+     \param[in] read The read to look for (from 1)
+     \return The ID of the block (from 0), or g_EOF_REACHED if the archive has fewer reads
+*/
+int QScores::SeekBlock (unsigned long long read) {
+  if ((m_BlockIndex.empty ()) ||
+      (read > m_BlockIndex.back ().first_read + m_BlockIndex.back ().num_reads)) {
+    return (g_EOF_REACHED);
+  }
+
+  //  Find the last block whose first read is at or before the read
+  vector<BlockIndexEntry>::iterator iter = upper_bound (m_BlockIndex.begin (), m_BlockIndex.end (), read - 1,
+    [] (unsigned long long x, const BlockIndexEntry &entry) { return (x < entry.first_read); });
+  int block = static_cast<int> (iter - m_BlockIndex.begin ()) - 1;
+
+  m_BitBuff_In.SeekRead (m_BlockIndex[0].offset);
+  if (block > 0) {
+    DecodeHeaderBlock (0);
+    m_BitBuff_In.SeekRead (m_BlockIndex[block].offset);
+  }
+
+  return (block);
+}
@@ -0,0 +1,175 @@
+//  ###########################################################################
+//  Copyright 2011-2015, 2024 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+
+/*******************************************************************/
+/*!
+    \file index.cpp
+    Functions for the block index at the end of the archive.
+*/
+/*******************************************************************/
+
+#include <string>
+#include <vector>
+#include <climits>  //  UINT_MAX
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+using namespace std;
+
+#include "common.hpp"
+#include "external-software.hpp"
+#include "block-statistics.hpp"
+#include "bitbuffer.hpp"
+#include "qscores-single-defn.hpp"
+#include "qscores-single.hpp"
+#include "qscores-block.hpp"
+#include "qscores-settings.hpp"
+#include "qscores-local.hpp"
+#include "qscores-defn.hpp"
+#include "qscores.hpp"
+
+
+/*!
+     Add the block which is about to be written to m_BitBuff_Out to the block index.  Blocks
+     are byte-aligned when there is a block index, so the block starts at a whole byte.
+
+     \param[in] num_reads The number of reads in the block
+*/
+void QScores::AddBlockIndexEntry (unsigned int num_reads) {
+  BlockIndexEntry entry;
+
+  entry.offset = m_BitBuff_Out.GetPosition () / g_CHAR_SIZE_BITS;
+  entry.num_reads = num_reads;
+  entry.first_read = 0;
+  if (!m_BlockIndex.empty ()) {
+    entry.first_read = m_BlockIndex.back ().first_read + m_BlockIndex.back ().num_reads;
+  }
+  m_BlockIndex.push_back (entry);
+
+  return;
+}
+
+
+/*!
+     Encode the block index after the end-of-file marker.  The index starts at an unsigned
+     int boundary and is made up of unsigned ints, each written with the most significant
+     bits first:
+
+       For each block:  offset (2), number of reads (1), first read (2)
+       Trailer:  offset of the index (2), number of blocks (1), g_BLOCK_INDEX_MAGIC (1)
+
+     Values which take two unsigned ints are written with the upper half first.  Only padding
+     follows the trailer, so it can be located from the end of the file.
+*/
+void QScores::EncodeBlockIndex () {
+  unsigned int buffer[2];
+
+  m_BitBuff_Out.AlignWrite (g_UINT_SIZE_BITS);
+  unsigned long long index_offset = m_BitBuff_Out.GetPosition () / g_CHAR_SIZE_BITS;
+
+  for (unsigned int i = 0; i < m_BlockIndex.size (); i++) {
+    buffer[0] = static_cast<unsigned int> (m_BlockIndex[i].offset >> g_UINT_SIZE_BITS);
+    buffer[1] = static_cast<unsigned int> (m_BlockIndex[i].offset);
+    m_BitBuff_Out.WriteUInts (buffer, 2);
+    m_BitBuff_Out.WriteUInts (&m_BlockIndex[i].num_reads, 1);
+    buffer[0] = static_cast<unsigned int> (m_BlockIndex[i].first_read >> g_UINT_SIZE_BITS);
+    buffer[1] = static_cast<unsigned int> (m_BlockIndex[i].first_read);
+    m_BitBuff_Out.WriteUInts (buffer, 2);
+  }
+
+  buffer[0] = static_cast<unsigned int> (index_offset >> g_UINT_SIZE_BITS);
+  buffer[1] = static_cast<unsigned int> (index_offset);
+  m_BitBuff_Out.WriteUInts (buffer, 2);
+  buffer[0] = static_cast<unsigned int> (m_BlockIndex.size ());
+  buffer[1] = g_BLOCK_INDEX_MAGIC;
+  m_BitBuff_Out.WriteUInts (buffer, 2);
+
+  return;
+}
+
+
+/*!
+     Read in the block index from the end of the input file into m_BlockIndex.  A separate
+     BitBuffer, sharing the mapping of the input file, is used so that m_BitBuff_In stays
+     at the first block.
+
+     \return Returns true on success, false if the block index could not be found.
+*/
+bool QScores::ReadBlockIndex () {
+  unsigned int buffer[2];
+  BitBuffer bitbuff_index;
+
+  //  Find the size of the file
+  ifstream fp (m_QScoresSettings.GetInputFn ().c_str (), ios::in|ios::binary);
+  fp.seekg (0, ios::end);
+  unsigned long long file_size = static_cast<unsigned long long> (fp.tellg ());
+  fp.close ();
+
+  //  Skip backwards over the padding added when the archive was flushed to find the trailer
+  bitbuff_index.Initialize (m_BitBuff_In);
+  unsigned long long trailer_end = file_size - (file_size % g_UINT_SIZE_BYTES);
+  while (true) {
+    if (trailer_end < g_BLOCK_INDEX_TRAILER_BYTES) {
+      cerr << "EE\tThe block index at the end of " << m_QScoresSettings.GetInputFn () << " could not be found." << endl;
+      return (false);
+    }
+    bitbuff_index.SeekRead (trailer_end - g_UINT_SIZE_BYTES);
+    bitbuff_index.ReadUInts (buffer, 1);
+    if (buffer[0] == g_BLOCK_INDEX_MAGIC) {
+      break;
+    }
+    if (buffer[0] != 0) {
+      cerr << "EE\tThe block index at the end of " << m_QScoresSettings.GetInputFn () << " could not be found." << endl;
+      return (false);
+    }
+    trailer_end -= g_UINT_SIZE_BYTES;
+  }
+
+  bitbuff_index.SeekRead (trailer_end - g_BLOCK_INDEX_TRAILER_BYTES);
+  bitbuff_index.ReadUInts (buffer, 2);
+  unsigned long long index_offset = (static_cast<unsigned long long> (buffer[0]) << g_UINT_SIZE_BITS) | buffer[1];
+  unsigned int num_blocks = 0;
+  bitbuff_index.ReadUInts (&num_blocks, 1);
+
+  //  Read in the entries
+  m_BlockIndex.clear ();
+  bitbuff_index.SeekRead (index_offset);
+  for (unsigned int i = 0; i < num_blocks; i++) {
+    BlockIndexEntry entry;
+
+    bitbuff_index.ReadUInts (buffer, 2);
+    entry.offset = (static_cast<unsigned long long> (buffer[0]) << g_UINT_SIZE_BITS) | buffer[1];
+    bitbuff_index.ReadUInts (&entry.num_reads, 1);
+    bitbuff_index.ReadUInts (buffer, 2);
+    entry.first_read = (static_cast<unsigned long long> (buffer[0]) << g_UINT_SIZE_BITS) | buffer[1];
+    m_BlockIndex.push_back (entry);
+  }
+  bitbuff_index.Finish ();
+
+  if (GetVerbose ()) {
+    cerr << "II\tBlock index of " << num_blocks << " blocks read from byte " << index_offset << "." << endl;
+  }
+
+  return (true);
+}
@@ -36,12 +36,14 @@
 
 using namespace std;
 
+#include "common.hpp"
 #include "external-software.hpp"
 #include "block-statistics.hpp"
 #include "bitbuffer.hpp"
 #include "qscores-local.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-defn.hpp"
 #include "qscores.hpp"
@@ -76,6 +78,9 @@ bool QScores::OpenFiles () {
     if (!m_QScoresSettings.GetCompressionNone ()) {
       m_BitBuff_Out.Initialize (m_QScoresSettings.GetOutputFn(), e_MODE_WRITE);
       m_QScoresSettings.WriteBinarySettings (m_BitBuff_Out);
+      if (m_QScoresSettings.GetAlignBlocks ()) {
+        m_BitBuff_Out.AlignWrite (g_CHAR_SIZE_BITS);
+      }
     }
     else {
       //  Open text output and check if it succeeded
@@ -88,8 +93,14 @@ bool QScores::OpenFiles () {
   }
   else {
     //  Binary input
-    m_BitBuff_In.Initialize (m_QScoresSettings.GetInputFn(), e_MODE_READ);
+    m_BitBuff_In.Initialize (m_QScoresSettings.GetInputFn(), e_MODE_MAPPED_READ);
     m_QScoresSettings.ReadBinarySettings (m_BitBuff_In);
+    if ((m_QScoresSettings.GetBlockIndex ()) && (!ReadBlockIndex ())) {
+      return false;
+    }
+    if (m_QScoresSettings.GetCompressionDictionary ()) {
+      DecodeDictionary ();
+    }
 
     //  Open text output and check if it succeeded
     m_Text_Out.open (m_QScoresSettings.GetOutputFn ().c_str (), ios::out);
@@ -140,8 +151,8 @@ int QScores::ReadInFileBlock (int blocksize) {
   unsigned int read_length = 0;
   bool lengths_same = true;  //  true/false whether all lengths the same in this block
 
-  //  Clear the vector of quality scores and assume the lengths all differ
-  m_Qscores.clear ();
+  //  Clear the quality scores and assume the lengths all differ
+  m_Qscores.Clear ();
   m_BlockReadLength = g_READ_LENGTH_VARIABLE;
 
   //  Check if EOF has already been reached
@@ -164,8 +175,7 @@ int QScores::ReadInFileBlock (int blocksize) {
       }
     }
 
-    //  Change the second argument to "true" to set to debug mode
-    m_Qscores.push_back (QScoresSingle (tmp, false));
+    m_Qscores.AddRead (tmp.data (), tmp.length ());
     num_qscores++;
   }
 
@@ -175,11 +185,6 @@ int QScores::ReadInFileBlock (int blocksize) {
     return (g_EOF_REACHED);
   }
 
-  //  Resize the array if the number of quality scores read is less than the blocksize
-  if (num_qscores != blocksize) {
-    m_Qscores.resize (num_qscores);
-  }
-
   //  All reads are the same length, so set the block's length
   if (lengths_same) {
     m_BlockReadLength = read_length;
@@ -192,17 +197,9 @@ int QScores::ReadInFileBlock (int blocksize) {
 /*!
      Write out a block of quality scores to file, which are each terminated by a newline.  Note that the quality 
      scores could include the newline character, which would make the location of the newline character ambigious.
-     
-     Values are 0-based.  To make them 1-based, change UnapplyFinalize () in QScoresSingle.
 */
 void QScores::WriteOutFileBlock () {
-  unsigned int num_qscores = 0;
-  string tmp;
-  
-  for (num_qscores = 0; num_qscores < m_Qscores.size (); num_qscores++) {
-//     cerr << num_qscores << "\t" << m_Qscores[num_qscores] << endl;
-    m_Text_Out << m_Qscores[num_qscores] << endl;
-  }
+  m_Text_Out << m_Qscores;
 
   return;
 }
@@ -41,6 +41,7 @@ using namespace std;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-defn.hpp"
 #include "qscores-settings.hpp"
 #include "qscores.hpp"
@@ -40,6 +40,7 @@ using namespace std;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-defn.hpp"
 #include "qscores.hpp"
@@ -123,3 +124,27 @@ void QScores::SetBlocksize (int x) {
 }
 
 
+
+
+/*!
+     Set the number of threads.
+
+     \param[in] x Number of threads
+*/
+void QScores::SetThreads (int x) {
+  m_Threads = x;
+  return;
+}
+
+
+/*!
+     Set the range of reads to decode.
+
+     \param[in] from First read (from 1)
+     \param[in] to Last read
+*/
+void QScores::SetReads (unsigned long long from, unsigned long long to) {
+  m_ReadsFrom = from;
+  m_ReadsTo = to;
+  return;
+}
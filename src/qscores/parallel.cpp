@@ -0,0 +1,385 @@
+//  ###########################################################################
+//  Copyright 2011-2015, 2024 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file parallel.cpp
+    Functions for processing blocks with multiple threads.
+*/
+/*******************************************************************/
+
+#include <string>
+#include <vector>
+#include <climits>  //  UINT_MAX
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>  //  max
+#include <memory>  //  unique_ptr
+#include <future>  //  async, future
+
+using namespace std;
+
+#include "common.hpp"
+#include "external-software.hpp"
+#include "block-statistics.hpp"
+#include "bitbuffer.hpp"
+#include "qscores-single-defn.hpp"
+#include "qscores-single.hpp"
+#include "qscores-block.hpp"
+#include "qscores-settings.hpp"
+#include "qscores-defn.hpp"
+#include "qscores.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+
+/*!
+     Encode the blocks of the input file using GetThreads () worker objects.
+
+     Blocks are read in by this object, one at a time, and handed to the next available worker.
+     Each worker preprocesses and encodes its block into a BitBuffer in memory while this object
+     continues reading.  The workers are visited in a round-robin fashion so that their output
+     is appended to m_BitBuff_Out in the same order as the blocks were read.  The output is
+     identical to encoding with a single thread.
+
+     With byte-aligned blocks, this function is used even with a single thread since the
+     length of each block must be known before it is written out.
+
+     The end-of-file marker is not encoded.
+
+     \return The number of blocks encoded
+*/
+int QScores::EncodeParallel () {
+  int block_count = 0;
+  unsigned int num_workers = static_cast<unsigned int> (GetThreads ());
+  vector<unique_ptr<QScores> > workers;
+  vector<future<void> > pending (num_workers);
+  vector<int> pending_blocksize (num_workers);
+
+  while (true) {
+    //  Read in the block
+    int current_blocksize = ReadInFileBlock (m_Blocksize);
+    if (current_blocksize == g_EOF_REACHED) {
+      break;
+    }
+
+    //  The file-level values are decided by the first block; see EncodeHeaderBlock ()
+    if (block_count == 0) {
+      m_FileReadLength = m_BlockReadLength;
+      m_FileBlockSize = current_blocksize;
+      if (m_QScoresSettings.GetCompressionDictionary ()) {
+        EncodeDictionary (current_blocksize);
+      }
+    }
+
+    //  Workers are only created for blocks which are read in, so there are never more workers than blocks
+    if (workers.size () < num_workers) {
+      workers.push_back (unique_ptr<QScores> (new QScores ()));
+      workers.back () -> InitializeWorker (*this);
+    }
+
+    //  Wait for the worker's previous block and append its encoded bits
+    QScores &worker = *(workers[block_count % num_workers]);
+    future<void> &result = pending[block_count % num_workers];
+    if (result.valid ()) {
+      result.get ();
+      AppendWorkerBlock (worker, pending_blocksize[block_count % num_workers]);
+    }
+
+    //  Hand the block over to the worker
+    worker.m_Qscores.Swap (m_Qscores);
+    worker.m_BlockReadLength = m_BlockReadLength;
+    worker.m_BitBuff_Out.Initialize (e_MODE_MEMORY_WRITE);
+    if (m_QScoresSettings.GetAlignBlocks ()) {
+      //  The length of a byte-aligned block is written as an unsigned int
+      worker.m_BitBuff_Out.SetMemoryLimit (UINT_MAX - 1);
+    }
+    pending_blocksize[block_count % num_workers] = current_blocksize;
+    result = async (launch::async, &QScores::EncodeBlock, &worker, current_blocksize, block_count);
+
+    block_count++;
+  }
+
+  //  Append the blocks which are still being encoded, in order
+  for (int i = max (0, block_count - static_cast<int> (num_workers)); i < block_count; i++) {
+    pending[i % num_workers].get ();
+    AppendWorkerBlock (*(workers[i % num_workers]), pending_blocksize[i % num_workers]);
+  }
+
+  return (block_count);
+}
+
+
+/*!
+     Decode the blocks of the input file using GetThreads () worker objects.
+
+     If the blocks are byte-aligned, each worker decodes whole blocks from its own view of the
+     input file; see DecodeParallelAligned ().  Otherwise, the lengths of the blocks are not
+     recorded, so the entropy decoding of the static codes, Huffman coding, and arithmetic
+     coding must be done by this object in order.  For the external
+     methods, only the compressed bytes are read in by this object and the decompression is left
+     to the worker.  The workers then undo the transformations of their blocks while this object
+     continues with the next one.  The workers are visited in a round-robin fashion so that the
+     blocks are written out in order.
+
+     \return The number of blocks decoded
+*/
+int QScores::DecodeParallel () {
+  int block_count = 0;
+  unsigned int num_workers = static_cast<unsigned int> (GetThreads ());
+  vector<unique_ptr<QScores> > workers;
+  vector<future<void> > pending (num_workers);
+  bool is_external = ((m_QScoresSettings.GetCompressionGzip ()) || (m_QScoresSettings.GetCompressionBzip ()) || (m_QScoresSettings.GetCompressionZstd ()) ||
+                      (m_QScoresSettings.GetCompressionLzma ()) || (m_QScoresSettings.GetCompressionBrotli ()));
+
+  if (m_QScoresSettings.GetAlignBlocks ()) {
+    return (DecodeParallelAligned ());
+  }
+
+  while (true) {
+    int current_blocksize = DecodeHeaderBlock (block_count);
+    if (current_blocksize == g_EOF_REACHED) {
+      break;
+    }
+
+    //  The settings are only complete after the header of the first block; see DecodeHeaderBlock ().
+    //  As when encoding, a worker is created for each block until there are num_workers of them.
+    if (workers.size () < num_workers) {
+      workers.push_back (unique_ptr<QScores> (new QScores ()));
+      workers.back () -> InitializeWorker (*this);
+    }
+
+    //  Wait for the worker's previous block and write it out
+    QScores &worker = *(workers[block_count % num_workers]);
+    future<void> &result = pending[block_count % num_workers];
+    if (result.valid ()) {
+      result.get ();
+      m_Qscores.Swap (worker.m_Qscores);
+      WriteOutFileBlock ();
+    }
+
+    //  Copy the values decoded from the header of the block
+    worker.m_BlockReadLength = m_BlockReadLength;
+    worker.m_BlockMinimum = m_BlockMinimum;
+    worker.m_BlockStatistics = m_BlockStatistics;
+    worker.m_CompressionParameter = m_CompressionParameter;
+
+    //  Decode the block, or just read it in, and hand it over to the worker
+    m_Qscores.Clear ();
+    if (is_external) {
+      ReadExternalBlock (worker.m_ExternalSoftware);
+    }
+    else if (m_QScoresSettings.GetCompressionHuffman ()) {
+      DecodeHuffmanBlock (current_blocksize);
+    }
+    else if (m_QScoresSettings.GetCompressionArithmetic ()) {
+      DecodeArithmeticBlock (current_blocksize);
+    }
+    else {
+      DecodeStaticCodesBlock (current_blocksize);
+    }
+    worker.m_Qscores.Swap (m_Qscores);
+    result = async (launch::async, &QScores::DecodeWorkerBlock, &worker, current_blocksize);
+
+    block_count++;
+  }
+
+  //  Write out the blocks which are still being decoded, in order
+  for (int i = max (0, block_count - static_cast<int> (num_workers)); i < block_count; i++) {
+    pending[i % num_workers].get ();
+    m_Qscores.Swap (workers[i % num_workers] -> m_Qscores);
+    WriteOutFileBlock ();
+  }
+
+  return (block_count);
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+
+/*!
+     Set up this object as a worker which processes blocks on behalf of another QScores object.
+     The settings are copied, but no files are opened.
+
+     \param[in] parent The QScores object which reads and writes the files
+*/
+void QScores::InitializeWorker (const QScores &parent) {
+  m_Debug = parent.m_Debug;
+  m_Encode = parent.m_Encode;
+  m_Decode = parent.m_Decode;
+  m_Blocksize = parent.m_Blocksize;
+  m_QScoresSettings = parent.m_QScoresSettings;
+  m_FileReadLength = parent.m_FileReadLength;
+  m_FileBlockSize = parent.m_FileBlockSize;
+
+  Initialize ();
+  m_ExternalSoftware.SetZstdDictionary (parent.m_ExternalSoftware.GetZstdDictionary (), parent.m_ExternalSoftware.GetZstdDictionaryLength ());
+
+  return;
+}
+
+
+/*!
+     Append the block encoded by a worker to m_BitBuff_Out.  With byte-aligned blocks, the
+     block is preceded by its length in bytes, as an unsigned int.
+
+     \param[in] worker The worker which encoded the block
+     \param[in] current_blocksize Number of reads in the block
+*/
+void QScores::AppendWorkerBlock (const QScores &worker, int current_blocksize) {
+  if (m_QScoresSettings.GetBlockIndex ()) {
+    AddBlockIndexEntry (current_blocksize);
+  }
+
+  //  The limit set in EncodeParallel () keeps the length of the block within an unsigned int
+  if (m_QScoresSettings.GetAlignBlocks ()) {
+    unsigned int tmp = static_cast<unsigned int> (worker.m_BitBuff_Out.GetPosition () / g_CHAR_SIZE_BITS);
+    m_BitBuff_Out.WriteUInts (&tmp, 1);
+  }
+
+  m_BitBuff_Out.WriteBitBuffer (worker.m_BitBuff_Out);
+  m_CodewordLimitRaised = max (m_CodewordLimitRaised, worker.m_CodewordLimitRaised);
+
+  return;
+}
+
+
+/*!
+     Decode the blocks of the input file using GetThreads () worker objects, when the blocks
+     are byte-aligned.
+
+     This object only reads the length of each block in order to skip to the next one.  The
+     workers share the memory mapping of the input file, each with its own position, and decode
+     whole blocks, including their headers, from where they start.  The workers are visited in a round-robin fashion so that the blocks are
+     written out in order.
+
+     \return The number of blocks decoded
+*/
+int QScores::DecodeParallelAligned () {
+  int block_count = 0;
+  unsigned int num_workers = static_cast<unsigned int> (GetThreads ());
+  vector<unique_ptr<QScores> > workers;
+  vector<future<void> > pending (num_workers);
+
+  while (true) {
+    m_BitBuff_In.AlignRead (g_CHAR_SIZE_BITS);
+    unsigned long long offset = m_BitBuff_In.GetPosition () / g_CHAR_SIZE_BITS;
+    unsigned int block_length = 0;
+    m_BitBuff_In.ReadUInts (&block_length, 1);
+    if (block_length == 0) {
+      break;
+    }
+
+    //  The settings are only complete after the header of the first block; see DecodeHeaderBlock ()
+    if (block_count == 0) {
+      m_BitBuff_In.SeekRead (offset);
+      DecodeHeaderBlock (0);
+    }
+    if (workers.size () < num_workers) {
+      workers.push_back (unique_ptr<QScores> (new QScores ()));
+      workers.back () -> InitializeWorker (*this);
+      workers.back () -> m_BlockIndex = m_BlockIndex;
+      workers.back () -> m_BitBuff_In.Initialize (m_BitBuff_In);
+    }
+
+    //  Wait for the worker's previous block and write it out
+    QScores &worker = *(workers[block_count % num_workers]);
+    future<void> &result = pending[block_count % num_workers];
+    if (result.valid ()) {
+      result.get ();
+      m_Qscores.Swap (worker.m_Qscores);
+      WriteOutFileBlock ();
+    }
+
+    result = async (launch::async, &QScores::DecodeWorkerAlignedBlock, &worker, offset, block_count);
+
+    //  Skip over the block
+    m_BitBuff_In.SeekRead (offset + g_UINT_SIZE_BYTES + block_length);
+    block_count++;
+  }
+
+  //  Write out the blocks which are still being decoded, in order
+  for (int i = max (0, block_count - static_cast<int> (num_workers)); i < block_count; i++) {
+    pending[i % num_workers].get ();
+    m_Qscores.Swap (workers[i % num_workers] -> m_Qscores);
+    WriteOutFileBlock ();
+  }
+
+  return (block_count);
+}
+
+
+/*!
+     Decode a whole byte-aligned block on behalf of DecodeParallelAligned ().
+
+     \param[in] offset Position of the block in the input file, in bytes
+     \param[in] block_count Block ID (from 0)
+*/
+void QScores::DecodeWorkerAlignedBlock (unsigned long long offset, int block_count) {
+  m_BitBuff_In.SeekRead (offset);
+  m_Qscores.Clear ();
+
+  int current_blocksize = DecodeHeaderBlock (block_count);
+  DecodeBlock (current_blocksize);
+
+  return;
+}
+
+
+/*!
+     Complete the decoding of a block on behalf of DecodeParallel ().  The compressed bytes of
+     a block from an external method are decompressed, and then the transformations are undone.
+
+     \param[in] current_blocksize Number of reads in this block
+*/
+void QScores::DecodeWorkerBlock (int current_blocksize) {
+  if ((m_QScoresSettings.GetCompressionGzip ()) || (m_QScoresSettings.GetCompressionBzip ()) || (m_QScoresSettings.GetCompressionZstd ()) ||
+      (m_QScoresSettings.GetCompressionLzma ()) || (m_QScoresSettings.GetCompressionBrotli ())) {
+    UnProcessExternalBlock (current_blocksize);
+  }
+  UnPreprocessBlock (current_blocksize);
+
+  return;
+}
+
+
+/*!
+     Determine if the selected compression method can be run by multiple threads at once.  Each
+     worker's gzip and bzip2 programs use their own pipes or temporary directory, so the
+     programs are allowed as well as the libraries.
+
+     \return Returns true if blocks can be processed in parallel.
+*/
+bool QScores::IsParallelSupported () const {
+  if ((m_QScoresSettings.GetCompressionRepair ()) || (m_QScoresSettings.GetCompressionPPM ())) {
+    return (false);
+  }
+
+  return (true);
+}
@@ -55,6 +55,7 @@ namespace po = boost::program_options;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-local.hpp"
 #include "qscores-defn.hpp"
@@ -106,6 +107,10 @@ bool QScores::ProcessOptions (int argc, char *argv[]) {
       ("output", po::value<string>(), "Output filename.")
       ("mapping", po::value<string>(), "Quality scores mapping [sanger* | solexa | illumina].")
       ("blocksize", po::value<int>() -> default_value (INT_MAX), "Block size [Infinite size*].")
+      ("threads", po::value<int>() -> default_value (1), "Number of threads, up to 256; blocks are processed in parallel, so there should be at least as many blocks [1*].")
+      ("align", "Byte-align the blocks and record their lengths so that they can be decoded independently.")
+      ("index", "Add a block index to the end of the archive; implies --align.")
+      ("reads", po::value<string>(), "Decode only the reads FROM-TO (from 1, inclusive) [All*].")
       ;
 
     po::options_description lossy ("Lossy transformation options");
@@ -132,7 +137,10 @@ bool QScores::ProcessOptions (int argc, char *argv[]) {
       ("rice", "Rice coding")
       ("interp", "Interpolative coding")
       ("huffman", "Huffman coding")
-      ("arithmetic", "Arithmetic coding (unavailable)")
+      ("maxcodelen", po::value<unsigned int>() -> default_value (0), "Longest codeword allowed for Huffman coding, but at least ceil(log2(number of symbols)); 11 or less decodes every codeword with one table look-up [0* (no limit)].")
+      ("streams", po::value<unsigned int>() -> default_value (1), "Number of interleaved streams per block for Huffman coding, where more than 1 implies --align [1* | 4 | 8]; or states for arithmetic coding, where 32 decodes with AVX2 if available [1* | 32].")
+      ("arithmetic", "Arithmetic coding, using rANS with static frequencies for each block")
+      ("context", "With --arithmetic, code each quality score adaptively in the context of the previous scores and its position in the read")
       ("param", po::value<unsigned int>() -> default_value (UINT_MAX), "Global parameter for Golomb or Rice coding [Default:  Use block-based parameters.]")
       ;
 
@@ -140,7 +148,12 @@ bool QScores::ProcessOptions (int argc, char *argv[]) {
     ext_compression.add_options ()
       ("gzip", "gzip")
       ("bzip", "bzip2")
+      ("chunked", "With --gzip or --bzip, split each block into chunks which are compressed independently by the threads, like pigz and pbzip2")
       ("repair", "Re-Pair (unavailable)")
+      ("zstd", po::value<int>(), "zstd, at the given level [1 to 22; 19 is suggested]")
+      ("dictionary", "With --zstd, train a dictionary on the first blocks and store it once in the archive, if it makes them smaller")
+      ("xz", "xz/LZMA, at the highest preset (-9e)")
+      ("brotli", "Brotli, at the highest quality")
       ("ppm", "PPM (unavailable)")
       ;
 
@@ -238,6 +251,30 @@ bool QScores::ProcessOptions (int argc, char *argv[]) {
       SetBlocksize (vm["blocksize"].as<int>());
     }
 
+    if (vm.count ("threads")) {
+      SetThreads (vm["threads"].as<int>());
+    }
+
+    if (vm.count ("align")) {
+      m_QScoresSettings.SetAlignBlocks ();
+    }
+
+    if (vm.count ("index")) {
+      m_QScoresSettings.SetAlignBlocks ();
+      m_QScoresSettings.SetBlockIndex ();
+    }
+
+    if (vm.count ("reads")) {
+      string range = vm["reads"].as<string>();
+      size_t pos = range.find ('-');
+      if ((pos == string::npos) || (pos == 0) || (pos == range.length () - 1) ||
+          (range.find_first_not_of ("0123456789-") != string::npos) || (range.find ('-', pos + 1) != string::npos)) {
+        cerr << "EE\tThe range accompanying --reads must be of the form FROM-TO." << endl;
+        exit (EXIT_FAILURE);
+      }
+      SetReads (stoull (range.substr (0, pos)), stoull (range.substr (pos + 1)));
+    }
+
     //  -----------------------------------------------------------------
     //  Lossy transformation options
     //  -----------------------------------------------------------------
@@ -308,10 +345,24 @@ bool QScores::ProcessOptions (int argc, char *argv[]) {
       m_QScoresSettings.SetCompressionHuffman ();
     }
 
+    if (vm.count ("maxcodelen")) {
+      m_QScoresSettings.SetCompressionCodewordLimit (vm["maxcodelen"].as<unsigned int>());
+    }
+
+    //  The Huffman streams of a block are read from where they start in the file, so blocks must start at a whole byte
+    if (vm.count ("streams")) {
+      m_QScoresSettings.SetCompressionStreams (vm["streams"].as<unsigned int>());
+      if ((m_QScoresSettings.GetCompressionHuffman ()) && (m_QScoresSettings.GetCompressionStreams () != g_DEFAULT_HUFFMAN_STREAMS)) {
+        m_QScoresSettings.SetAlignBlocks ();
+      }
+    }
+
     if (vm.count ("arithmetic")) {
       m_QScoresSettings.SetCompressionArithmetic ();
-      cerr << "EE\t--arithmetic has not been implemented yet." << endl;
-      exit (EXIT_FAILURE);
+    }
+
+    if (vm.count ("context")) {
+      m_QScoresSettings.SetCompressionContext ();
     }
 
     if (vm.count ("gzip")) {
@@ -322,6 +373,27 @@ bool QScores::ProcessOptions (int argc, char *argv[]) {
       m_QScoresSettings.SetCompressionBzip ();
     }
 
+    if (vm.count ("chunked")) {
+      m_QScoresSettings.SetCompressionChunked ();
+    }
+
+    if (vm.count ("zstd")) {
+      m_QScoresSettings.SetCompressionZstd ();
+      m_QScoresSettings.SetCompressionZstdLevel (vm["zstd"].as<int>());
+    }
+
+    if (vm.count ("dictionary")) {
+      m_QScoresSettings.SetCompressionDictionary ();
+    }
+
+    if (vm.count ("xz")) {
+      m_QScoresSettings.SetCompressionLzma ();
+    }
+
+    if (vm.count ("brotli")) {
+      m_QScoresSettings.SetCompressionBrotli ();
+    }
+
     if (vm.count ("repair")) {
       m_QScoresSettings.SetCompressionRepair ();
       cerr << "EE\t--repair has not been implemented yet." << endl;
@@ -375,6 +447,15 @@ bool QScores::CheckSettings () {
     }
   }
 
+  if (GetThreads () < 1) {
+    cerr << "EE\tThe number of threads accompanying --threads must be at least 1." << endl;
+    exit (EXIT_FAILURE);
+  }
+  else if (GetThreads () > g_MAX_THREADS) {
+    cerr << "WW\tThe number of threads accompanying --threads is more than " << g_MAX_THREADS << "; using " << g_MAX_THREADS << " threads." << endl;
+    SetThreads (g_MAX_THREADS);
+  }
+
   if (m_QScoresSettings.GetQScoresMapping () == e_QSCORES_MAP_UNSET) {
     m_QScoresSettings.SetQScoresMapping ("sanger");  //  Sanger is the default method
   }
@@ -384,6 +465,22 @@ bool QScores::CheckSettings () {
     exit (EXIT_FAILURE);
   }
 
+  if (GetReadsTo () != 0) {
+    if (!GetDecode ()) {
+      cerr << "EE\tThe --reads option is only valid with decoding.  Please use the --decode option." << endl;
+      exit (EXIT_FAILURE);
+    }
+    if ((GetReadsFrom () == 0) || (GetReadsFrom () > GetReadsTo ())) {
+      cerr << "EE\tThe range accompanying --reads must satisfy 1 <= FROM <= TO." << endl;
+      exit (EXIT_FAILURE);
+    }
+  }
+
+  if ((m_QScoresSettings.GetAlignBlocks ()) && (m_QScoresSettings.GetCompressionNone ())) {
+    cerr << "EE\tBlocks cannot be byte-aligned or indexed when no compression is performed." << endl;
+    exit (EXIT_FAILURE);
+  }
+
   //  Pass debug parameters to other objects here
   if (GetDebug ()) {
     m_QScoresSettings.SetDebug ();
@@ -397,6 +494,10 @@ bool QScores::CheckSettings () {
     if (GetEncode ()) {
       cerr << left << setw (g_VERBOSE_WIDTH) << "II\tBlocksize:" << GetBlocksize () << endl;
     }
+    cerr << left << setw (g_VERBOSE_WIDTH) << "II\tThreads:" << GetThreads () << endl;
+    if (GetReadsTo () != 0) {
+      cerr << left << setw (g_VERBOSE_WIDTH) << "II\tReads:" << GetReadsFrom () << "-" << GetReadsTo () << endl;
+    }
   }
 
   //  Any output that follows is not related to parameters; so add some space
@@ -36,5 +36,21 @@ const int g_NO_BLOCKSIZE = INT_MAX;
 //!  Special value to indicate EOF has been reached
 const int g_EOF_REACHED = -1;
 
+//!  Most threads accepted by --threads; each one has its own QScores worker object
+const int g_MAX_THREADS = 256;
+
+/*!
+    \struct BlockIndexEntry
+    \details An entry of the block index, which describes where a block is in the archive.
+*/
+struct BlockIndexEntry {
+  //!  Position of the block in the archive, in bytes
+  unsigned long long offset;
+  //!  Number of reads in the block
+  unsigned int num_reads;
+  //!  Position of the first read of the block in the input file (from 0)
+  unsigned long long first_read;
+};
+
 #endif
 
@@ -42,5 +42,11 @@ const unsigned int g_EXTERNAL_BUFFER_SIZE = 1048576;
 //!  Special value indicating that the read length varies
 const unsigned int g_READ_LENGTH_VARIABLE = UINT_MAX;
 
+//!  Last unsigned int of the block index trailer ("QSIX")
+const unsigned int g_BLOCK_INDEX_MAGIC = 0x51534958;
+
+//!  Size of the block index trailer in bytes; see QScores::EncodeBlockIndex ()
+const unsigned int g_BLOCK_INDEX_TRAILER_BYTES = 16;
+
 #endif
 
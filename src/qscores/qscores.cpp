@@ -36,11 +36,15 @@
 
 using namespace std;
 
+//  Pull the configuration file in
+#include "QScores_Config.hpp"
+
 #include "external-software.hpp"
 #include "block-statistics.hpp"
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-defn.hpp"
 #include "qscores.hpp"
@@ -54,17 +58,23 @@ QScores::QScores()
     m_ExternalSoftwareCheck (false),
     m_BinningCheck (false),
     m_UnbinningCheck (false),
+    m_Threads (1),
+    m_ReadsFrom (0),
+    m_ReadsTo (0),
     m_BitBuff_In (),
     m_BitBuff_Out (),
     m_Text_In (),
     m_Text_Out (),
     m_QScoresSettings (),
     m_ExternalSoftware (),
-    m_Qscores (0),
+    m_Qscores (),
     m_FileReadLength (0),
     m_FileBlockSize (0),
+    m_BlockIndex (),
+    m_CodewordLimitRaised (0),
     m_BlockReadLength (0),
     m_Blocksize (INT_MAX),
+    m_BlockLength (0),
     m_BlockMinimum (0),
     m_BlockStatistics (),
     m_CompressionParameter (UINT_MAX),
@@ -98,6 +108,35 @@ bool QScores::Initialize () {
   else if (m_QScoresSettings.GetCompressionBzip ()) {
     m_ExternalSoftware.Initialize (e_EXTERNAL_METHOD_BZIP_BZLIB, encode);
   }
+  else if (m_QScoresSettings.GetCompressionZstd ()) {
+    //  Unlike gzip and bzip2, there is no fallback to an external program; likewise for xz/LZMA and Brotli
+    if (!g_USE_ZSTD) {
+      cerr << "EE\tzstd requires the zstd library, which was not found when compiling." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_ExternalSoftware.Initialize (e_EXTERNAL_METHOD_ZSTD, encode);
+    m_ExternalSoftware.SetCompressionLevel (m_QScoresSettings.GetCompressionZstdLevel ());
+  }
+  else if (m_QScoresSettings.GetCompressionLzma ()) {
+    if (!g_USE_LZMA) {
+      cerr << "EE\txz/LZMA requires the liblzma library, which was not found when compiling." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_ExternalSoftware.Initialize (e_EXTERNAL_METHOD_LZMA, encode);
+  }
+  else if (m_QScoresSettings.GetCompressionBrotli ()) {
+    if (!g_USE_BROTLI) {
+      cerr << "EE\tBrotli requires the Brotli libraries, which were not found when compiling." << endl;
+      exit (EXIT_FAILURE);
+    }
+    m_ExternalSoftware.Initialize (e_EXTERNAL_METHOD_BROTLI, encode);
+  }
+
+  //  Workers of EncodeParallel () and DecodeParallel () have 1 thread, so their chunks are not split further
+  if (m_QScoresSettings.GetCompressionChunked ()) {
+    m_ExternalSoftware.SetChunked ();
+    m_ExternalSoftware.SetThreads (GetThreads ());
+  }
   
   return true;
 }
@@ -45,6 +45,10 @@ class QScores {
     //  Execution  [run.cpp]
     bool Run ();
 
+    //  Multithreaded execution  [parallel.cpp]
+    int EncodeParallel ();
+    int DecodeParallel ();
+
     //  Parameter checking  [parameters.cpp]
     bool ProcessOptions (int argc, char *argv[]);
     bool CheckSettings ();
@@ -63,20 +67,35 @@ class QScores {
 
     //  Block encoding functions  [encode.cpp]
     void EncodeEOF ();
+    void EncodeBlock (int current_blocksize, int block_count);
     void EncodeHeaderBlock (int current_blocksize, int block_count);
     void EncodeStaticCodesBlock (int current_blocksize);
     void EncodeHuffmanBlock (int current_blocksize);
+    void EncodeArithmeticBlock (int current_blocksize);
     void EncodeExternalBlock (int current_blocksize);
-    void EncodeIntToQScore (int current_blocksize);
 
     //  Block decoding functions  [decode.cpp]
     int DecodeHeaderBlock (int block_count);
     void DecodeStaticCodesBlock (int current_blocksize);
     void DecodeHuffmanBlock (int current_blocksize);
+    void DecodeArithmeticBlock (int current_blocksize);
     void DecodeExternalBlock (int current_blocksize);
+    void DecodeBlock (int current_blocksize);
+    void ReadExternalBlock (ExternalSoftware &external_software);
+    void UnProcessExternalBlock (int current_blocksize);
+
+    //  Read extraction  [extract.cpp]
+    unsigned long long DecodeReads (unsigned long long first_read, unsigned long long last_read, ostream &out);
+
+    //  Block index  [index.cpp]
+    void AddBlockIndexEntry (unsigned int num_reads);
+    void EncodeBlockIndex ();
+    bool ReadBlockIndex ();
 
     //  External compression software [external.cpp]
     void PerformExternalSoftwareCheck ();
+    void EncodeDictionary (int current_blocksize);
+    void DecodeDictionary ();
     
     //  Accessors  [accessors.cpp]
     bool GetDebug () const;
@@ -89,6 +108,9 @@ class QScores {
     enum e_QSCORES_MAP GetQScoresMapping () const;
     string GetQScoresMappingStr () const;
     int GetBlocksize () const;
+    int GetThreads () const;
+    unsigned long long GetReadsFrom () const;
+    unsigned long long GetReadsTo () const;
     
     //  Mutators  [mutators.cpp]
     void SetDebug ();
@@ -100,7 +122,20 @@ class QScores {
     void SetUnbinningCheck ();
     void SetQScoresMapping (string x);
     void SetBlocksize (int x);
+    void SetThreads (int x);
+    void SetReads (unsigned long long from, unsigned long long to);
   private:
+    //  Read extraction  [extract.cpp]
+    int SeekBlock (unsigned long long read);
+
+    //  Multithreaded execution  [parallel.cpp]
+    void InitializeWorker (const QScores &parent);
+    bool IsParallelSupported () const;
+    void AppendWorkerBlock (const QScores &worker, int current_blocksize);
+    int DecodeParallelAligned ();
+    void DecodeWorkerBlock (int current_blocksize);
+    void DecodeWorkerAlignedBlock (unsigned long long offset, int block_count);
+
     //!  Debug mode?
     bool m_Debug;
     //!  Verbose mode?
@@ -115,10 +150,16 @@ class QScores {
     bool m_BinningCheck;
     //!  Output the reverse bins created from lossy binning
     bool m_UnbinningCheck;
+    //!  Number of threads used to process blocks
+    int m_Threads;
+    //!  First read to decode (from 1); 0 if all of the reads are decoded
+    unsigned long long m_ReadsFrom;
+    //!  Last read to decode
+    unsigned long long m_ReadsTo;
     
     //!  Input bitbuffer
     BitBuffer m_BitBuff_In;
-    //!  Output bitbuffer
+    //!  Output bitbuffer; in memory if this object is a worker for another one
     BitBuffer m_BitBuff_Out;
     //!  Input file pointer for text
     ifstream m_Text_In;
@@ -131,20 +172,26 @@ class QScores {
     //!  Management of external software
     ExternalSoftware m_ExternalSoftware;
     
-    //!  Vector of quality score objects
-    vector <QScoresSingle> m_Qscores;
+    //!  Quality scores of the current block
+    QScoresBlock m_Qscores;
 
     //!  Read length for the entire data file
     unsigned int m_FileReadLength;
     //!  Block size fo the entire file
     int m_FileBlockSize;
+    //!  Location of each block in the archive; only used with a block index
+    vector<BlockIndexEntry> m_BlockIndex;
+    //!  Longest Huffman codeword of any block whose symbols needed more than --maxcodelen bits; 0 if none did
+    unsigned int m_CodewordLimitRaised;
     
-    //  Variables related to the current block; need to make them into a vector of values
-    //  to make this work for multiple processors
+    //  Variables related to the current block; with multiple threads, each block is
+    //  processed by a separate worker object which has its own copy of them
     //!  Read length for the block; encoded as 0 if same as m_FileReadLength for this block
     unsigned int m_BlockReadLength;
     //!  Block size
     int m_Blocksize;
+    //!  Length of the block in bytes, after the length itself; only with byte-aligned blocks
+    unsigned int m_BlockLength;
     //!  Minimum for the current block
     unsigned int m_BlockMinimum;
     //!  Statistics for the current block
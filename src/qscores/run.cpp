@@ -42,6 +42,7 @@ using namespace std;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "qscores-defn.hpp"
 #include "qscores.hpp"
@@ -79,49 +80,52 @@ bool QScores::Run() {
       cerr << "II\tEncoding data file..." << endl;
     }
 
-    while (true) {
-      //  Read in the block
-      int current_blocksize = ReadInFileBlock (m_Blocksize);      
-      if (current_blocksize == g_EOF_REACHED) {
-        if (!m_QScoresSettings.GetCompressionNone ()) {
-          EncodeEOF ();
-        }
-        
-        if (GetVerbose ()) {
-          cerr << "II\t" << block_count << " blocks created of at most " << m_Blocksize << " reads each." << endl;
-        }
-        break;
-      }
-      PreprocessBlock (current_blocksize);
+    if ((GetThreads () > 1) && (!m_QScoresSettings.GetCompressionNone ()) && (!IsParallelSupported ())) {
+      cerr << "WW\tThe external program for this compression method cannot be run by multiple threads; using 1 thread." << endl;
+      SetThreads (1);
+    }
 
-      if (m_QScoresSettings.GetCompressionNone ()) {
-        EncodeIntToQScore (current_blocksize);
+    //  Byte-aligned blocks are staged in memory by a worker so that their length is known; otherwise,
+    //  chunked blocks are compressed one at a time, with the threads sharing the chunks of each block
+    if ((!m_QScoresSettings.GetCompressionNone ()) &&
+        (((GetThreads () > 1) && (!m_QScoresSettings.GetCompressionChunked ())) || (m_QScoresSettings.GetAlignBlocks ()))) {
+      block_count = EncodeParallel ();
+      EncodeEOF ();
+      if ((GetThreads () > 1) && (GetThreads () > block_count)) {
+        cerr << "WW\tOnly " << block_count << " blocks were encoded, so at most " << block_count << " of the " << GetThreads () << " threads were used; a smaller --blocksize makes more blocks." << endl;
       }
-      else {
-        EncodeHeaderBlock (current_blocksize, block_count);
-        if ((m_QScoresSettings.GetCompressionBinary ()) ||
-            (m_QScoresSettings.GetCompressionGamma ()) ||
-            (m_QScoresSettings.GetCompressionDelta ()) ||
-            (m_QScoresSettings.GetCompressionGolomb () > 0) ||
-            (m_QScoresSettings.GetCompressionRice () > 0) ||
-            (m_QScoresSettings.GetCompressionInterP ())) {
-          EncodeStaticCodesBlock (current_blocksize);
+    }
+    else {
+      while (true) {
+        //  Read in the block
+        int current_blocksize = ReadInFileBlock (m_Blocksize);
+        if (current_blocksize == g_EOF_REACHED) {
+          if (!m_QScoresSettings.GetCompressionNone ()) {
+            EncodeEOF ();
+          }
+          break;
         }
-        else if (m_QScoresSettings.GetCompressionHuffman ()) {
-          EncodeHuffmanBlock (current_blocksize);
+
+        if (m_QScoresSettings.GetCompressionNone ()) {
+          PreprocessBlock (current_blocksize);
+          WriteOutFileBlock ();
         }
-        else if ((m_QScoresSettings.GetCompressionGzip ()) ||
-                 (m_QScoresSettings.GetCompressionBzip ()) ||
-                 (m_QScoresSettings.GetCompressionRepair ()) ||
-                 (m_QScoresSettings.GetCompressionPPM ())) {
-          EncodeExternalBlock (current_blocksize);
+        else {
+          if ((block_count == 0) && (m_QScoresSettings.GetCompressionDictionary ())) {
+            EncodeDictionary (current_blocksize);
+          }
+          EncodeBlock (current_blocksize, block_count);
         }
+        block_count++;
       }
+    }
 
-      if (m_QScoresSettings.GetCompressionNone ()) {
-        WriteOutFileBlock ();
-      }
-      block_count++;
+    if (m_CodewordLimitRaised != 0) {
+      cerr << "WW\tThe limit accompanying --maxcodelen is less than ceil(log2(number of symbols)) for some blocks; their codewords have up to " << m_CodewordLimitRaised << " bits." << endl;
+    }
+
+    if (GetVerbose ()) {
+      cerr << "II\t" << block_count << " blocks created of at most " << m_Blocksize << " reads each." << endl;
     }
   }
   else {
@@ -130,39 +134,44 @@ bool QScores::Run() {
       cerr << "II\tDecoding data file..." << endl;
     }
     
-    int current_blocksize = g_EOF_REACHED;
-    while (1) {
-      //  Clear the vector of quality scores
-      m_Qscores.clear ();
-
-      current_blocksize = DecodeHeaderBlock (block_count);
-      if (current_blocksize == g_EOF_REACHED) {
-        if (GetVerbose ()) {
-          cerr << "II\t" << block_count << " blocks decoded." << endl;
-        }
-        break;
+    if (GetReadsTo () != 0) {
+      unsigned long long num_reads = DecodeReads (GetReadsFrom (), GetReadsTo (), m_Text_Out);
+      if (GetVerbose ()) {
+        cerr << "II\t" << num_reads << " reads decoded." << endl;
+      }
+    }
+    else {
+      if ((GetThreads () > 1) && (!IsParallelSupported ())) {
+        cerr << "WW\tThe external program for this compression method cannot be run by multiple threads; using 1 thread." << endl;
+        SetThreads (1);
       }
 
-      if ((m_QScoresSettings.GetCompressionBinary ()) ||
-          (m_QScoresSettings.GetCompressionGamma ()) ||
-          (m_QScoresSettings.GetCompressionDelta ()) ||
-          (m_QScoresSettings.GetCompressionGolomb () > 0) ||
-          (m_QScoresSettings.GetCompressionRice () > 0) ||
-          (m_QScoresSettings.GetCompressionInterP ())) {          
-        DecodeStaticCodesBlock (current_blocksize);
+      //  As when encoding, the threads share the chunks of each block unless the blocks are aligned
+      if ((GetThreads () > 1) && ((!m_QScoresSettings.GetCompressionChunked ()) || (m_QScoresSettings.GetAlignBlocks ()))) {
+        block_count = DecodeParallel ();
+        if ((GetThreads () > 1) && (GetThreads () > block_count)) {
+          cerr << "WW\tOnly " << block_count << " blocks were decoded, so at most " << block_count << " of the " << GetThreads () << " threads were used." << endl;
+        }
       }
-      else if (m_QScoresSettings.GetCompressionHuffman ()) {
-        DecodeHuffmanBlock (current_blocksize);
+      else {
+        while (true) {
+          //  Clear the quality scores of the previous block
+          m_Qscores.Clear ();
+
+          int current_blocksize = DecodeHeaderBlock (block_count);
+          if (current_blocksize == g_EOF_REACHED) {
+            break;
+          }
+
+          DecodeBlock (current_blocksize);
+          WriteOutFileBlock ();
+          block_count++;
+        }
       }
-      else if ((m_QScoresSettings.GetCompressionGzip ()) ||
-               (m_QScoresSettings.GetCompressionBzip ()) ||
-               (m_QScoresSettings.GetCompressionRepair ()) ||
-               (m_QScoresSettings.GetCompressionPPM ())) {
-        DecodeExternalBlock (current_blocksize);
+
+      if (GetVerbose ()) {
+        cerr << "II\t" << block_count << " blocks decoded." << endl;
       }
-      UnPreprocessBlock (current_blocksize);
-      WriteOutFileBlock ();
-      block_count++;
     }
   }
 
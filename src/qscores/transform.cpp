@@ -42,8 +42,10 @@ using namespace std;
 #include "bitbuffer.hpp"
 #include "qscores-single-defn.hpp"
 #include "qscores-single.hpp"
+#include "qscores-block.hpp"
 #include "qscores-settings.hpp"
 #include "binning.hpp"
+#include "qscores-defn.hpp"
 #include "qscores.hpp"
 
 
@@ -149,99 +151,72 @@ void QScores::PerformUnbinningCheck () {
 
 
 /*!
-     Preprocess a block of quality scores.  Several passes over the block are made:
+     Preprocess a block of quality scores.  All of the transformations are applied in two
+     passes over the values of the block:
 
-     1)  Map the quality scores to integers and apply lossy transformations
-     2)  Rescaling requires a single pass to find the overall minimum in the block.
-     3)  Perform the actual rescaling.
-     4)  Collect statistics over the block if Remapping was selected.
-     5)  Perform remapping and then finalize.
+     1)  Apply the lossy transformation and difference coding, while counting how many
+         times each resulting value occurs.
+     2)  Perform rescaling and remapping with a single lookup table.
 
-     Some of the loops can be merged -- for example, step 4 can be added to the end of step 3 to
-     save one loop.  However, we've separated it into 5 loops to divide up the process and
-     (hopefully) make this source code easier to read.
+     The minimum for rescaling and the statistics for remapping are both found from the
+     counts of the first pass, without another pass over the block.
 
      \param[in] current_blocksize The size of the current block
 */
 void QScores::PreprocessBlock (int current_blocksize) {
   vector<unsigned int> lossy_mapping;
   vector<unsigned int> lossless_mapping;
+  vector<unsigned long long> counts;
 
-  //  Calculate the lookup table of lossy mappings, once per block
-  if (m_QScoresSettings.GetLossyLogBinning ()) {
+  //  Calculate the lookup table of lossy mappings, once per block; truncation is a lookup table too
+  if (m_QScoresSettings.GetLossyMinTruncation ()) {
+    unsigned int param = static_cast<unsigned int> (m_QScoresSettings.GetLossyMinTruncationParameter ());
+    for (unsigned int i = 0; i <= g_QSCORES_BLOCK_VALUE_MAX; i++) {
+      lossy_mapping.push_back ((i < param) ? param : i);
+    }
+  }
+  else if (m_QScoresSettings.GetLossyMaxTruncation ()) {
+    unsigned int param = static_cast<unsigned int> (m_QScoresSettings.GetLossyMaxTruncationParameter ());
+    for (unsigned int i = 0; i <= g_QSCORES_BLOCK_VALUE_MAX; i++) {
+      lossy_mapping.push_back ((i > param) ? param : i);
+    }
+  }
+  else if (m_QScoresSettings.GetLossyLogBinning ()) {
     lossy_mapping = GenerateLookup_LogBinning (m_QScoresSettings.GetQScoresMapping (), static_cast<unsigned int> (m_QScoresSettings.GetLossyLogBinningParameter ()));
   }
   else if (m_QScoresSettings.GetLossyUniBinning ()) {
     lossy_mapping = GenerateLookup_UniBinning (m_QScoresSettings.GetQScoresMapping (), static_cast<unsigned int> (m_QScoresSettings.GetLossyUniBinningParameter ()));
   }
 
-  //  Map quality scores to integers and then perform lossy transformations
-  for (int i = 0; i < current_blocksize; i++) {
-    //  Map quality scores to ASCII
-    m_Qscores[i].QScoreToInt ();
-
-    //  Lossy transformations, order does not matter since they do not conflict
-    if (m_QScoresSettings.GetLossyMinTruncation ()) {
-      m_Qscores[i].ApplyLossyMinTruncation (static_cast<unsigned int> (m_QScoresSettings.GetLossyMinTruncationParameter ()));
-    }
-    else if (m_QScoresSettings.GetLossyMaxTruncation ()) {
-      m_Qscores[i].ApplyLossyMaxTruncation (static_cast<unsigned int> (m_QScoresSettings.GetLossyMaxTruncationParameter ()));
-    }
-    else if (m_QScoresSettings.GetLossyLogBinning ()) {
-      m_Qscores[i].ApplyLossyRemapping (lossy_mapping);
-    }
-    else if (m_QScoresSettings.GetLossyUniBinning ()) {
-      m_Qscores[i].ApplyLossyRemapping (lossy_mapping);
-    }
-  }
-
-  //  Lossless transformation -- apply difference coding
-  if (m_QScoresSettings.GetTransformGapTrans ()) {
-    unsigned int previous = UINT_MAX;
-    for (int i = 0; i < current_blocksize; i++) {
-      previous = m_Qscores[i].ApplyDifferenceCoding (previous);
-    }
-  }
+  //  First pass -- lossy transformation and difference coding
+  m_Qscores.ApplyMappingAndDifferenceCoding (lossy_mapping, m_QScoresSettings.GetTransformGapTrans (), counts);
 
-  //  Lossless transformation -- need to find the minimum for rescaling
+  //  The minimum for rescaling is the smallest value which occurs
   m_BlockMinimum = UINT_MAX;
   if (m_QScoresSettings.GetTransformMinShift ()) {
-    for (int i = 0; i < current_blocksize; i++) {
-      m_Qscores[i].SetMinMax ();
-      unsigned int tmp = m_Qscores[i].GetMin ();
-      if (tmp < m_BlockMinimum) {
-        m_BlockMinimum = tmp;
+    for (unsigned int i = 0; i < counts.size (); i++) {
+      if (counts[i] != 0) {
+        m_BlockMinimum = i;
+        break;
       }
     }
   }
 
-  //  Lossless transformation -- perform rescaling
+  unsigned int shift = 0;
   if ((m_QScoresSettings.GetTransformMinShift ()) && (m_BlockMinimum != 0)) {
-    for (int i = 0; i < current_blocksize; i++) {
-      m_Qscores[i].ApplyRescaling (m_BlockMinimum);
-    }
+    shift = m_BlockMinimum;
   }
-  
-  //  Lossless transformation -- need to prepare to collect the statistics for remapping
+
+  //  Collect the statistics for remapping from the counts, as they will be after rescaling
   if (m_QScoresSettings.GetTransformFreqOrder ()) {
     m_BlockStatistics.Initialize ();
-
-    for (int i = 0; i < current_blocksize; i++) {
-      m_BlockStatistics.UpdateFrequencyTable (m_Qscores[i].GetQScoreInt ());
-    }
+    m_BlockStatistics.UpdateFrequencyTable (counts, shift);
     lossless_mapping = m_BlockStatistics.GetQScoresToIDs ();
   }
-  
-  //  Lossless transformation -- Perform remapping (if requested) and then finalize
-  for (int i = 0; i < current_blocksize; i++) {
-    if (m_QScoresSettings.GetTransformFreqOrder ()) {
-      m_Qscores[i].ApplyLosslessRemapping (lossless_mapping);
-    }
 
-    //  Finalize (required) -- shift by 1 to prevent a 0 from ever appearing beyond this point
-//     m_Qscores[i].ApplyFinalize ();
-  }
-  
+  //  Second pass -- rescaling and remapping
+  m_Qscores.ApplyRescalingAndRemapping (shift, lossless_mapping);
+
   return;
 }
 
@@ -253,9 +228,7 @@ void QScores::PreprocessBlock (int current_blocksize) {
 */
 void QScores::UnPreprocessBlock (int current_blocksize) {
   vector<unsigned int> lossy_mapping;
-  vector<unsigned int> lossless_remapping;
-  unsigned int previous = UINT_MAX;
-  
+
   //  Calculate the lookup table of lossy mappings, once per block
   if (m_QScoresSettings.GetLossyLogBinning ()) {
     lossy_mapping = GenerateReverseLookup_LogBinning (m_QScoresSettings.GetQScoresMapping (), static_cast<unsigned int> (m_QScoresSettings.GetLossyLogBinningParameter ()));
@@ -263,38 +236,27 @@ void QScores::UnPreprocessBlock (int current_blocksize) {
   else if (m_QScoresSettings.GetLossyUniBinning ()) {
     lossy_mapping = GenerateReverseLookup_UniBinning (m_QScoresSettings.GetQScoresMapping (), static_cast<unsigned int> (m_QScoresSettings.GetLossyUniBinningParameter ()));
   }
-  
+
+  //  Reverse everything done by PreprocessBlock (), except for the lossy transformations
   if (m_QScoresSettings.GetTransformFreqOrder ()) {
-    lossless_remapping = m_BlockStatistics.GetIDsToQScores ();
+    m_Qscores.UnapplyLosslessRemapping (m_BlockStatistics.GetIDsToQScores ());
   }
-  //  Reverse everything done by PreprocessBlock (), except for the lossy transformations
-  for (int i = 0; i < current_blocksize; i++) {
-//     m_Qscores[i].UnapplyFinalize ();
-
-    if (m_QScoresSettings.GetTransformFreqOrder ()) {
-      m_Qscores[i].UnapplyLosslessRemapping (lossless_remapping);
-    }
-    
-    if ((m_QScoresSettings.GetTransformMinShift ()) && (m_BlockMinimum != 0)) {
-      m_Qscores[i].UnapplyRescaling (m_BlockMinimum);
-    }
 
-    if (m_QScoresSettings.GetTransformGapTrans ()) {
-      previous = m_Qscores[i].UnapplyDifferenceCoding (previous);
-    }
+  if ((m_QScoresSettings.GetTransformMinShift ()) && (m_BlockMinimum != 0)) {
+    m_Qscores.UnapplyRescaling (m_BlockMinimum);
+  }
 
-    //  Lossy transformations
-    if (m_QScoresSettings.GetLossyLogBinning ()) {
-      m_Qscores[i].UnapplyLossyRemapping (lossy_mapping);
-    }
-    else if (m_QScoresSettings.GetLossyUniBinning ()) {
-      m_Qscores[i].UnapplyLossyRemapping (lossy_mapping);
-    }
+  if (m_QScoresSettings.GetTransformGapTrans ()) {
+    m_Qscores.UnapplyDifferenceCoding ();
+  }
 
-    //  Map quality scores to ASCII
-    m_Qscores[i].IntToQScore ();
+  //  Lossy transformations
+  if (m_QScoresSettings.GetLossyLogBinning ()) {
+    m_Qscores.UnapplyLossyRemapping (lossy_mapping);
   }
-  
+  else if (m_QScoresSettings.GetLossyUniBinning ()) {
+    m_Qscores.UnapplyLossyRemapping (lossy_mapping);
+  }
+
   return;
 }
-
@@ -0,0 +1,269 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file decode.cpp
+    Decoding functions for RANS class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <climits>  //  UINT_MAX
+#include <limits>  //  numeric_limits
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "bitio-defn.hpp"
+#include "rans.hpp"
+#include "simd.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Local functions
+//  -----------------------------------------------------------------
+
+/*!
+     Decode one symbol from a state and move a word into the state if it has fallen below
+     the lower bound.  This is done without branching, since whether a word is needed is
+     unpredictable.
+
+     \param[in,out] state The state
+     \param[in] table The decoding table
+     \param[in,out] ptr The next word to move into a state; the word at end must be readable
+     \param[in] end The end of the words
+     \return The symbol
+*/
+static inline unsigned int DecodeSymbol (unsigned int &state, const RANSTableEntry *table, const unsigned short *&ptr, const unsigned short *end) {
+  const unsigned int mask = (1U << g_RANS_SCALE_BITS) - 1;
+  const RANSTableEntry &entry = table[state & mask];
+
+  state = entry.frequency * (state >> g_RANS_SCALE_BITS) + (state & mask) - entry.start;
+  bool renormalise = ((state < g_RANS_LOWER_BOUND) && (ptr < end));
+  unsigned int word = *ptr;
+  state = renormalise ? ((state << g_RANS_WORD_BITS) | word) : state;
+  ptr += renormalise;
+
+  return (entry.symbol);
+}
+
+
+/*!
+     Decode whole rounds of symbols, in which each state decodes one symbol.  The look-ups
+     of a round are independent of each other.
+
+     \param[in,out] state The states
+     \param[in] states The number of states
+     \param[in] table The decoding table
+     \param[in,out] ptr The next word to move into a state
+     \param[in] end The end of the words
+     \param[out] result Where to write the symbols
+     \param[in] length The number of symbols in the message
+     \return The number of symbols decoded
+*/
+template <typename T>
+static inline unsigned int DecodeRounds (unsigned int *state, unsigned int states, const RANSTableEntry *table, const unsigned short *&ptr, const unsigned short *end, T *result, unsigned int length) {
+  unsigned int i = 0;
+
+  for (; i + states <= length; i += states) {
+    for (unsigned int j = 0; j < states; j++) {
+      result[i + j] = static_cast<T> (DecodeSymbol (state[j], table, ptr, end));
+    }
+  }
+
+  return (i);
+}
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+/*!
+     Decode a whole message written by EncodeMessage ().
+
+     \param[in] bitbuffer The BitBuffer to read from
+     \return The message
+*/
+vector<unsigned int> RANS::DecodeMessage (BitBuffer &bitbuffer) {
+  m_MessageLength = Delta_Decode (bitbuffer) - 1;
+  vector<unsigned int> result (m_MessageLength);
+  if (m_MessageLength == 0) {
+    return (result);
+  }
+
+  DecodeSymbols (bitbuffer, result.data ());
+
+  return (result);
+}
+
+
+/*!
+     Decode a whole message written by EncodeMessage () into an array of bytes, whose
+     length is already known.
+
+     \param[in] bitbuffer The BitBuffer to read from
+     \param[out] x Where to write the symbols
+     \param[in] len The number of symbols expected
+*/
+void RANS::DecodeMessage (BitBuffer &bitbuffer, unsigned char *x, unsigned long long len) {
+  m_MessageLength = Delta_Decode (bitbuffer) - 1;
+  if (m_MessageLength != len) {
+    cerr << "EE\tExpected " << len << " symbols, but the rANS coded message has " << m_MessageLength << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+  if (m_MessageLength == 0) {
+    return;
+  }
+
+  DecodeSymbols (bitbuffer, x);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Decode the symbols of a message whose length has been read, which is shared by the
+     DecodeMessage () functions.
+
+     \param[in] bitbuffer The BitBuffer to read from
+     \param[out] x Where to write the m_MessageLength symbols
+*/
+template <typename T>
+void RANS::DecodeSymbols (BitBuffer &bitbuffer, T *x) {
+  DecodeFrequencies (bitbuffer);
+  if (m_MaximumSymbol > numeric_limits<T>::max ()) {
+    cerr << "EE\tThe rANS coded symbol " << m_MaximumSymbol << " is too large to decode." << endl;
+    exit (EXIT_FAILURE);
+  }
+  BuildDecodeTable ();
+
+  unsigned int num_words = Delta_Decode (bitbuffer);
+  if (num_words < 2 * m_States) {
+    cerr << "EE\tThe rANS coded message is too short (" << num_words << " words)." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  //  Words after the end which DecodeSymbol () and AVX2_Decode () can read but never use
+  vector<unsigned short> words (num_words + g_AVX2_WORDS_PADDING, 0);
+  for (unsigned int i = 0; i < num_words; i++) {
+    words[i] = static_cast<unsigned short> (bitbuffer.Peek (g_RANS_WORD_BITS));
+    bitbuffer.Consume (g_RANS_WORD_BITS);
+  }
+
+  const unsigned short *ptr = words.data ();
+  const unsigned short *end = words.data () + num_words;
+  const RANSTableEntry *table = m_DecodeTable.data ();
+
+  unsigned int state[g_RANS_STATES_MAX];
+  for (unsigned int j = 0; j < m_States; j++) {
+    state[j] = (static_cast<unsigned int> (ptr[0]) << g_RANS_WORD_BITS) | ptr[1];
+    ptr += 2;
+  }
+
+  //  The default number of states is given as a constant, so that the loop is unrolled
+  unsigned int i = 0;
+  if (m_States == g_RANS_STATES) {
+    i = DecodeRounds (state, g_RANS_STATES, table, ptr, end, x, m_MessageLength);
+  }
+  else if ((m_States == g_RANS_STATES_MAX) && (m_SIMD) && (AVX2_Available ())) {
+    i = AVX2_Decode (state, table, ptr, end, x, m_MessageLength);
+  }
+  else {
+    i = DecodeRounds (state, m_States, table, ptr, end, x, m_MessageLength);
+  }
+  for (; i < m_MessageLength; i++) {
+    x[i] = static_cast<T> (DecodeSymbol (state[i % m_States], table, ptr, end));
+  }
+
+  //  The encoder started each state from the lower bound and every word should have been used
+  bool valid = (ptr == end);
+  for (unsigned int j = 0; j < m_States; j++) {
+    if (state[j] != g_RANS_LOWER_BOUND) {
+      valid = false;
+    }
+  }
+  if (!valid) {
+    cerr << "EE\tThe rANS coded message could not be decoded." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  if (m_Debug) {
+    cerr << "II\tDecoded " << m_MessageLength << " symbols from " << num_words << " words." << endl;
+  }
+
+  return;
+}
+
+
+/*!
+     Decode the normalised frequencies written by EncodeFrequencies () and check that
+     they sum to (1 << g_RANS_SCALE_BITS).
+
+     \param[in] bitbuffer The BitBuffer to read from
+*/
+void RANS::DecodeFrequencies (BitBuffer &bitbuffer) {
+  unsigned long long total = 0;
+
+  m_MaximumSymbol = Delta_Decode (bitbuffer) - 1;
+  m_Frequencies.assign (m_MaximumSymbol + 1, 0);
+  for (unsigned int i = 0; i <= m_MaximumSymbol; i++) {
+    m_Frequencies[i] = Delta_Decode (bitbuffer) - 1;
+    total += m_Frequencies[i];
+  }
+
+  if (total != (1ULL << g_RANS_SCALE_BITS)) {
+    cerr << "EE\tThe rANS frequencies sum to " << total << " instead of " << (1U << g_RANS_SCALE_BITS) << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  SetCumulative ();
+
+  return;
+}
+
+
+/*!
+     Build the decoding table, which gives the symbol, frequency, and cumulative frequency
+     for each of the (1 << g_RANS_SCALE_BITS) slots.
+*/
+void RANS::BuildDecodeTable () {
+  m_DecodeTable.resize (1U << g_RANS_SCALE_BITS);
+  for (unsigned int i = 0; i < m_Frequencies.size (); i++) {
+    for (unsigned int j = 0; j < m_Frequencies[i]; j++) {
+      m_DecodeTable[m_Cumulative[i] + j].symbol = i;
+      m_DecodeTable[m_Cumulative[i] + j].frequency = m_Frequencies[i];
+      m_DecodeTable[m_Cumulative[i] + j].start = m_Cumulative[i];
+    }
+  }
+
+  return;
+}
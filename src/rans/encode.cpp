@@ -0,0 +1,163 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file encode.cpp
+    Encoding functions for RANS class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <climits>  //  UINT_MAX
+#include <algorithm>  //  reverse
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "bitio-defn.hpp"
+#include "rans.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Public functions
+//  -----------------------------------------------------------------
+
+/*!
+     Encode a whole message.  Its length and normalised frequencies are written first,
+     followed by the number of 16-bit words of the encoded message and the words themselves.
+     A message longer than g_RANS_MESSAGE_MAX exits with an error.
+
+     \param[in] bitbuffer The BitBuffer to write to
+     \param[in] x The message
+*/
+void RANS::EncodeMessage (BitBuffer &bitbuffer, const vector<unsigned int> &x) {
+  EncodeSymbols (bitbuffer, x.data (), x.size ());
+
+  return;
+}
+
+
+/*!
+     Encode a whole message of byte values, such as the quality scores of a QScoresBlock,
+     without copying it into a vector first.  The output is the same as EncodeMessage ()
+     gives for the same values in a vector.
+
+     \param[in] bitbuffer The BitBuffer to write to
+     \param[in] x The message
+     \param[in] len The number of values
+*/
+void RANS::EncodeMessage (BitBuffer &bitbuffer, const unsigned char *x, unsigned long long len) {
+  EncodeSymbols (bitbuffer, x, len);
+
+  return;
+}
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Encode a whole message for EncodeMessage (), whatever the type of its symbols.
+
+     \param[in] bitbuffer The BitBuffer to write to
+     \param[in] x The message
+     \param[in] len The number of symbols
+*/
+template <typename T>
+void RANS::EncodeSymbols (BitBuffer &bitbuffer, const T *x, size_t len) {
+  if (len > g_RANS_MESSAGE_MAX) {
+    cerr << "EE\tAt most " << g_RANS_MESSAGE_MAX << " symbols can be rANS coded at once; found " << len << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  UpdateFrequencies (x, len);
+
+  Delta_Encode (bitbuffer, m_MessageLength + 1);
+  if (m_MessageLength == 0) {
+    return;
+  }
+
+  NormaliseFrequencies ();
+  SetCumulative ();
+  EncodeFrequencies (bitbuffer);
+
+  //  Encode from the end of the message, so that the decoder starts from its beginning
+  vector<unsigned short> words;
+  words.reserve (len / 4 + 2 * m_States);
+  unsigned int state[g_RANS_STATES_MAX];
+  for (unsigned int j = 0; j < m_States; j++) {
+    state[j] = g_RANS_LOWER_BOUND;
+  }
+  for (size_t i = len; i > 0; i--) {
+    unsigned int &curr = state[(i - 1) % m_States];
+    unsigned int frequency = m_Frequencies[x[i - 1]];
+
+    //  Move a word out of the state if the symbol would take it past the upper bound
+    unsigned long long state_max = static_cast<unsigned long long> (g_RANS_LOWER_BOUND >> g_RANS_SCALE_BITS) << g_RANS_WORD_BITS;
+    if (curr >= state_max * frequency) {
+      words.push_back (static_cast<unsigned short> (curr & 0xFFFF));
+      curr >>= g_RANS_WORD_BITS;
+    }
+
+    curr = ((curr / frequency) << g_RANS_SCALE_BITS) + (curr % frequency) + m_Cumulative[x[i - 1]];
+  }
+
+  //  The final states are read first by the decoder, starting with state 0
+  for (unsigned int j = m_States; j > 0; j--) {
+    words.push_back (static_cast<unsigned short> (state[j - 1] & 0xFFFF));
+    words.push_back (static_cast<unsigned short> (state[j - 1] >> g_RANS_WORD_BITS));
+  }
+  reverse (words.begin (), words.end ());
+
+  Delta_Encode (bitbuffer, words.size ());
+  for (unsigned int i = 0; i < words.size (); i++) {
+    bitbuffer.WriteBits (words[i], g_RANS_WORD_BITS);
+  }
+
+  if (m_Debug) {
+    cerr << "II\tEncoded " << m_MessageLength << " symbols in " << words.size () << " words." << endl;
+  }
+
+  return;
+}
+
+
+/*!
+     Encode the normalised frequencies of all of the symbols up to the maximum symbol.
+     A symbol which does not occur costs a single bit.
+
+     \param[in] bitbuffer The BitBuffer to write to
+*/
+void RANS::EncodeFrequencies (BitBuffer &bitbuffer) {
+  Delta_Encode (bitbuffer, m_MaximumSymbol + 1);
+  for (unsigned int i = 0; i <= m_MaximumSymbol; i++) {
+    Delta_Encode (bitbuffer, m_Frequencies[i] + 1);
+  }
+
+  return;
+}
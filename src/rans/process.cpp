@@ -0,0 +1,155 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file process.cpp
+    Processing functions for RANS class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "rans.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Private functions
+//  -----------------------------------------------------------------
+
+/*!
+     Count the number of times each symbol occurs in the message.
+
+     \param[in] x The message
+     \param[in] len The number of symbols
+*/
+void RANS::UpdateFrequencies (const unsigned int *x, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    unsigned int pos = x[i];
+    if (pos >= m_Counts.size ()) {
+      m_Counts.resize (pos + 1, 0);
+    }
+    m_Counts[pos]++;
+  }
+  m_MessageLength += len;
+  m_MaximumSymbol = m_Counts.size () - 1;
+
+  return;
+}
+
+
+/*!
+     Count the number of times each value occurs in a message of byte values.
+
+     \param[in] x The message
+     \param[in] len The number of values
+*/
+void RANS::UpdateFrequencies (const unsigned char *x, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    unsigned int pos = x[i];
+    if (pos >= m_Counts.size ()) {
+      m_Counts.resize (pos + 1, 0);
+    }
+    m_Counts[pos]++;
+  }
+  m_MessageLength += len;
+  m_MaximumSymbol = m_Counts.size () - 1;
+
+  return;
+}
+
+
+/*!
+     Scale the counts so that they sum to (1 << g_RANS_SCALE_BITS), without letting
+     any symbol which occurs fall to 0.  The rounding error is made up one unit at a time
+     by the symbol with the largest frequency, where it costs the least.
+*/
+void RANS::NormaliseFrequencies () {
+  const unsigned int scale = (1U << g_RANS_SCALE_BITS);
+  unsigned int total = 0;
+  unsigned int distinct = 0;
+
+  m_Frequencies.assign (m_Counts.size (), 0);
+  for (unsigned int i = 0; i < m_Counts.size (); i++) {
+    if (m_Counts[i] != 0) {
+      m_Frequencies[i] = static_cast<unsigned int> ((m_Counts[i] * scale) / m_MessageLength);
+      if (m_Frequencies[i] == 0) {
+        m_Frequencies[i] = 1;
+      }
+      total += m_Frequencies[i];
+      distinct++;
+    }
+  }
+
+  if (distinct > scale) {
+    cerr << "EE\tAt most " << scale << " distinct symbols can be rANS coded; found " << distinct << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+
+  while (total != scale) {
+    unsigned int largest = 0;
+    for (unsigned int i = 1; i < m_Frequencies.size (); i++) {
+      if (m_Frequencies[i] > m_Frequencies[largest]) {
+        largest = i;
+      }
+    }
+
+    if (total < scale) {
+      m_Frequencies[largest] += (scale - total);
+      total = scale;
+    }
+    else {
+      //  Take back as much as possible from the largest frequency; others might be needed
+      unsigned int excess = total - scale;
+      if (excess > m_Frequencies[largest] / 2) {
+        excess = m_Frequencies[largest] / 2;
+      }
+      m_Frequencies[largest] -= excess;
+      total -= excess;
+    }
+  }
+
+  return;
+}
+
+
+/*!
+     Set the cumulative frequencies from the normalised frequencies
+*/
+void RANS::SetCumulative () {
+  unsigned int sum = 0;
+
+  m_Cumulative.assign (m_Frequencies.size (), 0);
+  for (unsigned int i = 0; i < m_Frequencies.size (); i++) {
+    m_Cumulative[i] = sum;
+    sum += m_Frequencies[i];
+  }
+
+  return;
+}
@@ -0,0 +1,195 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file rans.cpp
+    Constructor and destructor for RANS class definition .
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "rans.hpp"
+
+
+//  -----------------------------------------------------------------
+//  Friends
+//  -----------------------------------------------------------------
+
+
+/*!
+     Overloaded << operator defined as a friend of RANS for debugging purposes.
+
+     \param[in] os Output stream
+     \param[in] rc RANS passed as reference
+     \return Output stream
+*/
+ostream &operator<< (ostream &os, const RANS& rc) {
+  os << "II\tMessage length:  " << rc.m_MessageLength << endl;
+  for (unsigned int i = 0; i < rc.m_Frequencies.size (); i++) {
+    if (rc.m_Frequencies[i] != 0) {
+      os << "II\t" << i << "\t" << rc.m_Frequencies[i] << "\t" << rc.m_Cumulative[i] << endl;
+    }
+  }
+
+  return os;
+}
+
+
+//  -----------------------------------------------------------------
+//  Constructors and destructors
+//  -----------------------------------------------------------------
+
+
+/*!
+     Default constructor that takes one optional argument.
+
+     \param[in] debug Set to true if in debug mode; false by default
+*/
+RANS::RANS (bool debug)
+  : m_Debug (debug),
+    m_MessageLength (0),
+    m_MaximumSymbol (0),
+    m_States (g_RANS_STATES),
+    m_SIMD (true),
+    m_Counts (),
+    m_Frequencies (),
+    m_Cumulative (),
+    m_DecodeTable ()
+{
+}
+
+
+/*!
+     Destructor that takes no arguments
+*/
+RANS::~RANS () {
+}
+
+
+//  -----------------------------------------------------------------
+//  Accessors and mutators
+//  -----------------------------------------------------------------
+
+/*!
+     Return m_Debug
+
+     \return Debug mode or not
+*/
+bool RANS::GetDebug () const {
+  return m_Debug;
+}
+
+
+/*!
+     Set m_Debug to true
+*/
+void RANS::SetDebug () {
+  m_Debug = true;
+}
+
+
+/*!
+     Return the length of the message
+
+     \return Length of the message
+*/
+unsigned int RANS::GetMessageLength () const {
+  return m_MessageLength;
+}
+
+
+/*!
+     Return the largest symbol in the message
+
+     \return Maximum symbol
+*/
+unsigned int RANS::GetMaximumSymbol () const {
+  return m_MaximumSymbol;
+}
+
+
+/*!
+     Return the normalised frequency of a symbol
+
+     \param[in] symbol The symbol
+     \return Its normalised frequency; 0 if it does not occur
+*/
+unsigned int RANS::GetFrequency (unsigned int symbol) const {
+  if (symbol >= m_Frequencies.size ()) {
+    return 0;
+  }
+
+  return m_Frequencies[symbol];
+}
+
+
+/*!
+     Return the number of states
+
+     \return Number of states
+*/
+unsigned int RANS::GetStates () const {
+  return m_States;
+}
+
+
+/*!
+     Set the number of states that take turns to code the symbols
+
+     \param[in] x Number of states, from 1 to g_RANS_STATES_MAX
+*/
+void RANS::SetStates (unsigned int x) {
+  if ((x == 0) || (x > g_RANS_STATES_MAX)) {
+    cerr << "EE\tThe number of rANS states must be from 1 to " << g_RANS_STATES_MAX << "." << endl;
+    exit (EXIT_FAILURE);
+  }
+  m_States = x;
+}
+
+
+/*!
+     Return whether SIMD instructions are used to decode
+
+     \return true if they are used when the processor has them
+*/
+bool RANS::GetSIMD () const {
+  return m_SIMD;
+}
+
+
+/*!
+     Set whether SIMD instructions are used to decode, if the processor has them
+
+     \param[in] x false to always use the portable decoder
+*/
+void RANS::SetSIMD (bool x) {
+  m_SIMD = x;
+}
@@ -0,0 +1,195 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file rans.hpp
+    Header file for RANS class.
+*/
+/*******************************************************************/
+
+#ifndef RANS_HPP
+#define RANS_HPP
+
+
+/*!
+     Number of bits of precision of the normalised frequencies; they sum to
+     (1 << g_RANS_SCALE_BITS).
+*/
+const unsigned int g_RANS_SCALE_BITS = 12;
+
+
+/*!
+     Number of bits moved in and out of a state at a time
+*/
+const unsigned int g_RANS_WORD_BITS = 16;
+
+
+/*!
+     Lower bound of the coder's state.  The state is kept in [g_RANS_LOWER_BOUND,
+     g_RANS_LOWER_BOUND << g_RANS_WORD_BITS) by moving whole words in and out of it.
+     Since the state falls by less than g_RANS_WORD_BITS bits per symbol, at most one
+     word is needed to bring it back.
+*/
+const unsigned int g_RANS_LOWER_BOUND = (1U << 16);
+
+
+/*!
+     Number of states that take turns to code the symbols of a message, by default
+*/
+const unsigned int g_RANS_STATES = 4;
+
+
+/*!
+     Largest number of states.  With this many, DecodeMessage () decodes 8 states at a
+     time with AVX2 instructions if the processor has them.
+*/
+const unsigned int g_RANS_STATES_MAX = 32;
+
+
+/*!
+     Longest message that can be coded.  Its length plus one and the number of words, which
+     is at most one per symbol and two per state, are written as unsigned ints.
+*/
+const unsigned int g_RANS_MESSAGE_MAX = UINT_MAX - 2 * g_RANS_STATES_MAX - 1;
+
+
+/*!
+     Entry of the decoding table, indexed by the low g_RANS_SCALE_BITS bits of the state
+*/
+struct RANSTableEntry {
+  //!  Symbol whose range of slots contains this one
+  unsigned int symbol;
+  //!  Normalised frequency of the symbol
+  unsigned short frequency;
+  //!  First slot of the symbol (i.e., its cumulative frequency)
+  unsigned short start;
+};
+
+
+/*!
+    \class RANS
+
+    \details Class used to represent range asymmetric numeral systems (rANS) coding, as
+    described by J. Duda in "Asymmetric numeral systems: entropy coding combining speed of
+    Huffman coding with compression rate of arithmetic coding" [2013].  The implementation
+    uses a 32-bit state which is renormalised 16 bits at a time.
+
+    The frequencies are static for each message.  They are counted from the message,
+    normalised so that they sum to (1 << g_RANS_SCALE_BITS), and written before the
+    encoded words, so any symbol value can be used (including 0).  Like arithmetic coding,
+    a symbol can cost less than a bit; like Huffman coding, each symbol is decoded with a
+    single table look-up.
+
+    Since rANS decodes symbols in the reverse order to which they were encoded, the whole
+    message is given to EncodeMessage () at once; it is encoded from the end and the words
+    are reversed before they are written.  Symbol i is coded by state (i % g_RANS_STATES),
+    so that the decoder has several independent chains of table look-ups to work on, but
+    all of the states share one sequence of words.  As with Huffman, the BitBuffer is not
+    a member of this class and has to be passed around.
+
+    With SetStates (g_RANS_STATES_MAX), the message is coded by 32 states instead.  The
+    decoder then works on 4 vectors of 8 states with AVX2 instructions, falling back to
+    the same loop as for fewer states on processors without them (or after SetSIMD (false)).
+    Both decoders read the words in the same order, so the choice is made when decoding.
+    The number of states is not written, so the decoder must be given the same number.
+
+    For encoding, do the following:
+
+    1)  Initialize the BitBuffer.
+    2)  Create a RANS object.
+    3)  Encode the message using EncodeMessage ().
+
+    For decoding:
+
+    1)  Initialize the BitBuffer.
+    2)  Create a RANS object.
+    3)  Decode the message using DecodeMessage ().
+
+    See the test driver in testing.cpp for example usage.
+*/
+class RANS {
+  //  Friend function to print out statistics for debugging  [rans.cpp]
+  friend ostream &operator<< (ostream &os, const RANS& rc);
+
+  public:
+    //  Constructors/destructors  [rans.cpp]
+    RANS (bool debug=false);
+    ~RANS ();
+    bool GetDebug () const;
+    void SetDebug ();
+    unsigned int GetMessageLength () const;
+    unsigned int GetMaximumSymbol () const;
+    unsigned int GetFrequency (unsigned int symbol) const;
+    unsigned int GetStates () const;
+    void SetStates (unsigned int x);
+    bool GetSIMD () const;
+    void SetSIMD (bool x);
+
+    //  Encoding functions  [encode.cpp]
+    void EncodeMessage (BitBuffer &bitbuffer, const vector<unsigned int> &x);
+    void EncodeMessage (BitBuffer &bitbuffer, const unsigned char *x, unsigned long long len);
+
+    //  Decoding functions  [decode.cpp]
+    vector<unsigned int> DecodeMessage (BitBuffer &bitbuffer);
+    void DecodeMessage (BitBuffer &bitbuffer, unsigned char *x, unsigned long long len);
+  private:
+    //  Encoding functions  [encode.cpp]
+    template <typename T>
+    void EncodeSymbols (BitBuffer &bitbuffer, const T *x, size_t len);
+    void EncodeFrequencies (BitBuffer &bitbuffer);
+
+    //  Decoding functions  [decode.cpp]
+    template <typename T>
+    void DecodeSymbols (BitBuffer &bitbuffer, T *x);
+    void DecodeFrequencies (BitBuffer &bitbuffer);
+    void BuildDecodeTable ();
+
+    //  Main processing functions  [process.cpp]
+    void UpdateFrequencies (const unsigned int *x, size_t len);
+    void UpdateFrequencies (const unsigned char *x, size_t len);
+    void NormaliseFrequencies ();
+    void SetCumulative ();
+
+    //!  Debug mode?
+    bool m_Debug;
+    //!  Length of the message (i.e., number of symbols to encode/decode)
+    unsigned int m_MessageLength;
+    //!  Maximum symbol in the message
+    unsigned int m_MaximumSymbol;
+    //!  Number of states that take turns to code the symbols
+    unsigned int m_States;
+    //!  Use SIMD instructions to decode, if the processor has them?
+    bool m_SIMD;
+
+    //!  Number of times each symbol occurs in the message; not used for decoding
+    vector<unsigned long long> m_Counts;
+    //!  Normalised frequency of each symbol
+    vector<unsigned int> m_Frequencies;
+    //!  Sum of the normalised frequencies of the symbols before each symbol
+    vector<unsigned int> m_Cumulative;
+
+    //!  Decoding table of (1 << g_RANS_SCALE_BITS) entries
+    vector<RANSTableEntry> m_DecodeTable;
+};
+
+#endif
@@ -0,0 +1,241 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file simd.cpp
+    SIMD decoding functions for the RANS class.
+
+    Only x86 processors with AVX2 are supported so far.  The functions are compiled for
+    AVX2 on their own, so the rest of the program runs on any processor and the choice
+    is made when the program runs.
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <bit>  //  popcount
+
+using namespace std;
+
+#include "RANS_Config.hpp"
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "rans.hpp"
+#include "simd.hpp"
+
+#if defined (HAVE_IMMINTRIN_H) && defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#include <immintrin.h>
+#define RANS_AVX2
+#endif
+
+
+#ifdef RANS_AVX2
+
+//  The frequency and start of an entry are gathered together as its second 32-bit word
+static_assert (sizeof (RANSTableEntry) == 2 * sizeof (unsigned int), "RANSTableEntry must be 8 bytes");
+
+
+/*!
+     For each set of lanes that need a word, the lane of the loaded words that each lane
+     takes.  The lanes that need a word take the next words in order.
+*/
+struct AVX2PermutationTable {
+  //!  Lanes, indexed by the mask of lanes that need a word
+  alignas (32) unsigned int lanes[256][8];
+
+  /*!
+       Fill the table
+  */
+  AVX2PermutationTable () {
+    for (unsigned int mask = 0; mask < 256; mask++) {
+      unsigned int next = 0;
+      for (unsigned int j = 0; j < 8; j++) {
+        lanes[mask][j] = 0;
+        if ((mask >> j) & 1) {
+          lanes[mask][j] = next;
+          next++;
+        }
+      }
+    }
+  }
+};
+
+//!  Permutations used by AVX2_Decode ()
+static const AVX2PermutationTable g_AVX2_PERMUTATIONS;
+
+#endif
+
+
+/*!
+     Check whether the processor can run AVX2_Decode ()
+
+     \return true if it has AVX2 instructions
+*/
+bool AVX2_Available () {
+#ifdef RANS_AVX2
+  static const bool available = __builtin_cpu_supports ("avx2");
+
+  return (available);
+#else
+  return (false);
+#endif
+}
+
+
+#ifdef RANS_AVX2
+
+/*!
+     Store the 8 symbols of a vector as unsigned ints
+
+     \param[out] result Where to write the symbols
+     \param[in] symbol The symbols
+*/
+__attribute__ ((target ("avx2")))
+static inline void AVX2_Store (unsigned int *result, __m256i symbol) {
+  _mm256_storeu_si256 (reinterpret_cast<__m256i *> (result), symbol);
+
+  return;
+}
+
+
+/*!
+     Store the 8 symbols of a vector as bytes, which they must fit in
+
+     \param[out] result Where to write the symbols
+     \param[in] symbol The symbols
+*/
+__attribute__ ((target ("avx2")))
+static inline void AVX2_Store (unsigned char *result, __m256i symbol) {
+  __m128i shorts = _mm_packus_epi32 (_mm256_castsi256_si128 (symbol), _mm256_extracti128_si256 (symbol, 1));
+  _mm_storel_epi64 (reinterpret_cast<__m128i *> (result), _mm_packus_epi16 (shorts, shorts));
+
+  return;
+}
+
+
+/*!
+     Decode whole rounds of g_RANS_STATES_MAX symbols with 4 vectors of 8 states.  Each
+     vector gathers the entries of its 8 slots, updates its states, and then moves the next
+     words into the states which have fallen below the lower bound, in order.  This is the
+     same order in which DecodeSymbol () reads them, so the two can be mixed.
+
+     It stops early if the words run out, leaving the error to the caller.
+
+     \param[in,out] state The g_RANS_STATES_MAX states
+     \param[in] table The decoding table
+     \param[in,out] ptr The next word to move into a state; g_AVX2_WORDS_PADDING words after end must be readable
+     \param[in] end The end of the words
+     \param[out] result Where to write the symbols
+     \param[in] length The number of symbols in the message
+     \return The number of symbols decoded
+*/
+template <typename T>
+__attribute__ ((target ("avx2")))
+static unsigned int AVX2_DecodeRounds (unsigned int *state, const RANSTableEntry *table, const unsigned short *&ptr, const unsigned short *end, T *result, unsigned int length) {
+  unsigned int i = 0;
+  const int *entries = reinterpret_cast<const int *> (table);
+  const __m256i mask = _mm256_set1_epi32 ((1 << g_RANS_SCALE_BITS) - 1);
+  const __m256i low_half = _mm256_set1_epi32 (0xFFFF);
+  const __m256i below = _mm256_set1_epi32 (g_RANS_LOWER_BOUND - 1);
+  const unsigned short *p = ptr;
+
+  __m256i x[4];
+  for (unsigned int v = 0; v < 4; v++) {
+    x[v] = _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (state + 8 * v));
+  }
+
+  while ((i + g_RANS_STATES_MAX <= length) && (p <= end)) {
+    for (unsigned int v = 0; v < 4; v++) {
+      //  Decode a symbol from each state
+      __m256i slot = _mm256_and_si256 (x[v], mask);
+      __m256i index = _mm256_slli_epi32 (slot, 1);
+      __m256i symbol = _mm256_i32gather_epi32 (entries, index, 4);
+      __m256i frequency_start = _mm256_i32gather_epi32 (entries + 1, index, 4);
+      __m256i frequency = _mm256_and_si256 (frequency_start, low_half);
+      __m256i start = _mm256_srli_epi32 (frequency_start, g_RANS_WORD_BITS);
+      x[v] = _mm256_add_epi32 (_mm256_mullo_epi32 (frequency, _mm256_srli_epi32 (x[v], g_RANS_SCALE_BITS)), _mm256_sub_epi32 (slot, start));
+      AVX2_Store (result + i + 8 * v, symbol);
+
+      //  Move the next words into the states below the lower bound
+      __m256i renormalise = _mm256_cmpeq_epi32 (_mm256_min_epu32 (x[v], below), x[v]);
+      unsigned int lanes = _mm256_movemask_ps (_mm256_castsi256_ps (renormalise));
+      __m256i words = _mm256_cvtepu16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i *> (p)));
+      words = _mm256_permutevar8x32_epi32 (words, _mm256_load_si256 (reinterpret_cast<const __m256i *> (g_AVX2_PERMUTATIONS.lanes[lanes])));
+      x[v] = _mm256_blendv_epi8 (x[v], _mm256_or_si256 (_mm256_slli_epi32 (x[v], g_RANS_WORD_BITS), words), renormalise);
+      p += popcount (lanes);
+    }
+    i += g_RANS_STATES_MAX;
+  }
+
+  for (unsigned int v = 0; v < 4; v++) {
+    _mm256_storeu_si256 (reinterpret_cast<__m256i *> (state + 8 * v), x[v]);
+  }
+  ptr = p;
+
+  return (i);
+}
+
+#endif
+
+
+/*!
+     Decode whole rounds of g_RANS_STATES_MAX symbols with AVX2 (see AVX2_DecodeRounds ()).
+     Only call this if AVX2_Available () is true.
+
+     \param[in,out] state The g_RANS_STATES_MAX states
+     \param[in] table The decoding table
+     \param[in,out] ptr The next word to move into a state; g_AVX2_WORDS_PADDING words after end must be readable
+     \param[in] end The end of the words
+     \param[out] result Where to write the symbols
+     \param[in] length The number of symbols in the message
+     \return The number of symbols decoded
+*/
+unsigned int AVX2_Decode (unsigned int *state, const RANSTableEntry *table, const unsigned short *&ptr, const unsigned short *end, unsigned int *result, unsigned int length) {
+#ifdef RANS_AVX2
+  return (AVX2_DecodeRounds (state, table, ptr, end, result, length));
+#else
+  return (0);
+#endif
+}
+
+
+/*!
+     Decode whole rounds of g_RANS_STATES_MAX symbols with AVX2 into bytes; every symbol
+     in the table must fit in one.  Only call this if AVX2_Available () is true.
+
+     \param[in,out] state The g_RANS_STATES_MAX states
+     \param[in] table The decoding table
+     \param[in,out] ptr The next word to move into a state; g_AVX2_WORDS_PADDING words after end must be readable
+     \param[in] end The end of the words
+     \param[out] result Where to write the symbols
+     \param[in] length The number of symbols in the message
+     \return The number of symbols decoded
+*/
+unsigned int AVX2_Decode (unsigned int *state, const RANSTableEntry *table, const unsigned short *&ptr, const unsigned short *end, unsigned char *result, unsigned int length) {
+#ifdef RANS_AVX2
+  return (AVX2_DecodeRounds (state, table, ptr, end, result, length));
+#else
+  return (0);
+#endif
+}
@@ -0,0 +1,45 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file simd.hpp
+    Header file for the SIMD decoding functions of the RANS class.
+*/
+/*******************************************************************/
+
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+
+/*!
+     Number of words after the end of the message that AVX2_Decode () may read.  It stops
+     after the first round which moves past the end; a round moves at most
+     g_RANS_STATES_MAX words into the states and each load is of 8 words.
+*/
+const unsigned int g_AVX2_WORDS_PADDING = g_RANS_STATES_MAX + 8;
+
+bool AVX2_Available ();
+unsigned int AVX2_Decode (unsigned int *state, const RANSTableEntry *table, const unsigned short *&ptr, const unsigned short *end, unsigned int *result, unsigned int length);
+unsigned int AVX2_Decode (unsigned int *state, const RANSTableEntry *table, const unsigned short *&ptr, const unsigned short *end, unsigned char *result, unsigned int length);
+
+#endif
@@ -0,0 +1,399 @@
+//  ###########################################################################
+//  Copyright 2025 by Raymond Wan (rwan.work@gmail.com)
+//    https://github.com/rwanwork/QScores-Archiver
+//
+//  This file is part of QScores-Archiver.
+//
+//  QScores-Archiver is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public License
+//  as published by the Free Software Foundation; either version
+//  3 of the License, or (at your option) any later version.
+//
+//  QScores-Archiver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with QScores-Archiver; if not, see
+//  <http://www.gnu.org/licenses/>.
+//  ###########################################################################
+
+
+/*******************************************************************/
+/*!
+    \file testing.cpp
+    Testing functions of main-test.
+*/
+/*******************************************************************/
+
+#include <fstream>  //  ostream
+#include <vector>
+#include <iostream>
+#include <cstdlib>  //  EXIT_SUCCESS, EXIT_FAILURE, exit ()
+
+using namespace std;
+
+#include "RANS_Config.hpp"
+#include "common.hpp"
+#include "bitbuffer.hpp"
+#include "rans.hpp"
+#include "testing.hpp"
+
+
+/*!
+     Compare two vectors
+
+     \return true if the vectors are the same; false otherwise
+*/
+bool VectorSame (vector<unsigned int> x, vector<unsigned int> y) {
+  if (x.size () != y.size ()) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < x.size (); i++) {
+    if (x[i] != y[i]) {
+      cerr << "EE\tMismatch at position " << i << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*!
+     Encode a message to a file, decode it, and compare the two.
+
+     \param[in] tmp The message
+     \return true if the decoded message is the same; false otherwise
+*/
+bool RANSRoundTrip (vector<unsigned int> tmp) {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> tmp2;
+
+  //  Test encoding
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  RANS rc_out;
+  rc_out.SetDebug ();
+  rc_out.EncodeMessage (bitbuff_out, tmp);
+  cout << rc_out << endl;
+
+  bitbuff_out.Finish ();
+  cerr << "II\tFinished encoding..." << endl;
+
+  //  Test decoding
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  RANS rc_in;
+  rc_in.SetDebug ();
+  tmp2 = rc_in.DecodeMessage (bitbuff_in);
+  cout << rc_in << endl;
+
+  bitbuff_in.Finish ();
+  cerr << "II\tFinished decoding... " << tmp2.size () << " symbols." << endl;
+
+  return (VectorSame (tmp, tmp2));
+}
+
+
+/*!
+     Show basic information about the program
+
+     \return Always returns true
+*/
+bool ShowInfo () {
+  cout << "RANS version " << RANS_PROGRAM_VERSION << " compiled on:  " << __DATE__ <<  " (" << __TIME__ << ")" << endl;
+  cout << "Git hash:  " << RANS_GIT_HASH << endl;
+
+  cout << "II\tShowInfo successful!" << endl;
+
+  return (true);
+}
+
+
+/*!
+     Simple example with only one symbol in the alphabet.
+
+     \return true if the test was successful; false otherwise
+*/
+bool RANSSimple1Example () {
+  vector<unsigned int> tmp;
+
+  //  Generate test data
+  for (unsigned int i = 0; i < 11; i++) {
+    tmp.push_back (10);
+  }
+
+  if (!RANSRoundTrip (tmp)) {
+    cerr << "EE\trANS coding of Simple1 example unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\trANS coding of Simple1 example successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     Simple example with three symbols in the alphabet and the symbol 0.
+
+     \return true if the test was successful; false otherwise
+*/
+bool RANSSimple3Example () {
+  vector<unsigned int> tmp;
+
+  //  Generate test data
+  for (unsigned int i = 0; i < 11; i++) {
+    tmp.push_back (10);
+  }
+  for (unsigned int i = 0; i < 5; i++) {
+    tmp.push_back (90);
+  }
+  for (unsigned int i = 0; i < 7; i++) {
+    tmp.push_back (70);
+  }
+  tmp.push_back (0);
+
+  if (!RANSRoundTrip (tmp)) {
+    cerr << "EE\trANS coding of Simple3 example unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\trANS coding of Simple3 example successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     rANS code a set of random numbers
+
+     \return true if the test was successful; false otherwise
+*/
+bool RANSRandom () {
+  vector<unsigned int> tmp;
+
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data
+  for (unsigned int i = 0; i < g_TEST_SIZE; i++) {
+    tmp.push_back (rand () % (g_MAX_ASCII + 1));
+  }
+
+  if (!RANSRoundTrip (tmp)) {
+    cerr << "EE\trANS coding of random numbers unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\trANS coding of random numbers successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     rANS code an empty message followed by a set of random numbers whose frequencies
+     halve from one symbol to the next, so that the rarest symbols have their frequencies
+     rounded up.  A marker is written after the messages to check that the decoder stops
+     at the right bit.
+
+     \return true if the test was successful; false otherwise
+*/
+bool RANSSkewed () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> empty;
+  vector<unsigned int> tmp;
+  vector<unsigned int> tmp2;
+  unsigned int marker = 0xA5A5A5A5;
+
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data; symbol i appears with probability 2^-i
+  for (unsigned int i = 0; i < g_TEST_SIZE * 100; i++) {
+    unsigned int pos = 1;
+    while ((pos < g_MAX_ASCII) && (rand () % 2 == 0)) {
+      pos++;
+    }
+    tmp.push_back (pos);
+  }
+
+  //  Test encoding
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  RANS rc_empty_out;
+  rc_empty_out.EncodeMessage (bitbuff_out, empty);
+  RANS rc_out;
+  rc_out.EncodeMessage (bitbuff_out, tmp);
+  bitbuff_out.WriteBits (marker, g_UINT_SIZE_BITS);
+  bitbuff_out.Finish ();
+
+  //  Test decoding
+  BitBuffer bitbuff_in;
+  bitbuff_in.Initialize (str, e_MODE_READ);
+  RANS rc_empty_in;
+  vector<unsigned int> empty2 = rc_empty_in.DecodeMessage (bitbuff_in);
+  RANS rc_in;
+  tmp2 = rc_in.DecodeMessage (bitbuff_in);
+  unsigned int marker_in = bitbuff_in.ReadBits (g_UINT_SIZE_BITS);
+  bitbuff_in.Finish ();
+
+  if ((empty2.size () != 0) || (!VectorSame (tmp, tmp2)) || (marker_in != marker)) {
+    cerr << "EE\trANS coding of skewed random numbers unsuccessful!" << endl;
+    return (false);
+  }
+
+  cerr << "II\trANS coding of skewed random numbers successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     rANS code the skewed random numbers of RANSSkewed () with g_RANS_STATES_MAX states,
+     and decode them with and without SIMD instructions.  The message length is not a
+     multiple of the number of states, so that the SIMD decoder leaves some symbols to the
+     portable one.  Its first 3 symbols are then coded on their own, so that some states
+     are never used.  A marker is written after the messages to check that the decoder
+     stops at the right bit.
+
+     \return true if the test was successful; false otherwise
+*/
+bool RANSInterleaved () {
+  string str = "tmp.data";  //  Input/output filename
+  vector<unsigned int> tmp;
+  vector<unsigned int> tmp_short;
+  unsigned int marker = 0xA5A5A5A5;
+
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data; symbol i appears with probability 2^-i
+  for (unsigned int i = 0; i < g_TEST_SIZE * 100 + 5; i++) {
+    unsigned int pos = 1;
+    while ((pos < g_MAX_ASCII) && (rand () % 2 == 0)) {
+      pos++;
+    }
+    tmp.push_back (pos);
+  }
+  tmp_short.assign (tmp.begin (), tmp.begin () + 3);
+
+  //  Test encoding
+  BitBuffer bitbuff_out;
+  bitbuff_out.Initialize (str, e_MODE_WRITE);
+  RANS rc_out;
+  rc_out.SetStates (g_RANS_STATES_MAX);
+  rc_out.EncodeMessage (bitbuff_out, tmp);
+  RANS rc_short_out;
+  rc_short_out.SetStates (g_RANS_STATES_MAX);
+  rc_short_out.EncodeMessage (bitbuff_out, tmp_short);
+  bitbuff_out.WriteBits (marker, g_UINT_SIZE_BITS);
+  bitbuff_out.Finish ();
+
+  //  Test decoding, with SIMD instructions if the processor has them and then without
+  bool simd = true;
+  for (unsigned int k = 0; k < 2; k++) {
+    BitBuffer bitbuff_in;
+    bitbuff_in.Initialize (str, e_MODE_READ);
+    RANS rc_in;
+    rc_in.SetStates (g_RANS_STATES_MAX);
+    rc_in.SetSIMD (simd);
+    vector<unsigned int> tmp2 = rc_in.DecodeMessage (bitbuff_in);
+    RANS rc_short_in;
+    rc_short_in.SetStates (g_RANS_STATES_MAX);
+    rc_short_in.SetSIMD (simd);
+    vector<unsigned int> tmp_short2 = rc_short_in.DecodeMessage (bitbuff_in);
+    unsigned int marker_in = bitbuff_in.ReadBits (g_UINT_SIZE_BITS);
+    bitbuff_in.Finish ();
+
+    if ((!VectorSame (tmp, tmp2)) || (!VectorSame (tmp_short, tmp_short2)) || (marker_in != marker)) {
+      cerr << "EE\trANS coding with " << g_RANS_STATES_MAX << " states unsuccessful (SIMD:  " << simd << ")!" << endl;
+      return (false);
+    }
+    simd = false;
+  }
+
+  cerr << "II\trANS coding with " << g_RANS_STATES_MAX << " states successful!" << endl;
+  return (true);
+}
+
+
+/*!
+     rANS code skewed random numbers as an array of bytes, with the default number of
+     states and with g_RANS_STATES_MAX, and check that the output is the same as when they
+     are given as a vector.  The message is then decoded.
+
+     \return true if the test was successful; false otherwise
+*/
+bool RANSBytes () {
+  vector<unsigned int> tmp;
+  vector<unsigned char> tmp_bytes;
+
+  unsigned long long int seed = time (NULL);
+  srand (seed);
+  cerr << "II\tSeed:  " << seed << endl;
+
+  //  Generate test data; symbol i appears with probability 2^-i
+  for (unsigned int i = 0; i < g_TEST_SIZE * 100 + 5; i++) {
+    unsigned int pos = 0;
+    while ((pos < g_MAX_ASCII) && (rand () % 2 == 0)) {
+      pos++;
+    }
+    tmp.push_back (pos);
+    tmp_bytes.push_back (static_cast<unsigned char> (pos));
+  }
+
+  unsigned int states[2] = {g_RANS_STATES, g_RANS_STATES_MAX};
+  for (unsigned int k = 0; k < 2; k++) {
+    //  Test encoding
+    BitBuffer bitbuff_vector;
+    bitbuff_vector.Initialize (e_MODE_MEMORY_WRITE);
+    RANS rc_vector_out;
+    rc_vector_out.SetStates (states[k]);
+    rc_vector_out.EncodeMessage (bitbuff_vector, tmp);
+    vector<char> bytes_vector;
+    bitbuff_vector.GetBytes (bytes_vector);
+
+    BitBuffer bitbuff_bytes;
+    bitbuff_bytes.Initialize (e_MODE_MEMORY_WRITE);
+    RANS rc_bytes_out;
+    rc_bytes_out.SetStates (states[k]);
+    rc_bytes_out.EncodeMessage (bitbuff_bytes, tmp_bytes.data (), tmp_bytes.size ());
+    vector<char> bytes;
+    bitbuff_bytes.GetBytes (bytes);
+
+    //  Test decoding
+    BitBuffer bitbuff_in;
+    bitbuff_in.Initialize (bytes.data (), bytes.size ());
+    RANS rc_in;
+    rc_in.SetStates (states[k]);
+    vector<unsigned int> tmp2 = rc_in.DecodeMessage (bitbuff_in);
+
+    if ((bytes != bytes_vector) || (!VectorSame (tmp, tmp2))) {
+      cerr << "EE\trANS coding of bytes with " << states[k] << " states unsuccessful!" << endl;
+      return (false);
+    }
+
+    //  Test decoding into bytes, with and without SIMD instructions
+    for (bool simd : {true, false}) {
+      BitBuffer bitbuff_bytes_in;
+      bitbuff_bytes_in.Initialize (bytes.data (), bytes.size ());
+      RANS rc_bytes_in;
+      rc_bytes_in.SetStates (states[k]);
+      rc_bytes_in.SetSIMD (simd);
+      vector<unsigned char> tmp2_bytes (tmp_bytes.size ());
+      rc_bytes_in.DecodeMessage (bitbuff_bytes_in, tmp2_bytes.data (), tmp2_bytes.size ());
+
+      if (tmp2_bytes != tmp_bytes) {
+        cerr << "EE\trANS decoding into bytes with " << states[k] << " states unsuccessful!" << endl;
+        return (false);
+      }
+    }
+  }
+
+  cerr << "II\trANS coding of bytes successful!" << endl;
+  return (true);
+}